@@ -0,0 +1,402 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "CTFMetadata.hpp"
+
+
+using namespace ctf2prv;
+
+
+class CTFMetadata::Parser {
+private:
+	enum TokenType {
+		TokenEnd = 0,
+		TokenIdentifier,
+		TokenNumber,
+		TokenString,
+		TokenSymbol
+	};
+
+	struct Token {
+		TokenType type;
+		std::string text;
+	};
+
+	CTFMetadata &_metadata;
+	std::vector<Token> _tokens;
+	size_t _next;
+
+	void tokenize(const std::string &text)
+	{
+		size_t i = 0;
+		const size_t length = text.size();
+
+		while (i < length) {
+			const char c = text[i];
+
+			if (isspace(c)) {
+				i++;
+			} else if (c == '/' && i + 1 < length && text[i + 1] == '*') {
+				size_t end = text.find("*/", i + 2);
+				if (end == std::string::npos)
+					throw std::runtime_error("unterminated comment in metadata");
+				i = end + 2;
+			} else if (c == '/' && i + 1 < length && text[i + 1] == '/') {
+				size_t end = text.find('\n', i);
+				i = (end == std::string::npos) ? length : end + 1;
+			} else if (c == '"') {
+				std::string value;
+				i++;
+				while (i < length && text[i] != '"') {
+					if (text[i] == '\\' && i + 1 < length)
+						i++;
+					value += text[i++];
+				}
+				if (i == length)
+					throw std::runtime_error("unterminated string in metadata");
+				i++;
+				_tokens.push_back({TokenString, value});
+			} else if (isalpha(c) || c == '_') {
+				size_t start = i;
+				while (i < length && (isalnum(text[i]) || text[i] == '_' || text[i] == '.'))
+					i++;
+				_tokens.push_back({TokenIdentifier, text.substr(start, i - start)});
+			} else if (isdigit(c) || (c == '-' && i + 1 < length && isdigit(text[i + 1]))) {
+				size_t start = i++;
+				while (i < length && isalnum(text[i]))
+					i++;
+				_tokens.push_back({TokenNumber, text.substr(start, i - start)});
+			} else if (c == ':' && i + 1 < length && text[i + 1] == '=') {
+				_tokens.push_back({TokenSymbol, ":="});
+				i += 2;
+			} else {
+				_tokens.push_back({TokenSymbol, std::string(1, c)});
+				i++;
+			}
+		}
+		_tokens.push_back({TokenEnd, ""});
+	}
+
+	const Token &peek() const
+	{
+		return _tokens[_next];
+	}
+
+	const Token &get()
+	{
+		const Token &token = _tokens[_next];
+		if (token.type != TokenEnd)
+			_next++;
+		return token;
+	}
+
+	void expect(const char *text)
+	{
+		const Token &token = get();
+		if (token.text != text) {
+			throw std::runtime_error(
+				std::string("unexpected token '") + token.text +
+				"' in metadata, expected '" + text + "'"
+			);
+		}
+	}
+
+	//! Read the tokens of a "key = value;" statement after the '='
+	std::string parseValue()
+	{
+		std::string value;
+		while (peek().type != TokenEnd && peek().text != ";")
+			value += get().text;
+		expect(";");
+		return value;
+	}
+
+	static uint64_t toInteger(const std::string &value)
+	{
+		return strtoull(value.c_str(), nullptr, 0);
+	}
+
+	//! Parse "{ key = value; ... }" of typealiases and clocks
+	std::map<std::string, std::string> parseAttributes()
+	{
+		std::map<std::string, std::string> attributes;
+		expect("{");
+		while (peek().text != "}") {
+			std::string key = get().text;
+			expect("=");
+			attributes[key] = parseValue();
+		}
+		expect("}");
+		return attributes;
+	}
+
+	void parseTypeAlias()
+	{
+		FieldType type;
+		std::string kind = get().text;
+		std::map<std::string, std::string> attributes = parseAttributes();
+
+		if (kind == "integer") {
+			uint64_t size = toInteger(attributes["size"]);
+			if (size == 8)
+				type = FieldUInt8;
+			else if (size == 16)
+				type = FieldUInt16;
+			else if (size == 32)
+				type = FieldUInt32;
+			else if (size == 64)
+				type = FieldUInt64;
+			else
+				throw std::runtime_error("unsupported integer size " + attributes["size"]);
+		} else if (kind == "floating_point") {
+			type = (toInteger(attributes["mant_dig"]) > 24) ? FieldDouble : FieldFloat;
+		} else {
+			throw std::runtime_error("unsupported typealias kind " + kind);
+		}
+
+		expect(":=");
+		std::string name = get().text;
+		expect(";");
+		_metadata._typeAliases[name] = type;
+	}
+
+	//! Append the flattened members of a struct body to the fields list
+	void parseStructBody(FieldList &fields, const std::string &prefix)
+	{
+		expect("{");
+		while (peek().text != "}") {
+			std::string typeName = get().text;
+			if (typeName == "struct") {
+				std::string structName = get().text;
+				std::string memberName = get().text;
+				expect(";");
+
+				auto it = _metadata._structs.find(structName);
+				if (it == _metadata._structs.end())
+					throw std::runtime_error("unknown struct " + structName);
+
+				for (const Field &field : it->second)
+					fields.push_back({prefix + memberName + "." + field.name, field.type});
+			} else {
+				std::string memberName = get().text;
+				expect(";");
+
+				FieldType type;
+				if (typeName == "string") {
+					type = FieldString;
+				} else {
+					auto it = _metadata._typeAliases.find(typeName);
+					if (it == _metadata._typeAliases.end())
+						throw std::runtime_error("unknown type " + typeName);
+					type = it->second;
+				}
+
+				// The CTF specification strips the leading underscore
+				// of field names, which is used to avoid clashes with
+				// TSDL keywords
+				if (!memberName.empty() && memberName[0] == '_')
+					memberName = memberName.substr(1);
+
+				fields.push_back({prefix + memberName, type});
+			}
+		}
+		expect("}");
+	}
+
+	//! Parse "<key> := struct { ... };"
+	void parseStructAssignment(FieldList &fields)
+	{
+		expect(":=");
+		expect("struct");
+		parseStructBody(fields, "");
+		expect(";");
+	}
+
+	void parseTrace()
+	{
+		expect("{");
+		while (peek().text != "}") {
+			std::string key = get().text;
+			if (key == "packet.header") {
+				parseStructAssignment(_metadata._packetHeader);
+			} else {
+				expect("=");
+				std::string value = parseValue();
+				if (key == "byte_order" && value != "le")
+					throw std::runtime_error("only little-endian traces are supported");
+			}
+		}
+		expect("}");
+		expect(";");
+	}
+
+	void parseEnvironment()
+	{
+		expect("{");
+		while (peek().text != "}") {
+			std::string key = get().text;
+			expect("=");
+			_metadata._environment[key] = parseValue();
+		}
+		expect("}");
+		expect(";");
+	}
+
+	void parseClock()
+	{
+		std::map<std::string, std::string> attributes = parseAttributes();
+		expect(";");
+
+		uint64_t frequency = toInteger(attributes["freq"]);
+		if (frequency != 1000000000ULL)
+			throw std::runtime_error("only nanosecond clocks are supported");
+		_metadata._clockOffset = toInteger(attributes["offset"]);
+	}
+
+	void parseStruct()
+	{
+		std::string name = get().text;
+		FieldList fields;
+		parseStructBody(fields, "");
+		expect(";");
+		_metadata._structs[name] = fields;
+	}
+
+	void parseStream()
+	{
+		StreamClass stream;
+		stream.id = 0;
+
+		expect("{");
+		while (peek().text != "}") {
+			std::string key = get().text;
+			if (key == "packet.context") {
+				parseStructAssignment(stream.packetContext);
+			} else if (key == "event.header") {
+				parseStructAssignment(stream.eventHeader);
+			} else if (key == "event.context") {
+				parseStructAssignment(stream.eventContext);
+			} else {
+				expect("=");
+				std::string value = parseValue();
+				if (key == "id")
+					stream.id = toInteger(value);
+			}
+		}
+		expect("}");
+		expect(";");
+
+		_metadata._streams[stream.id] = stream;
+	}
+
+	void parseEvent()
+	{
+		EventClass event;
+		FieldList context;
+		FieldList payload;
+		event.id = 0;
+		event.streamId = 0;
+		event.kind = 0;
+
+		expect("{");
+		while (peek().text != "}") {
+			std::string key = get().text;
+			if (key == "context") {
+				parseStructAssignment(context);
+			} else if (key == "fields") {
+				parseStructAssignment(payload);
+			} else {
+				expect("=");
+				std::string value = parseValue();
+				if (key == "name")
+					event.name = value;
+				else if (key == "id")
+					event.id = toInteger(value);
+				else if (key == "stream_id")
+					event.streamId = toInteger(value);
+			}
+		}
+		expect("}");
+		expect(";");
+
+		event.fields = context;
+		event.fields.insert(event.fields.end(), payload.begin(), payload.end());
+		_metadata._events[std::make_pair(event.streamId, event.id)] = event;
+	}
+
+public:
+	Parser(CTFMetadata &metadata, const std::string &text) :
+		_metadata(metadata),
+		_next(0)
+	{
+		tokenize(text);
+	}
+
+	void parse()
+	{
+		while (peek().type != TokenEnd) {
+			std::string keyword = get().text;
+			if (keyword == "typealias") {
+				parseTypeAlias();
+			} else if (keyword == "trace") {
+				parseTrace();
+			} else if (keyword == "env") {
+				parseEnvironment();
+			} else if (keyword == "clock") {
+				parseClock();
+			} else if (keyword == "struct") {
+				parseStruct();
+			} else if (keyword == "stream") {
+				parseStream();
+			} else if (keyword == "event") {
+				parseEvent();
+			} else {
+				throw std::runtime_error("unsupported metadata block " + keyword);
+			}
+		}
+	}
+};
+
+
+void CTFMetadata::load(const std::string &path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+		throw std::runtime_error("cannot open metadata file " + path);
+
+	std::stringstream text;
+	text << file.rdbuf();
+
+	Parser parser(*this, text.str());
+	parser.parse();
+
+	if (_packetHeader.empty())
+		throw std::runtime_error("the metadata does not define a packet header");
+
+	// Prepend the context shared by all the events of each stream
+	for (auto &entry : _events) {
+		EventClass &event = entry.second;
+		const StreamClass *stream = getStream(event.streamId);
+		if (stream == nullptr)
+			throw std::runtime_error("event " + event.name + " belongs to an unknown stream");
+
+		event.fields.insert(event.fields.begin(), stream->eventContext.begin(), stream->eventContext.end());
+	}
+}
+
+const std::string &CTFMetadata::getEnvironment(const std::string &key) const
+{
+	auto it = _environment.find(key);
+	if (it == _environment.end())
+		throw std::runtime_error("missing metadata environment variable " + key);
+	return it->second;
+}
@@ -0,0 +1,125 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF2PRV_CTF_METADATA_HPP
+#define CTF2PRV_CTF_METADATA_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace ctf2prv {
+
+	enum FieldType {
+		FieldUInt8 = 0,
+		FieldUInt16,
+		FieldUInt32,
+		FieldUInt64,
+		FieldFloat,
+		FieldDouble,
+		FieldString
+	};
+
+	//! \brief A scalar field of a CTF structure. Nested structures are
+	//! flattened and their members are named "<struct>.<member>"
+	struct Field {
+		std::string name;
+		FieldType type;
+	};
+
+	typedef std::vector<Field> FieldList;
+
+	struct StreamClass {
+		uint32_t id;
+		FieldList packetContext;
+		FieldList eventHeader;
+		FieldList eventContext;
+	};
+
+	struct EventClass {
+		std::string name;
+		uint32_t id;
+		uint32_t streamId;
+
+		//! The stream event context, the event context and the event
+		//! payload fields, in the order they are found in the stream
+		FieldList fields;
+
+		//! The converter event kind and the indexes of the fields it
+		//! looks up, set by the converter
+		int kind;
+		std::vector<int> fieldSlots;
+	};
+
+	//! \brief Reader of the TSDL metadata file written by the Nanos6 CTF
+	//! backend. Only the subset of the TSDL language emitted by Nanos6 is
+	//! supported: fixed-size byte-aligned integers, floating point numbers,
+	//! null-terminated strings and (nested) structures
+	class CTFMetadata {
+	private:
+		std::map<std::string, std::string> _environment;
+		std::map<std::string, FieldType> _typeAliases;
+		std::map<std::string, FieldList> _structs;
+
+		FieldList _packetHeader;
+		uint64_t _clockOffset;
+
+		std::map<uint32_t, StreamClass> _streams;
+		std::map<std::pair<uint32_t, uint32_t>, EventClass> _events;
+
+		class Parser;
+
+	public:
+		CTFMetadata() :
+			_clockOffset(0)
+		{
+		}
+
+		//! \brief Parse the metadata file at the given path. Errors are
+		//! reported by throwing std::runtime_error
+		void load(const std::string &path);
+
+		const std::string &getEnvironment(const std::string &key) const;
+
+		bool hasEnvironment(const std::string &key) const
+		{
+			return _environment.find(key) != _environment.end();
+		}
+
+		//! \brief Get the clock offset from the Epoch in nanoseconds
+		uint64_t getClockOffset() const
+		{
+			return _clockOffset;
+		}
+
+		const FieldList &getPacketHeader() const
+		{
+			return _packetHeader;
+		}
+
+		const StreamClass *getStream(uint32_t streamId) const
+		{
+			auto it = _streams.find(streamId);
+			return (it != _streams.end()) ? &it->second : nullptr;
+		}
+
+		EventClass *getEvent(uint32_t streamId, uint32_t eventId)
+		{
+			auto it = _events.find(std::make_pair(streamId, eventId));
+			return (it != _events.end()) ? &it->second : nullptr;
+		}
+
+		std::map<std::pair<uint32_t, uint32_t>, EventClass> &getEvents()
+		{
+			return _events;
+		}
+	};
+}
+
+#endif // CTF2PRV_CTF_METADATA_HPP
@@ -0,0 +1,270 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CTFStreamReader.hpp"
+
+
+using namespace ctf2prv;
+
+
+static const uint32_t CTFMagic = 0xc1fc1fc1;
+
+static size_t getFieldSize(FieldType type)
+{
+	switch (type) {
+		case FieldUInt8:
+			return 1;
+		case FieldUInt16:
+			return 2;
+		case FieldUInt32:
+		case FieldFloat:
+			return 4;
+		case FieldUInt64:
+		case FieldDouble:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+static bool findField(const FieldList &fields, const char *name, size_t &offset, FieldType &type)
+{
+	offset = 0;
+	for (const Field &field : fields) {
+		if (field.type == FieldString)
+			throw std::runtime_error("strings are not supported in stream headers");
+		if (field.name == name) {
+			type = field.type;
+			return true;
+		}
+		offset += getFieldSize(field.type);
+	}
+	return false;
+}
+
+
+CTFStreamReader::CTFStreamReader(const std::string &path, CTFMetadata &metadata) :
+	_path(path),
+	_metadata(metadata),
+	_data(nullptr),
+	_size(0),
+	_streamId(0),
+	_cpuId(0),
+	_stream(nullptr),
+	_idOffset(0),
+	_idType(FieldUInt8),
+	_timestampOffset(0),
+	_headerSize(0),
+	_next(0),
+	_firstEvent(0),
+	_truncated(0)
+{
+}
+
+CTFStreamReader::~CTFStreamReader()
+{
+	if (_data != nullptr)
+		munmap((void *) _data, _size);
+}
+
+uint64_t CTFStreamReader::readInteger(const char *data, FieldType type)
+{
+	// Traces are little-endian and fields are not aligned
+	switch (type) {
+		case FieldUInt8: {
+			uint8_t value;
+			memcpy(&value, data, sizeof(value));
+			return value;
+		}
+		case FieldUInt16: {
+			uint16_t value;
+			memcpy(&value, data, sizeof(value));
+			return value;
+		}
+		case FieldUInt32: {
+			uint32_t value;
+			memcpy(&value, data, sizeof(value));
+			return value;
+		}
+		default: {
+			uint64_t value;
+			memcpy(&value, data, sizeof(value));
+			return value;
+		}
+	}
+}
+
+bool CTFStreamReader::readStruct(size_t &offset, const FieldList &fields, std::vector<FieldValue> &values) const
+{
+	values.clear();
+	for (const Field &field : fields) {
+		FieldValue value;
+		if (field.type == FieldString) {
+			const char *end = (const char *) memchr(_data + offset, '\0', _size - offset);
+			if (end == nullptr)
+				return false;
+			value.string = _data + offset;
+			offset = (end - _data) + 1;
+		} else {
+			size_t size = getFieldSize(field.type);
+			if (offset + size > _size)
+				return false;
+			if (field.type == FieldFloat) {
+				float real;
+				memcpy(&real, _data + offset, sizeof(real));
+				value.real = real;
+			} else if (field.type == FieldDouble) {
+				memcpy(&value.real, _data + offset, sizeof(value.real));
+			} else {
+				value.integer = readInteger(_data + offset, field.type);
+			}
+			offset += size;
+		}
+		values.push_back(value);
+	}
+	return true;
+}
+
+void CTFStreamReader::open()
+{
+	int fd = ::open(_path.c_str(), O_RDONLY);
+	if (fd == -1)
+		throw std::runtime_error("cannot open stream " + _path + ": " + strerror(errno));
+
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		throw std::runtime_error("cannot stat stream " + _path + ": " + strerror(errno));
+	}
+
+	_size = st.st_size;
+	if (_size > 0) {
+		void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("cannot map stream " + _path + ": " + strerror(errno));
+		}
+		// The stream is read once from the beginning to the end
+		madvise(data, _size, MADV_SEQUENTIAL);
+		_data = (const char *) data;
+	}
+	close(fd);
+
+	// Nanos6 writes a single packet per stream, which spans to the end
+	// of the file
+	std::vector<FieldValue> values;
+	size_t offset = 0;
+	const FieldList &packetHeader = _metadata.getPacketHeader();
+	if (!readStruct(offset, packetHeader, values))
+		throw std::runtime_error("stream " + _path + " is too short");
+
+	for (size_t i = 0; i < packetHeader.size(); i++) {
+		if (packetHeader[i].name == "magic" && values[i].integer != CTFMagic)
+			throw std::runtime_error("stream " + _path + " has a wrong magic number");
+		if (packetHeader[i].name == "stream_id")
+			_streamId = values[i].integer;
+	}
+
+	_stream = _metadata.getStream(_streamId);
+	if (_stream == nullptr)
+		throw std::runtime_error("stream " + _path + " has an unknown stream id");
+
+	if (!readStruct(offset, _stream->packetContext, values))
+		throw std::runtime_error("stream " + _path + " is too short");
+
+	for (size_t i = 0; i < _stream->packetContext.size(); i++) {
+		if (_stream->packetContext[i].name == "cpu_id")
+			_cpuId = values[i].integer;
+	}
+
+	FieldType timestampType;
+	if (!findField(_stream->eventHeader, "id", _idOffset, _idType)
+		|| !findField(_stream->eventHeader, "timestamp", _timestampOffset, timestampType)
+		|| timestampType != FieldUInt64
+	) {
+		throw std::runtime_error("unsupported event header in stream " + _path);
+	}
+
+	_headerSize = 0;
+	for (const Field &field : _stream->eventHeader)
+		_headerSize += getFieldSize(field.type);
+
+	_firstEvent = offset;
+}
+
+EventClass *CTFStreamReader::getEventClass(size_t offset) const
+{
+	uint32_t id = readInteger(_data + offset + _idOffset, _idType);
+	EventClass *eventClass = _metadata.getEvent(_streamId, id);
+	if (eventClass == nullptr)
+		throw std::runtime_error("unknown event id " + std::to_string(id) + " in stream " + _path);
+	return eventClass;
+}
+
+size_t CTFStreamReader::getFieldsSize(size_t offset, const EventClass *eventClass) const
+{
+	const size_t start = offset;
+	for (const Field &field : eventClass->fields) {
+		if (field.type == FieldString) {
+			const char *end = (const char *) memchr(_data + offset, '\0', _size - offset);
+			if (end == nullptr)
+				return 0;
+			offset = (end - _data) + 1;
+		} else {
+			offset += getFieldSize(field.type);
+			if (offset > _size)
+				return 0;
+		}
+	}
+	return offset - start;
+}
+
+void CTFStreamReader::index()
+{
+	size_t offset = _firstEvent;
+
+	// Most streams are big, save a few reallocations
+	_index.reserve(_size / 32);
+
+	while (offset + _headerSize <= _size) {
+		EventClass *eventClass = getEventClass(offset);
+
+		size_t fieldsSize = 0;
+		if (!eventClass->fields.empty()) {
+			fieldsSize = getFieldsSize(offset + _headerSize, eventClass);
+			if (fieldsSize == 0)
+				break;
+		}
+
+		uint64_t timestamp = readInteger(_data + offset + _timestampOffset, FieldUInt64);
+		_index.push_back({timestamp, offset});
+		offset += _headerSize + fieldsSize;
+	}
+
+	_truncated = _size - offset;
+	_index.shrink_to_fit();
+}
+
+void CTFStreamReader::next(Event &event)
+{
+	const EventIndex &entry = _index[_next++];
+	size_t offset = entry.offset + _headerSize;
+
+	event.eventClass = getEventClass(entry.offset);
+	event.timestamp = entry.timestamp;
+	event.cpuId = _cpuId;
+
+	// The index already checked that the event fits in the file
+	__attribute__((unused)) bool complete = readStruct(offset, event.eventClass->fields, event.values);
+}
@@ -0,0 +1,144 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF2PRV_CTF_STREAM_READER_HPP
+#define CTF2PRV_CTF_STREAM_READER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CTFMetadata.hpp"
+
+
+namespace ctf2prv {
+
+	union FieldValue {
+		uint64_t integer;
+		double real;
+		const char *string;
+	};
+
+	//! \brief A decoded CTF event. String values point to the mapped stream
+	struct Event {
+		EventClass *eventClass;
+		uint64_t timestamp;
+		uint16_t cpuId;
+		std::vector<FieldValue> values;
+
+		inline uint64_t getInteger(int slot) const
+		{
+			return values[eventClass->fieldSlots[slot]].integer;
+		}
+
+		inline const char *getString(int slot) const
+		{
+			return values[eventClass->fieldSlots[slot]].string;
+		}
+
+		inline bool hasField(int slot) const
+		{
+			return eventClass->fieldSlots[slot] >= 0;
+		}
+	};
+
+	//! \brief Reader of a single CTF stream file. The file is mapped into
+	//! memory and indexed once, so that its events can be decoded in
+	//! timestamp order while merging all the streams of the trace
+	class CTFStreamReader {
+	private:
+		struct EventIndex {
+			uint64_t timestamp;
+			uint64_t offset;
+		};
+
+		std::string _path;
+		CTFMetadata &_metadata;
+
+		const char *_data;
+		size_t _size;
+
+		uint32_t _streamId;
+		uint16_t _cpuId;
+		const StreamClass *_stream;
+
+		//! Offsets of the "id" and "timestamp" fields in the event
+		//! header and its total size
+		size_t _idOffset;
+		FieldType _idType;
+		size_t _timestampOffset;
+		size_t _headerSize;
+
+		std::vector<EventIndex> _index;
+		size_t _next;
+
+		//! Offset of the first event after the packet header and context
+		size_t _firstEvent;
+
+		size_t _truncated;
+
+		static uint64_t readInteger(const char *data, FieldType type);
+
+		//! \brief Decode a fixed-size struct, returning false if it does
+		//! not fit in the file
+		bool readStruct(size_t &offset, const FieldList &fields, std::vector<FieldValue> &values) const;
+
+		//! \brief Get the size of the fields of an event, or 0 if the
+		//! event does not fit in the file
+		size_t getFieldsSize(size_t offset, const EventClass *eventClass) const;
+
+		EventClass *getEventClass(size_t offset) const;
+
+	public:
+		CTFStreamReader(const std::string &path, CTFMetadata &metadata);
+
+		~CTFStreamReader();
+
+		//! \brief Map the file and decode the packet header and context
+		void open();
+
+		//! \brief Walk the whole stream recording where each event starts.
+		//! Safe to be called concurrently on different readers
+		void index();
+
+		inline bool hasNext() const
+		{
+			return _next < _index.size();
+		}
+
+		inline uint64_t getNextTimestamp() const
+		{
+			return _index[_next].timestamp;
+		}
+
+		//! \brief Decode the next event of the stream
+		void next(Event &event);
+
+		uint16_t getCPUId() const
+		{
+			return _cpuId;
+		}
+
+		size_t getNumberOfEvents() const
+		{
+			return _index.size();
+		}
+
+		//! \brief Number of trailing bytes which did not contain a whole
+		//! event, usually because the execution did not end cleanly
+		size_t getTruncatedBytes() const
+		{
+			return _truncated;
+		}
+
+		const std::string &getPath() const
+		{
+			return _path;
+		}
+	};
+}
+
+#endif // CTF2PRV_CTF_STREAM_READER_HPP
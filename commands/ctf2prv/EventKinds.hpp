@@ -0,0 +1,138 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF2PRV_EVENT_KINDS_HPP
+#define CTF2PRV_EVENT_KINDS_HPP
+
+#include "CTFMetadata.hpp"
+
+
+#define CTF2PRV_EVENT_KINDS(X) \
+	X(CTFFlush,                        "nanos6:ctf_flush") \
+	X(ThreadCreate,                    "nanos6:thread_create") \
+	X(ThreadResume,                    "nanos6:thread_resume") \
+	X(ThreadSuspend,                   "nanos6:thread_suspend") \
+	X(ThreadShutdown,                  "nanos6:thread_shutdown") \
+	X(ExternalThreadCreate,            "nanos6:external_thread_create") \
+	X(ExternalThreadResume,            "nanos6:external_thread_resume") \
+	X(ExternalThreadSuspend,           "nanos6:external_thread_suspend") \
+	X(ExternalThreadShutdown,          "nanos6:external_thread_shutdown") \
+	X(WorkerEnterBusyWait,             "nanos6:worker_enter_busy_wait") \
+	X(WorkerExitBusyWait,              "nanos6:worker_exit_busy_wait") \
+	X(TaskLabel,                       "nanos6:task_label") \
+	X(TaskCreateTCEnter,               "nanos6:tc:task_create_enter") \
+	X(TaskCreateTCExit,                "nanos6:tc:task_create_exit") \
+	X(TaskCreateOCEnter,               "nanos6:oc:task_create_enter") \
+	X(TaskCreateOCExit,                "nanos6:oc:task_create_exit") \
+	X(TaskSubmitTCEnter,               "nanos6:tc:task_submit_enter") \
+	X(TaskSubmitTCExit,                "nanos6:tc:task_submit_exit") \
+	X(TaskSubmitOCEnter,               "nanos6:oc:task_submit_enter") \
+	X(TaskSubmitOCExit,                "nanos6:oc:task_submit_exit") \
+	X(TaskStart,                       "nanos6:task_start") \
+	X(TaskforInitEnter,                "nanos6:taskfor_init_enter") \
+	X(TaskforInitExit,                 "nanos6:taskfor_init_exit") \
+	X(TaskBlock,                       "nanos6:task_block") \
+	X(TaskUnblock,                     "nanos6:task_unblock") \
+	X(TaskEnd,                         "nanos6:task_end") \
+	X(DependencyRegisterEnter,         "nanos6:dependency_register_enter") \
+	X(DependencyRegisterExit,          "nanos6:dependency_register_exit") \
+	X(DependencyUnregisterEnter,       "nanos6:dependency_unregister_enter") \
+	X(DependencyUnregisterExit,        "nanos6:dependency_unregister_exit") \
+	X(SchedulerAddTaskEnter,           "nanos6:scheduler_add_task_enter") \
+	X(SchedulerAddTaskExit,            "nanos6:scheduler_add_task_exit") \
+	X(SchedulerGetTaskEnter,           "nanos6:scheduler_get_task_enter") \
+	X(SchedulerGetTaskExit,            "nanos6:scheduler_get_task_exit") \
+	X(TaskwaitTCEnter,                 "nanos6:tc:taskwait_enter") \
+	X(TaskwaitTCExit,                  "nanos6:tc:taskwait_exit") \
+	X(WaitForTCEnter,                  "nanos6:tc:waitfor_enter") \
+	X(WaitForTCExit,                   "nanos6:tc:waitfor_exit") \
+	X(BlockingAPIBlockTCEnter,         "nanos6:tc:blocking_api_block_enter") \
+	X(BlockingAPIBlockTCExit,          "nanos6:tc:blocking_api_block_exit") \
+	X(BlockingAPIUnblockTCEnter,       "nanos6:tc:blocking_api_unblock_enter") \
+	X(BlockingAPIUnblockTCExit,        "nanos6:tc:blocking_api_unblock_exit") \
+	X(BlockingAPIUnblockOCEnter,       "nanos6:oc:blocking_api_unblock_enter") \
+	X(BlockingAPIUnblockOCExit,        "nanos6:oc:blocking_api_unblock_exit") \
+	X(SpawnFunctionTCEnter,            "nanos6:tc:spawn_function_enter") \
+	X(SpawnFunctionTCExit,             "nanos6:tc:spawn_function_exit") \
+	X(SpawnFunctionOCEnter,            "nanos6:oc:spawn_function_enter") \
+	X(SpawnFunctionOCExit,             "nanos6:oc:spawn_function_exit") \
+	X(MutexLockTCEnter,                "nanos6:tc:mutex_lock_enter") \
+	X(MutexLockTCExit,                 "nanos6:tc:mutex_lock_exit") \
+	X(MutexUnlockTCEnter,              "nanos6:tc:mutex_unlock_enter") \
+	X(MutexUnlockTCExit,               "nanos6:tc:mutex_unlock_exit") \
+	X(DebugRegister,                   "nanos6:debug_register") \
+	X(DebugEnter,                      "nanos6:debug_enter") \
+	X(DebugTransition,                 "nanos6:debug_transition") \
+	X(DebugExit,                       "nanos6:debug_exit") \
+	X(SchedulerLockClient,             "nanos6:scheduler_lock_client") \
+	X(SchedulerLockServer,             "nanos6:scheduler_lock_server") \
+	X(SchedulerLockAssign,             "nanos6:scheduler_lock_assign") \
+	X(SchedulerLockServerExit,         "nanos6:scheduler_lock_server_exit")
+
+
+namespace ctf2prv {
+
+	//! \brief The events handled by the converter. Any other event is
+	//! decoded but ignored
+	enum EventKind {
+		EventUnknown = 0,
+#define CTF2PRV_DECLARE_KIND(kind, name) Event##kind,
+		CTF2PRV_EVENT_KINDS(CTF2PRV_DECLARE_KIND)
+#undef CTF2PRV_DECLARE_KIND
+		NumEventKinds
+	};
+
+	//! \brief The event fields looked up by the converter
+	enum FieldSlot {
+		SlotTid = 0,
+		SlotId,
+		SlotType,
+		SlotLabel,
+		SlotSource,
+		SlotStart,
+		SlotEnd,
+		SlotTsAcquire,
+		SlotName,
+		SlotUnboundedTid,
+		NumFieldSlots
+	};
+
+	//! \brief Set the kind and the field slots of an event class
+	static inline void prepareEventClass(EventClass &eventClass)
+	{
+		static const char *kindNames[] = {
+			"",
+#define CTF2PRV_KIND_NAME(kind, name) name,
+			CTF2PRV_EVENT_KINDS(CTF2PRV_KIND_NAME)
+#undef CTF2PRV_KIND_NAME
+		};
+
+		static const char *slotNames[NumFieldSlots] = {
+			"tid", "id", "type", "label", "source", "start", "end",
+			"ts_acquire", "name", "unbounded.tid"
+		};
+
+		eventClass.kind = EventUnknown;
+		for (int kind = 1; kind < NumEventKinds; kind++) {
+			if (eventClass.name == kindNames[kind]) {
+				eventClass.kind = kind;
+				break;
+			}
+		}
+
+		eventClass.fieldSlots.assign(NumFieldSlots, -1);
+		for (int slot = 0; slot < NumFieldSlots; slot++) {
+			for (size_t i = 0; i < eventClass.fields.size(); i++) {
+				if (eventClass.fields[i].name == slotNames[slot]) {
+					eventClass.fieldSlots[slot] = i;
+					break;
+				}
+			}
+		}
+	}
+}
+
+#endif // CTF2PRV_EVENT_KINDS_HPP
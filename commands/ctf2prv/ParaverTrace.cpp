@@ -0,0 +1,332 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "HardwareCounterDefinitions.hpp"
+#include "ParaverTrace.hpp"
+
+
+using namespace ctf2prv;
+
+
+//! Width of the zero-padded numbers of the header, which is rewritten once
+//! the trace duration is known
+static const int paraverHeaderSlotSize = 20;
+
+//! Size of the buffer of the .prv file
+static const size_t prvBufferSize = 8 * 1024 * 1024;
+
+
+ParaverTrace::ParaverTrace() :
+	_name("trace"),
+	_prvFile(nullptr),
+	_nextUnknownCounterId(hardwareCountersUnknownStartId),
+	_cpuIdIndex(0),
+	_maxRealCPUId(0),
+	_ncpus(0),
+	_nvcpus(1), // leader thread virtual cpu
+	_absoluteStartTime(0),
+	_startTime(0),
+	_endTime(0)
+{
+	for (const HardwareCounterDefinition &counter : hardwareCounterDefinitions) {
+		ExtraeEvent event = {counter.extraeId, counter.description, hardwareCountersMid, false, {}};
+		_counters.push_back(std::make_pair(std::string(counter.name), event));
+	}
+}
+
+ParaverTrace::~ParaverTrace()
+{
+	if (_prvFile != nullptr)
+		fclose(_prvFile);
+}
+
+void ParaverTrace::initialize(
+	const std::string &name,
+	uint64_t absoluteStartTime,
+	uint64_t startTime,
+	const std::string &cpuList
+) {
+	_name = name;
+	_absoluteStartTime = absoluteStartTime;
+	_startTime = startTime;
+
+	std::stringstream stream(cpuList);
+	std::string cpu;
+	while (std::getline(stream, cpu, ','))
+		_realCPUList.push_back(std::stoull(cpu));
+	std::sort(_realCPUList.begin(), _realCPUList.end());
+
+	if (_realCPUList.empty())
+		throw std::runtime_error("the trace cpu list is empty");
+	_maxRealCPUId = _realCPUList.back();
+	_ncpus = _realCPUList.size();
+
+	// Paraver does not like cpu id 0
+	_cpuIdIndex = 1;
+	_cpuMap.assign(_maxRealCPUId + 2, (uint64_t) -1);
+	for (uint64_t id : _realCPUList)
+		_cpuMap[id] = _cpuIdIndex++;
+
+	// Leader thread entry
+	_cpuMap[_maxRealCPUId + 1] = _cpuIdIndex++;
+
+	std::string path = _name + ".prv";
+	_prvFile = fopen(path.c_str(), "w");
+	if (_prvFile == nullptr)
+		throw std::runtime_error("cannot create " + path + ": " + strerror(errno));
+
+	_prvBuffer.resize(prvBufferSize);
+	setvbuf(_prvFile, _prvBuffer.data(), _IOFBF, _prvBuffer.size());
+
+	printParaverHeader(true);
+}
+
+ParaverTrace::ExtraeEvent &ParaverTrace::getEvent(uint64_t type, const std::string &description)
+{
+	auto it = _eventsIndex.find(type);
+	if (it != _eventsIndex.end())
+		return _events[it->second];
+
+	ExtraeEvent event = {type, description, 0, true, {}};
+	_eventsIndex[type] = _events.size();
+	_events.push_back(event);
+	return _events.back();
+}
+
+void ParaverTrace::addEventTypeAndValue(uint64_t type, const std::map<uint64_t, std::string> &values, const std::string &description)
+{
+	ExtraeEvent &event = getEvent(type, description);
+	for (auto &value : values)
+		event.values[value.first] = value.second;
+}
+
+void ParaverTrace::addEventType(uint64_t type, const std::string &description)
+{
+	getEvent(type, description);
+}
+
+uint64_t ParaverTrace::getHardwareCounterId(const std::string &name)
+{
+	for (auto &counter : _counters) {
+		if (counter.first == name) {
+			counter.second.used = true;
+			return counter.second.id;
+		}
+	}
+
+	uint64_t id = _nextUnknownCounterId++;
+	ExtraeEvent event = {id, name + " [Unknown]", 0, true, {}};
+	_counters.push_back(std::make_pair(name, event));
+
+	std::cout << "Warning: Missing Hardware Counter Id for " << name
+		<< " assigning the temporal id " << id << std::endl;
+
+	return id;
+}
+
+void ParaverTrace::increaseVirtualCPUCount()
+{
+	_nvcpus++;
+	_cpuMap.push_back(_cpuIdIndex++);
+}
+
+void ParaverTrace::emitEvent(uint64_t timestamp, uint64_t cpuId, const Payload &payload)
+{
+	if (cpuId >= _cpuMap.size())
+		throw std::runtime_error("event emitted on unknown cpu " + std::to_string(cpuId));
+
+	// Each entry takes at most two numbers of 20 digits and two separators
+	_line.resize(64 + 42 * payload.size());
+	char *line = _line.data();
+	char *p = line;
+
+	memcpy(p, "2:0:1:1:", 8);
+	p += 8;
+	writeNumber(p, _cpuMap[cpuId]);
+	*p++ = ':';
+	writeNumber(p, timestamp);
+	for (auto &entry : payload) {
+		*p++ = ':';
+		writeNumber(p, entry.first);
+		*p++ = ':';
+		writeNumber(p, entry.second);
+	}
+	*p++ = '\n';
+
+	fwrite(line, 1, p - line, _prvFile);
+}
+
+void ParaverTrace::emitCommunicationEvent(uint64_t cpuSendId, uint64_t timeSend, uint64_t cpuRecvId, uint64_t timeRecv)
+{
+	const int size = 1;
+	const int tag = 1;
+
+	fprintf(_prvFile, "3:0:1:1:%" PRIu64 ":%" PRIu64 ":%" PRIu64 ":0:1:1:%" PRIu64 ":%" PRIu64 ":%" PRIu64 ":%d:%d\n",
+		_cpuMap.at(cpuSendId), timeSend, timeSend,
+		_cpuMap.at(cpuRecvId), timeRecv, timeRecv,
+		size, tag);
+}
+
+void ParaverTrace::printParaverHeader(bool fake)
+{
+	char timeHeader[64];
+	time_t absoluteStartTime = _absoluteStartTime;
+	struct tm date;
+	gmtime_r(&absoluteStartTime, &date);
+	strftime(timeHeader, sizeof(timeHeader), "#Paraver (%d/%m/%y at %H:%M):", &date);
+
+	uint64_t totalTime = 0;
+	if (!fake) {
+		if (_endTime == 0)
+			throw std::runtime_error("no trace end time specified, cannot calculate total duration");
+		totalTime = _endTime - _startTime;
+	}
+
+	// This is a hack
+	uint64_t nThreads = _ncpus + _nvcpus;
+
+	// The resource model is disabled and there is a single application
+	// with a single task
+	rewind(_prvFile);
+	fprintf(_prvFile, "%s%0*" PRIu64 "_ns:0:1:1(%0*" PRIu64 ":1)\n",
+		timeHeader,
+		paraverHeaderSlotSize, totalTime,
+		paraverHeaderSlotSize, nThreads);
+}
+
+static std::string buildStateColors()
+{
+	static const int colors[][3] = {
+		{  0,   0,   0}, // black (never shown anyways)
+		{  0,   0, 255}, // deepblue: runtime
+		{217, 217, 217}, // lightgrey: busy wait
+		{230,  25,  75}, // red: task
+		{ 60, 180,  75}, // green
+		{255, 225,  25}, // yellow
+		{245, 130,  48}, // orange
+		{145,  30, 180}, // purple
+		{ 70, 240, 240}, // cyan
+		{240,  50, 230}, // magenta
+		{210, 245,  60}, // lime
+		{250, 190, 212}, // pink
+		{  0, 128, 128}, // teal
+		{128, 128, 128}, // grey
+		{220, 190, 255}, // lavender
+		{170, 110,  40}, // brown
+		{255, 250, 200}, // beige
+		{128,   0,   0}, // maroon
+		{170, 255, 195}, // mint
+		{128, 128,   0}, // olive
+		{255, 215, 180}, // apricot
+		{  0,   0, 128}, // navy
+		{  0, 130, 200}  // blue
+	};
+
+	std::string result = "STATES_COLOR\n";
+	char line[64];
+	int count = 0;
+	for (const int *color : colors) {
+		snprintf(line, sizeof(line), "%-3d {%3d, %3d, %3d}\n", count++, color[0], color[1], color[2]);
+		result += line;
+	}
+	result += "\n\n";
+
+	return result;
+}
+
+void ParaverTrace::printPcf()
+{
+	std::string pcf =
+		"DEFAULT_OPTIONS\n"
+		"\n"
+		"LEVEL               THREAD\n"
+		"UNITS               NANOSEC\n"
+		"LOOK_BACK           100\n"
+		"SPEED               1\n"
+		"FLAG_ICONS          ENABLED\n"
+		"NUM_OF_STATE_COLORS 1000\n"
+		"YMAX_SCALE          37\n"
+		"\n"
+		"\n"
+		"DEFAULT_SEMANTIC\n"
+		"\n"
+		"THREAD_FUNC          State As Is\n"
+		"\n"
+		"\n";
+
+	pcf += buildStateColors();
+
+	for (const ExtraeEvent &event : _events) {
+		pcf += "EVENT_TYPE\n";
+		pcf += std::to_string(event.mid) + "    " + std::to_string(event.id) + "    " + event.description + "\n";
+		if (!event.values.empty()) {
+			pcf += "VALUES\n";
+			for (auto &value : event.values)
+				pcf += std::to_string(value.first) + "     " + value.second + "\n";
+		}
+		pcf += "\n\n";
+	}
+
+	std::string counters;
+	for (auto &counter : _counters) {
+		const ExtraeEvent &event = counter.second;
+		if (event.used)
+			counters += std::to_string(event.mid) + "    " + std::to_string(event.id) + "    " + event.description + "\n";
+	}
+	if (!counters.empty())
+		pcf += "EVENT_TYPE\n" + counters + "\n";
+	pcf += "\n\n";
+
+	std::string path = _name + ".pcf";
+	FILE *file = fopen(path.c_str(), "w");
+	if (file == nullptr)
+		throw std::runtime_error("cannot create " + path + ": " + strerror(errno));
+	fputs(pcf.c_str(), file);
+	fclose(file);
+}
+
+void ParaverTrace::printRow()
+{
+	std::string row = "LEVEL NODE SIZE 1\nhostname\n\n";
+	row += "LEVEL THREAD SIZE " + std::to_string(_ncpus + _nvcpus) + "\n";
+
+	for (uint64_t cpu : _realCPUList)
+		row += "CPU " + std::to_string(cpu) + "\n";
+
+	row += "LT VCPU " + std::to_string(getLeaderThreadCPUId()) + "\n";
+
+	for (uint64_t cpu = 0; cpu < _nvcpus - 1; cpu++)
+		row += "ET VCPU " + std::to_string(_ncpus + 1 + cpu) + "\n";
+
+	std::string path = _name + ".row";
+	FILE *file = fopen(path.c_str(), "w");
+	if (file == nullptr)
+		throw std::runtime_error("cannot create " + path + ": " + strerror(errno));
+	fputs(row.c_str(), file);
+	fclose(file);
+}
+
+void ParaverTrace::finalize(uint64_t endTime)
+{
+	_endTime = endTime;
+
+	printParaverHeader(false);
+	if (fclose(_prvFile))
+		throw std::runtime_error("cannot write " + _name + ".prv: " + strerror(errno));
+	_prvFile = nullptr;
+
+	printPcf();
+	printRow();
+}
@@ -0,0 +1,140 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF2PRV_PARAVER_TRACE_HPP
+#define CTF2PRV_PARAVER_TRACE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace ctf2prv {
+
+	namespace ExtraeEventTypes {
+		enum {
+			CTF_FLUSH                 = 6400009,
+			RUNTIME_CODE              = 6400010,
+			RUNTIME_BUSYWAITING       = 6400011,
+			RUNTIME_TASKS             = 6400012,
+			RUNNING_TASK_LABEL        = 6400013,
+			RUNNING_TASK_SOURCE       = 6400014,
+			RUNNING_THREAD_TID        = 6400015,
+			RUNNING_TASK_ID           = 6400016,
+			RUNTIME_SUBSYSTEMS        = 6400017,
+			NUMBER_OF_READY_TASKS     = 6400018,
+			NUMBER_OF_CREATED_TASKS   = 6400019,
+			NUMBER_OF_BLOCKED_TASKS   = 6400020,
+			NUMBER_OF_RUNNING_TASKS   = 6400021,
+			NUMBER_OF_CREATED_THREADS = 6400022,
+			NUMBER_OF_RUNNING_THREADS = 6400023,
+			NUMBER_OF_BLOCKED_THREADS = 6400024
+		};
+	}
+
+	typedef std::vector<std::pair<uint64_t, uint64_t>> Payload;
+
+	//! \brief Writer of the Paraver .prv, .pcf and .row files. The output is
+	//! equivalent to the one of the ctf2prv python converter
+	class ParaverTrace {
+	private:
+		struct ExtraeEvent {
+			uint64_t id;
+			std::string description;
+			uint64_t mid;
+			bool used;
+			std::map<uint64_t, std::string> values;
+		};
+
+		std::string _name;
+
+		FILE *_prvFile;
+		std::vector<char> _prvBuffer;
+		std::vector<char> _line;
+
+		//! Event types in order of registration
+		std::vector<ExtraeEvent> _events;
+		std::map<uint64_t, size_t> _eventsIndex;
+
+		//! Hardware counters collection, keyed by counter name
+		std::vector<std::pair<std::string, ExtraeEvent>> _counters;
+		uint64_t _nextUnknownCounterId;
+
+		//! Map from runtime cpu ids to Paraver cpu ids
+		std::vector<uint64_t> _cpuMap;
+		uint64_t _cpuIdIndex;
+		std::vector<uint64_t> _realCPUList;
+		uint64_t _maxRealCPUId;
+		uint64_t _ncpus;
+		uint64_t _nvcpus;
+
+		uint64_t _absoluteStartTime;
+		uint64_t _startTime;
+		uint64_t _endTime;
+
+		ExtraeEvent &getEvent(uint64_t type, const std::string &description);
+
+		void printParaverHeader(bool fake);
+		void printPcf();
+		void printRow();
+
+		inline void writeNumber(char *&p, uint64_t value)
+		{
+			char digits[20];
+			int n = 0;
+			do {
+				digits[n++] = '0' + (value % 10);
+				value /= 10;
+			} while (value);
+			while (n)
+				*p++ = digits[--n];
+		}
+
+	public:
+		ParaverTrace();
+
+		~ParaverTrace();
+
+		//! \brief Create the .prv file in the current directory
+		void initialize(
+			const std::string &name,
+			uint64_t absoluteStartTime,
+			uint64_t startTime,
+			const std::string &cpuList
+		);
+
+		void addEventTypeAndValue(uint64_t type, const std::map<uint64_t, std::string> &values, const std::string &description = "");
+
+		void addEventType(uint64_t type, const std::string &description = "");
+
+		//! \brief Get the Extrae event type of a hardware counter
+		uint64_t getHardwareCounterId(const std::string &name);
+
+		void increaseVirtualCPUCount();
+
+		void emitEvent(uint64_t timestamp, uint64_t cpuId, const Payload &payload);
+
+		void emitCommunicationEvent(uint64_t cpuSendId, uint64_t timeSend, uint64_t cpuRecvId, uint64_t timeRecv);
+
+		//! \brief Complete the .prv header and write the .pcf and .row files
+		void finalize(uint64_t endTime);
+
+		uint64_t getMaxRealCPUId() const
+		{
+			return _maxRealCPUId;
+		}
+
+		uint64_t getLeaderThreadCPUId() const
+		{
+			return _maxRealCPUId + 1;
+		}
+	};
+}
+
+#endif // CTF2PRV_PARAVER_TRACE_HPP
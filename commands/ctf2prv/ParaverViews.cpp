@@ -0,0 +1,606 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <string>
+
+#include "EventKinds.hpp"
+#include "ParaverViews.hpp"
+
+
+using namespace ctf2prv;
+
+
+namespace RuntimeActivity {
+	enum {
+		End         = 0,
+		Runtime     = 1,
+		BusyWaiting = 2,
+		Task        = 3
+	};
+}
+
+static inline void append(Payload &payload, uint64_t type, uint64_t value)
+{
+	payload.push_back(std::make_pair(type, value));
+}
+
+
+ParaverViewRuntimeCode::ParaverViewRuntimeCode(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace)
+{
+	_trace.addEventTypeAndValue(ExtraeEventTypes::RUNTIME_CODE, {
+			{RuntimeActivity::End,     "End"},
+			{RuntimeActivity::Runtime, "Runtime"}
+		}, "Runtime: Runtime Code");
+}
+
+void ParaverViewRuntimeCode::process(const Event &event, Payload &payload)
+{
+	switch (event.eventClass->kind) {
+		case EventThreadResume:
+		case EventExternalThreadResume:
+			append(payload, ExtraeEventTypes::RUNTIME_CODE, RuntimeActivity::Runtime);
+			break;
+		case EventThreadSuspend:
+		case EventExternalThreadSuspend:
+		case EventThreadShutdown:
+		case EventExternalThreadShutdown:
+			append(payload, ExtraeEventTypes::RUNTIME_CODE, RuntimeActivity::End);
+			break;
+		default:
+			break;
+	}
+}
+
+
+ParaverViewRuntimeBusyWaiting::ParaverViewRuntimeBusyWaiting(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace)
+{
+	_trace.addEventTypeAndValue(ExtraeEventTypes::RUNTIME_BUSYWAITING, {
+			{RuntimeActivity::End,         "End"},
+			{RuntimeActivity::BusyWaiting, "Busy Waiting"}
+		}, "Runtime: Busy Waiting");
+}
+
+void ParaverViewRuntimeBusyWaiting::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind != EventThreadShutdown && kind != EventThreadSuspend && kind != EventThreadResume
+		&& kind != EventWorkerEnterBusyWait && kind != EventWorkerExitBusyWait)
+		return;
+
+	Thread *thread = _model.getCurrentThread(event);
+	if (thread == nullptr)
+		return;
+
+	switch (kind) {
+		case EventThreadResume:
+			if (thread->isBusyWaiting)
+				append(payload, ExtraeEventTypes::RUNTIME_BUSYWAITING, RuntimeActivity::BusyWaiting);
+			break;
+		case EventThreadShutdown:
+		case EventThreadSuspend:
+			if (thread->isBusyWaiting)
+				append(payload, ExtraeEventTypes::RUNTIME_BUSYWAITING, RuntimeActivity::End);
+			break;
+		case EventWorkerEnterBusyWait:
+			thread->isBusyWaiting = true;
+			append(payload, ExtraeEventTypes::RUNTIME_BUSYWAITING, RuntimeActivity::BusyWaiting);
+			break;
+		case EventWorkerExitBusyWait:
+			thread->isBusyWaiting = false;
+			append(payload, ExtraeEventTypes::RUNTIME_BUSYWAITING, RuntimeActivity::End);
+			break;
+	}
+}
+
+
+ParaverViewRuntimeTasks::ParaverViewRuntimeTasks(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace)
+{
+	_trace.addEventTypeAndValue(ExtraeEventTypes::RUNTIME_TASKS, {
+			{RuntimeActivity::End,  "End"},
+			{RuntimeActivity::Task, "Task"}
+		}, "Runtime: Task Code");
+}
+
+void ParaverViewRuntimeTasks::process(const Event &event, Payload &payload)
+{
+	switch (event.eventClass->kind) {
+		case EventTaskStart:
+		case EventTaskSubmitTCExit:
+		case EventTaskwaitTCExit:
+		case EventWaitForTCExit:
+		case EventMutexLockTCExit:
+		case EventMutexUnlockTCExit:
+		case EventBlockingAPIBlockTCExit:
+		case EventBlockingAPIUnblockTCExit:
+		case EventSpawnFunctionTCExit:
+			append(payload, ExtraeEventTypes::RUNTIME_TASKS, RuntimeActivity::Task);
+			break;
+		case EventTaskEnd:
+		case EventTaskCreateTCEnter:
+		case EventTaskwaitTCEnter:
+		case EventWaitForTCEnter:
+		case EventMutexLockTCEnter:
+		case EventMutexUnlockTCEnter:
+		case EventBlockingAPIBlockTCEnter:
+		case EventBlockingAPIUnblockTCEnter:
+		case EventSpawnFunctionTCEnter:
+			append(payload, ExtraeEventTypes::RUNTIME_TASKS, RuntimeActivity::End);
+			break;
+		default:
+			break;
+	}
+}
+
+
+ParaverViewRunningTask::ParaverViewRunningTask(RuntimeModel &model, ParaverTrace &trace, Attribute attribute) :
+	ParaverView(model, trace),
+	_attribute(attribute)
+{
+	const char *description;
+	if (attribute == Label) {
+		_type = ExtraeEventTypes::RUNNING_TASK_LABEL;
+		description = "Running Task Label";
+	} else if (attribute == Source) {
+		_type = ExtraeEventTypes::RUNNING_TASK_SOURCE;
+		description = "Running Task Source";
+	} else {
+		_type = ExtraeEventTypes::RUNNING_TASK_ID;
+		description = "Task ID";
+	}
+
+	_trace.addEventTypeAndValue(_type, {{RuntimeActivity::End, "End"}}, description);
+}
+
+void ParaverViewRunningTask::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+
+	if (kind == EventTaskLabel) {
+		if (_attribute != Id) {
+			const char *value = event.getString((_attribute == Label) ? SlotLabel : SlotSource);
+			_trace.addEventTypeAndValue(_type, {{event.getInteger(SlotType), value}});
+		}
+		return;
+	}
+
+	if (kind != EventTaskStart && kind != EventTaskBlock && kind != EventTaskUnblock
+		&& kind != EventTaskEnd && kind != EventThreadResume && kind != EventThreadSuspend)
+		return;
+
+	Thread *thread = _model.getCurrentThread(event);
+	if (thread == nullptr)
+		return;
+
+	const Task &task = thread->getTask();
+	switch (kind) {
+		case EventTaskStart:
+		case EventTaskUnblock:
+			append(payload, _type, getValue(task));
+			break;
+		case EventTaskBlock:
+		case EventTaskEnd:
+			append(payload, _type, RuntimeActivity::End);
+			break;
+		case EventThreadResume:
+			if (task.isRunning())
+				append(payload, _type, getValue(task));
+			break;
+		case EventThreadSuspend:
+			if (task.isRunning())
+				append(payload, _type, RuntimeActivity::End);
+			break;
+	}
+}
+
+
+ParaverViewHardwareCounters::ParaverViewHardwareCounters(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace)
+{
+}
+
+void ParaverViewHardwareCounters::process(const Event &event, Payload &payload)
+{
+	auto it = _counters.find(event.eventClass);
+	if (it == _counters.end()) {
+		// The CTF field name is used to obtain the right Extrae id
+		static const std::string prefix = "hwc.";
+
+		CounterList counters;
+		const FieldList &fields = event.eventClass->fields;
+		for (size_t i = 0; i < fields.size(); i++) {
+			if (fields[i].name.compare(0, prefix.size(), prefix) == 0) {
+				uint64_t id = _trace.getHardwareCounterId(fields[i].name.substr(prefix.size()));
+				counters.push_back(std::make_pair(i, id));
+			}
+		}
+		it = _counters.emplace(event.eventClass, counters).first;
+	}
+
+	for (auto &counter : it->second)
+		append(payload, counter.second, event.values[counter.first].integer);
+}
+
+
+ParaverViewThreadId::ParaverViewThreadId(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace),
+	_nextColor(1)
+{
+	_trace.addEventTypeAndValue(ExtraeEventTypes::RUNNING_THREAD_TID,
+		{{RuntimeActivity::End, "End"}}, "Worker Thread Id (TID)");
+}
+
+void ParaverViewThreadId::process(const Event &event, Payload &payload)
+{
+	switch (event.eventClass->kind) {
+		case EventThreadCreate:
+		case EventExternalThreadCreate: {
+			uint64_t tid = event.getInteger(SlotTid);
+			uint64_t color = _nextColor++;
+			_colorMap[tid] = color;
+			_trace.addEventTypeAndValue(ExtraeEventTypes::RUNNING_THREAD_TID,
+				{{color, "thread " + std::to_string(tid)}});
+			break;
+		}
+		case EventThreadResume:
+		case EventExternalThreadResume: {
+			auto it = _colorMap.find(event.getInteger(SlotTid));
+			if (it != _colorMap.end())
+				append(payload, ExtraeEventTypes::RUNNING_THREAD_TID, it->second);
+			break;
+		}
+		case EventThreadSuspend:
+		case EventExternalThreadSuspend:
+		case EventThreadShutdown:
+		case EventExternalThreadShutdown:
+			append(payload, ExtraeEventTypes::RUNNING_THREAD_TID, RuntimeActivity::End);
+			break;
+		default:
+			break;
+	}
+}
+
+
+ParaverViewRuntimeSubsystems::ParaverViewRuntimeSubsystems(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace)
+{
+	_trace.addEventTypeAndValue(ExtraeEventTypes::RUNTIME_SUBSYSTEMS, {
+			{Idle,                 "Idle"},
+			{Runtime,              "Runtime"},
+			{BusyWait,             "Busy Wait"},
+			{Task,                 "Task"},
+			{DependencyRegister,   "Dependency: Register"},
+			{DependencyUnregister, "Dependency: Unregister"},
+			{SchedulerAddTask,     "Scheduler: Add Ready Task"},
+			{SchedulerGetTask,     "Scheduler: Get Ready Task"},
+			{TaskCreate,           "Task: Create"},
+			{TaskArgsInit,         "Task: Arguments Init"},
+			{TaskSubmit,           "Task: Submit"},
+			{TaskforInit,          "Task: Taskfor Collaborator Init"},
+			{TaskWait,             "Task: TaskWait"},
+			{WaitFor,              "Task: WaitFor"},
+			{Lock,                 "Task: User Mutex: Lock"},
+			{Unlock,               "Task: User Mutex: Unlock"},
+			{BlockingAPIBlock,     "Task: Blocking API: Block"},
+			{BlockingAPIUnblock,   "Task: Blocking API: Unblock"},
+			{SpawnFunction,        "SpawnFunction: Spawn"},
+			{SchedulerLockEnter,   "Scheduler: Lock: Enter"},
+			{SchedulerLockServing, "Scheduler: Lock: Serving tasks"}
+		}, "Runtime Subsystems");
+}
+
+void ParaverViewRuntimeSubsystems::push(Thread *thread, uint64_t status, Payload &payload)
+{
+	thread->eventStack.push_back(status);
+	append(payload, ExtraeEventTypes::RUNTIME_SUBSYSTEMS, status);
+}
+
+void ParaverViewRuntimeSubsystems::pop(Thread *thread, Payload &payload)
+{
+	std::vector<uint64_t> &stack = thread->eventStack;
+	if (!stack.empty())
+		stack.pop_back();
+	if (!stack.empty())
+		append(payload, ExtraeEventTypes::RUNTIME_SUBSYSTEMS, stack.back());
+}
+
+void ParaverViewRuntimeSubsystems::replace(Thread *thread, uint64_t status, Payload &payload)
+{
+	std::vector<uint64_t> &stack = thread->eventStack;
+	if (!stack.empty())
+		stack.pop_back();
+	push(thread, status, payload);
+}
+
+void ParaverViewRuntimeSubsystems::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+
+	// Events which do not depend on the current thread
+	switch (kind) {
+		case EventUnknown:
+		case EventCTFFlush:
+		case EventTaskLabel:
+		case EventTaskBlock:
+		case EventTaskUnblock:
+			return;
+		case EventThreadCreate:
+			_model.getThread(event.getInteger(SlotTid)).eventStack.assign(1, Runtime);
+			return;
+		case EventExternalThreadCreate:
+			_model.getThread(event.getInteger(SlotTid)).eventStack.assign(1, Idle);
+			return;
+		case EventThreadSuspend:
+		case EventThreadShutdown:
+		case EventExternalThreadShutdown:
+			append(payload, ExtraeEventTypes::RUNTIME_SUBSYSTEMS, Idle);
+			return;
+		case EventSchedulerLockAssign:
+			_servedTasks[event.getInteger(SlotId)] = std::make_pair(event.timestamp, (uint64_t) event.cpuId);
+			return;
+		case EventDebugRegister: {
+			uint64_t id = Debug + event.getInteger(SlotId);
+			_trace.addEventTypeAndValue(ExtraeEventTypes::RUNTIME_SUBSYSTEMS,
+				{{id, std::string("Debug: ") + event.getString(SlotName)}});
+			return;
+		}
+		default:
+			break;
+	}
+
+	Thread *thread = _model.getCurrentThread(event);
+	if (thread == nullptr)
+		return;
+
+	switch (kind) {
+		case EventThreadResume:
+			if (!thread->eventStack.empty())
+				append(payload, ExtraeEventTypes::RUNTIME_SUBSYSTEMS, thread->eventStack.back());
+			break;
+		case EventExternalThreadResume:
+			push(thread, Runtime, payload);
+			break;
+		case EventTaskStart:
+			push(thread, Task, payload);
+			break;
+		case EventTaskwaitTCEnter:
+			push(thread, TaskWait, payload);
+			break;
+		case EventWaitForTCEnter:
+			push(thread, WaitFor, payload);
+			break;
+		case EventMutexLockTCEnter:
+			push(thread, Lock, payload);
+			break;
+		case EventMutexUnlockTCEnter:
+			push(thread, Unlock, payload);
+			break;
+		case EventBlockingAPIBlockTCEnter:
+			push(thread, BlockingAPIBlock, payload);
+			break;
+		case EventBlockingAPIUnblockTCEnter:
+		case EventBlockingAPIUnblockOCEnter:
+			push(thread, BlockingAPIUnblock, payload);
+			break;
+		case EventSpawnFunctionTCEnter:
+		case EventSpawnFunctionOCEnter:
+			push(thread, SpawnFunction, payload);
+			break;
+		case EventWorkerEnterBusyWait:
+			push(thread, BusyWait, payload);
+			break;
+		case EventDependencyRegisterEnter:
+			push(thread, DependencyRegister, payload);
+			break;
+		case EventDependencyUnregisterEnter:
+			push(thread, DependencyUnregister, payload);
+			break;
+		case EventSchedulerAddTaskEnter:
+			push(thread, SchedulerAddTask, payload);
+			break;
+		case EventSchedulerGetTaskEnter:
+			push(thread, SchedulerGetTask, payload);
+			break;
+		case EventTaskCreateTCEnter:
+		case EventTaskCreateOCEnter:
+			push(thread, TaskCreate, payload);
+			break;
+		case EventTaskCreateTCExit:
+		case EventTaskCreateOCExit:
+			replace(thread, TaskArgsInit, payload);
+			break;
+		case EventTaskSubmitTCEnter:
+		case EventTaskSubmitOCEnter:
+			replace(thread, TaskSubmit, payload);
+			break;
+		case EventTaskforInitEnter:
+			push(thread, TaskforInit, payload);
+			break;
+		case EventDebugEnter:
+			push(thread, Debug + event.getInteger(SlotId), payload);
+			break;
+		case EventDebugTransition:
+			replace(thread, Debug + event.getInteger(SlotId), payload);
+			break;
+		case EventExternalThreadSuspend:
+		case EventTaskEnd:
+		case EventTaskwaitTCExit:
+		case EventWaitForTCExit:
+		case EventMutexLockTCExit:
+		case EventMutexUnlockTCExit:
+		case EventBlockingAPIBlockTCExit:
+		case EventBlockingAPIUnblockTCExit:
+		case EventBlockingAPIUnblockOCExit:
+		case EventSpawnFunctionTCExit:
+		case EventSpawnFunctionOCExit:
+		case EventWorkerExitBusyWait:
+		case EventDependencyRegisterExit:
+		case EventDependencyUnregisterExit:
+		case EventSchedulerAddTaskExit:
+		case EventSchedulerGetTaskExit:
+		case EventTaskSubmitTCExit:
+		case EventTaskSubmitOCExit:
+		case EventTaskforInitExit:
+		case EventSchedulerLockServerExit:
+		case EventDebugExit:
+			pop(thread, payload);
+			break;
+		case EventSchedulerLockClient: {
+			uint64_t taskId = event.getInteger(SlotId);
+			uint64_t timeAcquire = event.getInteger(SlotTsAcquire);
+
+			// Emit an event in the past. No tracepoint can be emitted
+			// between getting the lock and completing the operation
+			_trace.emitEvent(timeAcquire, event.cpuId,
+				{std::make_pair((uint64_t) ExtraeEventTypes::RUNTIME_SUBSYSTEMS, (uint64_t) SchedulerLockEnter)});
+
+			// Paraver requires the communication line that relates the
+			// serving worker and this one before any current event
+			if (taskId != 0) {
+				auto it = _servedTasks.find(taskId);
+				if (it != _servedTasks.end()) {
+					_trace.emitCommunicationEvent(it->second.second, it->second.first,
+						event.cpuId, event.timestamp);
+				}
+			}
+
+			if (!thread->eventStack.empty())
+				append(payload, ExtraeEventTypes::RUNTIME_SUBSYSTEMS, thread->eventStack.back());
+			break;
+		}
+		case EventSchedulerLockServer: {
+			uint64_t timeAcquire = event.getInteger(SlotTsAcquire);
+			_trace.emitEvent(timeAcquire, event.cpuId,
+				{std::make_pair((uint64_t) ExtraeEventTypes::RUNTIME_SUBSYSTEMS, (uint64_t) SchedulerLockEnter)});
+			push(thread, SchedulerLockServing, payload);
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+
+ParaverViewCTFFlush::ParaverViewCTFFlush(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverView(model, trace)
+{
+	_trace.addEventTypeAndValue(ExtraeEventTypes::CTF_FLUSH, {
+			{0, "End"},
+			{1, "flush"}
+		}, "Nanos6 CTF buffers writes to disk");
+}
+
+void ParaverViewCTFFlush::process(const Event &event, Payload &)
+{
+	if (event.eventClass->kind != EventCTFFlush)
+		return;
+
+	// Events are emitted directly using the event fields as timestamps. It
+	// is safe since no events could be emitted by the flushing thread
+	// between the last processed event and now
+	uint64_t cpuId = _model.getVirtualCPUId(event);
+	_trace.emitEvent(event.getInteger(SlotStart), cpuId,
+		{std::make_pair((uint64_t) ExtraeEventTypes::CTF_FLUSH, (uint64_t) 1)});
+	_trace.emitEvent(event.getInteger(SlotEnd), cpuId,
+		{std::make_pair((uint64_t) ExtraeEventTypes::CTF_FLUSH, (uint64_t) 0)});
+}
+
+
+ParaverViewNumberOfCreatedTasks::ParaverViewNumberOfCreatedTasks(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverViewCounter(model, trace, ExtraeEventTypes::NUMBER_OF_CREATED_TASKS, "Number of Created Tasks")
+{
+}
+
+void ParaverViewNumberOfCreatedTasks::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind == EventTaskCreateTCEnter || kind == EventTaskCreateOCEnter)
+		update(1, payload);
+}
+
+
+ParaverViewNumberOfBlockedTasks::ParaverViewNumberOfBlockedTasks(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverViewCounter(model, trace, ExtraeEventTypes::NUMBER_OF_BLOCKED_TASKS, "Number of Blocked Tasks")
+{
+}
+
+void ParaverViewNumberOfBlockedTasks::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind == EventTaskBlock)
+		update(1, payload);
+	else if (kind == EventTaskUnblock)
+		update(-1, payload);
+}
+
+
+ParaverViewNumberOfRunningTasks::ParaverViewNumberOfRunningTasks(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverViewCounter(model, trace, ExtraeEventTypes::NUMBER_OF_RUNNING_TASKS, "Number of Running Tasks")
+{
+}
+
+void ParaverViewNumberOfRunningTasks::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind == EventTaskStart || kind == EventTaskUnblock)
+		update(1, payload);
+	else if (kind == EventTaskBlock || kind == EventTaskEnd)
+		update(-1, payload);
+}
+
+
+ParaverViewNumberOfCreatedThreads::ParaverViewNumberOfCreatedThreads(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverViewCounter(model, trace, ExtraeEventTypes::NUMBER_OF_CREATED_THREADS, "Number of Created Threads")
+{
+}
+
+void ParaverViewNumberOfCreatedThreads::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind == EventThreadCreate)
+		update(1, payload);
+	else if (kind == EventThreadShutdown)
+		update(-1, payload);
+}
+
+
+ParaverViewNumberOfRunningThreads::ParaverViewNumberOfRunningThreads(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverViewCounter(model, trace, ExtraeEventTypes::NUMBER_OF_RUNNING_THREADS, "Number of Running Threads")
+{
+}
+
+void ParaverViewNumberOfRunningThreads::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind == EventThreadResume)
+		update(1, payload);
+	else if (kind == EventThreadSuspend || kind == EventThreadShutdown)
+		update(-1, payload);
+}
+
+
+ParaverViewNumberOfBlockedThreads::ParaverViewNumberOfBlockedThreads(RuntimeModel &model, ParaverTrace &trace) :
+	ParaverViewCounter(model, trace, ExtraeEventTypes::NUMBER_OF_BLOCKED_THREADS, "Number of Blocked Threads")
+{
+}
+
+void ParaverViewNumberOfBlockedThreads::process(const Event &event, Payload &payload)
+{
+	const int kind = event.eventClass->kind;
+	if (kind == EventThreadResume) {
+		// It may be a new thread instead of a previously blocked one
+		if (_blockedThreads.erase(event.getInteger(SlotTid))) {
+			_count = _blockedThreads.size();
+			update(0, payload);
+		}
+	} else if (kind == EventThreadSuspend) {
+		_blockedThreads.insert(event.getInteger(SlotTid));
+		_count = _blockedThreads.size();
+		update(0, payload);
+	}
+}
@@ -0,0 +1,230 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF2PRV_PARAVER_VIEWS_HPP
+#define CTF2PRV_PARAVER_VIEWS_HPP
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CTFStreamReader.hpp"
+#include "ParaverTrace.hpp"
+#include "RuntimeModel.hpp"
+
+
+namespace ctf2prv {
+
+	//! \brief A Paraver view translates CTF events into Paraver events of
+	//! one or more event types. Views mirror the ones of the ctf2prv python
+	//! converter (scripts/ctf/plugins/paraverviews.py)
+	class ParaverView {
+	protected:
+		RuntimeModel &_model;
+		ParaverTrace &_trace;
+
+	public:
+		ParaverView(RuntimeModel &model, ParaverTrace &trace) :
+			_model(model),
+			_trace(trace)
+		{
+		}
+
+		virtual ~ParaverView()
+		{
+		}
+
+		//! \brief Called before any CTF event is processed
+		virtual void start(Payload &)
+		{
+		}
+
+		//! \brief Append the Paraver events derived from a CTF event
+		virtual void process(const Event &event, Payload &payload) = 0;
+	};
+
+	class ParaverViewRuntimeCode : public ParaverView {
+	public:
+		ParaverViewRuntimeCode(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewRuntimeBusyWaiting : public ParaverView {
+	public:
+		ParaverViewRuntimeBusyWaiting(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewRuntimeTasks : public ParaverView {
+	public:
+		ParaverViewRuntimeTasks(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	//! \brief Shows the label, source or id of the tasks running on each
+	//! core. Periods of runtime code running on behalf of tasks are shown
+	//! as tasks unless the task blocks or ends. A worker might suspend while
+	//! running a task that has not blocked, which is detected through the
+	//! thread suspend and resume events
+	class ParaverViewRunningTask : public ParaverView {
+	public:
+		enum Attribute {
+			Label,
+			Source,
+			Id
+		};
+
+	private:
+		Attribute _attribute;
+		uint64_t _type;
+
+		uint64_t getValue(const Task &task) const
+		{
+			return (_attribute == Id) ? task.id : task.type;
+		}
+
+	public:
+		ParaverViewRunningTask(RuntimeModel &model, ParaverTrace &trace, Attribute attribute);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewHardwareCounters : public ParaverView {
+	private:
+		//! Field index and Extrae type of the counters of each event class
+		typedef std::vector<std::pair<size_t, uint64_t>> CounterList;
+		std::unordered_map<const EventClass *, CounterList> _counters;
+
+	public:
+		ParaverViewHardwareCounters(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewThreadId : public ParaverView {
+	private:
+		std::unordered_map<uint64_t, uint64_t> _colorMap;
+		uint64_t _nextColor;
+
+	public:
+		ParaverViewThreadId(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewRuntimeSubsystems : public ParaverView {
+	public:
+		enum Status {
+			Idle                 = 0,
+			Runtime              = 1,
+			BusyWait             = 2,
+			Task                 = 3,
+			DependencyRegister   = 4,
+			DependencyUnregister = 5,
+			SchedulerAddTask     = 6,
+			SchedulerGetTask     = 7,
+			TaskCreate           = 8,
+			TaskArgsInit         = 9,
+			TaskSubmit           = 10,
+			TaskforInit          = 11,
+			TaskWait             = 12,
+			WaitFor              = 13,
+			Lock                 = 14,
+			Unlock               = 15,
+			BlockingAPIBlock     = 16,
+			BlockingAPIUnblock   = 17,
+			SpawnFunction        = 18,
+			SchedulerLockEnter   = 19,
+			SchedulerLockServing = 20,
+			Debug                = 100
+		};
+
+	private:
+		//! Timestamp and cpu of the worker which served each task
+		std::unordered_map<uint64_t, std::pair<uint64_t, uint64_t>> _servedTasks;
+
+		void push(Thread *thread, uint64_t status, Payload &payload);
+		void pop(Thread *thread, Payload &payload);
+		void replace(Thread *thread, uint64_t status, Payload &payload);
+
+	public:
+		ParaverViewRuntimeSubsystems(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewCTFFlush : public ParaverView {
+	public:
+		ParaverViewCTFFlush(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	//! \brief Base of the views which show a global counter
+	class ParaverViewCounter : public ParaverView {
+	protected:
+		uint64_t _type;
+		int64_t _count;
+
+		void update(int64_t delta, Payload &payload)
+		{
+			_count += delta;
+			payload.push_back(std::make_pair(_type, (uint64_t) _count));
+		}
+
+	public:
+		ParaverViewCounter(RuntimeModel &model, ParaverTrace &trace, uint64_t type, const char *description) :
+			ParaverView(model, trace),
+			_type(type),
+			_count(0)
+		{
+			_trace.addEventType(type, description);
+		}
+
+		void start(Payload &payload)
+		{
+			payload.push_back(std::make_pair(_type, (uint64_t) 0));
+		}
+	};
+
+	class ParaverViewNumberOfCreatedTasks : public ParaverViewCounter {
+	public:
+		ParaverViewNumberOfCreatedTasks(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewNumberOfBlockedTasks : public ParaverViewCounter {
+	public:
+		ParaverViewNumberOfBlockedTasks(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewNumberOfRunningTasks : public ParaverViewCounter {
+	public:
+		ParaverViewNumberOfRunningTasks(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewNumberOfCreatedThreads : public ParaverViewCounter {
+	public:
+		ParaverViewNumberOfCreatedThreads(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewNumberOfRunningThreads : public ParaverViewCounter {
+	public:
+		ParaverViewNumberOfRunningThreads(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+
+	class ParaverViewNumberOfBlockedThreads : public ParaverViewCounter {
+	private:
+		std::set<uint64_t> _blockedThreads;
+
+	public:
+		ParaverViewNumberOfBlockedThreads(RuntimeModel &model, ParaverTrace &trace);
+		void process(const Event &event, Payload &payload);
+	};
+}
+
+#endif // CTF2PRV_PARAVER_VIEWS_HPP
@@ -0,0 +1,146 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "EventKinds.hpp"
+#include "RuntimeModel.hpp"
+
+
+using namespace ctf2prv;
+
+
+void Thread::startTask(uint64_t taskId, uint64_t taskTypeId)
+{
+	// There was a task assigned to this thread already, hence we must be
+	// trying to execute an if0 task while holding another task
+	if (tasks.back().status != Task::Uninitialized)
+		tasks.push_back(Task());
+
+	Task &task = tasks.back();
+	task.id = taskId;
+	task.type = taskTypeId;
+	task.status = Task::Running;
+}
+
+void Thread::endTask()
+{
+	// If there is more than one task, we were running an if0 task.
+	// Otherwise, reuse the task object by reinitializing it
+	if (tasks.size() != 1)
+		tasks.pop_back();
+	else
+		tasks.back() = Task();
+}
+
+
+RuntimeModel::RuntimeModel(ParaverTrace &trace) :
+	_trace(trace),
+	_maxCPUId(trace.getMaxRealCPUId()),
+	_leaderThreadCPUId(trace.getLeaderThreadCPUId())
+{
+	for (uint64_t i = 0; i <= _maxCPUId; i++)
+		addCPU(false);
+
+	// Leader thread cpu
+	addCPU(true);
+}
+
+CPU &RuntimeModel::addCPU(bool isVirtual)
+{
+	CPU cpu = {_cpus.size(), isVirtual, nullptr, nullptr};
+	_cpus.push_back(cpu);
+	return _cpus.back();
+}
+
+CPU *RuntimeModel::getVirtualCPU(const Event &event)
+{
+	// Bounded threads (worker threads) cpu_id always points to the
+	// physical cpu id. All external threads have the same cpu_id since
+	// they share a stream, so we keep track of the virtual cpu of each
+	// of them by their tid. The leader thread has its own stream, and
+	// hence its cpu_id is already a valid virtual cpu id
+	const uint64_t cpuId = event.cpuId;
+	if (getWorkerType(cpuId) != ExternalThread)
+		return &_cpus[cpuId];
+
+	Thread &thread = getThread(event.getInteger(SlotUnboundedTid));
+	if (thread.vcpu == nullptr) {
+		CPU &cpu = addCPU(true);
+		cpu.externalThread = &thread;
+		thread.vcpu = &cpu;
+		_trace.increaseVirtualCPUCount();
+	}
+	return thread.vcpu;
+}
+
+Thread *RuntimeModel::getCurrentThread(const Event &event)
+{
+	CPU *cpu = getVirtualCPU(event);
+	return cpu->isVirtual ? cpu->externalThread : cpu->currentThread;
+}
+
+void RuntimeModel::preHook(const Event &event)
+{
+	switch (event.eventClass->kind) {
+		case EventTaskCreateTCEnter:
+		case EventTaskCreateOCEnter:
+		case EventTaskforInitEnter:
+			_taskTypes[event.getInteger(SlotId)] = event.getInteger(SlotType);
+			break;
+		case EventExternalThreadCreate:
+			if (getWorkerType(event.cpuId) == LeaderThread) {
+				Thread &thread = getThread(event.getInteger(SlotTid));
+				CPU &cpu = _cpus[event.cpuId];
+				cpu.externalThread = &thread;
+				thread.vcpu = &cpu;
+			}
+			break;
+		case EventThreadCreate:
+			getThread(event.getInteger(SlotTid));
+			break;
+		case EventThreadResume:
+			getVirtualCPU(event)->currentThread = &getThread(event.getInteger(SlotTid));
+			break;
+		case EventTaskStart: {
+			Thread *thread = getCurrentThread(event);
+			if (thread != nullptr) {
+				uint64_t taskId = event.getInteger(SlotId);
+				thread->startTask(taskId, _taskTypes[taskId]);
+			}
+			break;
+		}
+		case EventTaskUnblock: {
+			Thread *thread = getCurrentThread(event);
+			if (thread != nullptr)
+				thread->getTask().status = Task::Running;
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void RuntimeModel::postHook(const Event &event)
+{
+	switch (event.eventClass->kind) {
+		case EventThreadSuspend:
+			getVirtualCPU(event)->currentThread = nullptr;
+			break;
+		case EventTaskBlock: {
+			Thread *thread = getCurrentThread(event);
+			if (thread != nullptr)
+				thread->getTask().status = Task::Blocked;
+			break;
+		}
+		case EventTaskEnd: {
+			Thread *thread = getCurrentThread(event);
+			if (thread != nullptr)
+				thread->endTask();
+			break;
+		}
+		default:
+			break;
+	}
+}
@@ -0,0 +1,151 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF2PRV_RUNTIME_MODEL_HPP
+#define CTF2PRV_RUNTIME_MODEL_HPP
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "CTFStreamReader.hpp"
+#include "ParaverTrace.hpp"
+
+
+namespace ctf2prv {
+
+	struct Thread;
+
+	struct CPU {
+		uint64_t id;
+		bool isVirtual;
+
+		//! The worker thread running on a physical cpu
+		Thread *currentThread;
+
+		//! The external thread bound to a virtual cpu
+		Thread *externalThread;
+	};
+
+	struct Task {
+		enum Status {
+			Uninitialized = 0,
+			Running,
+			Blocked
+		};
+
+		uint64_t id;
+		uint64_t type;
+		Status status;
+
+		Task() :
+			id(0),
+			type(0),
+			status(Uninitialized)
+		{
+		}
+
+		bool isRunning() const
+		{
+			return status == Running;
+		}
+	};
+
+	struct Thread {
+		uint64_t tid;
+		CPU *vcpu;
+		bool isBusyWaiting;
+
+		//! Tasks being run by the thread, more than one when running if0
+		//! tasks inline
+		std::vector<Task> tasks;
+
+		//! Runtime subsystems view status stack
+		std::vector<uint64_t> eventStack;
+
+		Thread(uint64_t threadId = 0) :
+			tid(threadId),
+			vcpu(nullptr),
+			isBusyWaiting(false),
+			tasks(1)
+		{
+		}
+
+		Task &getTask()
+		{
+			return tasks.back();
+		}
+
+		void startTask(uint64_t taskId, uint64_t taskTypeId);
+
+		void endTask();
+	};
+
+	//! \brief Tracks which thread runs on each cpu and which task runs on
+	//! each thread, the same way the ctf2prv python runtime model does
+	class RuntimeModel {
+	private:
+		enum WorkerType {
+			WorkerThread = 1,
+			LeaderThread,
+			ExternalThread
+		};
+
+		ParaverTrace &_trace;
+
+		uint64_t _maxCPUId;
+		uint64_t _leaderThreadCPUId;
+
+		//! Physical cpus, the leader thread cpu and one virtual cpu per
+		//! external thread. Indexed by virtual cpu id
+		std::deque<CPU> _cpus;
+
+		std::unordered_map<uint64_t, Thread> _threads;
+		std::unordered_map<uint64_t, uint64_t> _taskTypes;
+
+		WorkerType getWorkerType(uint64_t cpuId) const
+		{
+			if (cpuId <= _maxCPUId)
+				return WorkerThread;
+			else if (cpuId == _leaderThreadCPUId)
+				return LeaderThread;
+			else
+				return ExternalThread;
+		}
+
+		CPU &addCPU(bool isVirtual);
+
+	public:
+		RuntimeModel(ParaverTrace &trace);
+
+		CPU *getVirtualCPU(const Event &event);
+
+		uint64_t getVirtualCPUId(const Event &event)
+		{
+			return getVirtualCPU(event)->id;
+		}
+
+		//! \brief Get the thread running the event, or nullptr if unknown
+		Thread *getCurrentThread(const Event &event);
+
+		Thread &getThread(uint64_t tid)
+		{
+			auto it = _threads.find(tid);
+			if (it == _threads.end())
+				it = _threads.emplace(tid, Thread(tid)).first;
+			return it->second;
+		}
+
+		//! \brief Update the model before the views process the event
+		void preHook(const Event &event);
+
+		//! \brief Update the model after the views process the event
+		void postHook(const Event &event);
+	};
+}
+
+#endif // CTF2PRV_RUNTIME_MODEL_HPP
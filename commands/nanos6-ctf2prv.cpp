@@ -0,0 +1,322 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <exception>
+#include <ftw.h>
+#include <glob.h>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ctf2prv/CTFMetadata.hpp"
+#include "ctf2prv/CTFStreamReader.hpp"
+#include "ctf2prv/EventKinds.hpp"
+#include "ctf2prv/ParaverTrace.hpp"
+#include "ctf2prv/ParaverViews.hpp"
+#include "ctf2prv/RuntimeModel.hpp"
+
+
+using namespace ctf2prv;
+
+
+static volatile sig_atomic_t _mustExit = 0;
+
+static void exitHandler(int)
+{
+	_mustExit = 1;
+}
+
+static void usage(const char *program)
+{
+	std::cerr << "usage: " << program << " <ctf_trace_directory>" << std::endl;
+}
+
+static bool fileExists(const std::string &path)
+{
+	struct stat st;
+	return stat(path.c_str(), &st) == 0;
+}
+
+static std::string findUserTrace(const std::string &tracePath)
+{
+	glob_t result;
+	std::string pattern = tracePath + "/ctf/ust/uid/*/64-bit/metadata";
+	std::string userTracePath;
+
+	if (glob(pattern.c_str(), 0, nullptr, &result) == 0) {
+		if (result.gl_pathc > 0) {
+			userTracePath = result.gl_pathv[0];
+			userTracePath = userTracePath.substr(0, userTracePath.size() - strlen("/metadata"));
+		}
+	}
+	globfree(&result);
+
+	return userTracePath;
+}
+
+static std::vector<std::string> findStreams(const std::string &userTracePath)
+{
+	std::vector<std::string> streams;
+
+	DIR *dir = opendir(userTracePath.c_str());
+	if (dir == nullptr)
+		throw std::runtime_error("cannot open " + userTracePath + ": " + strerror(errno));
+
+	struct dirent *entry;
+	while ((entry = readdir(dir)) != nullptr) {
+		std::string name = entry->d_name;
+		if (name[0] == '.' || name == "metadata")
+			continue;
+
+		std::string path = userTracePath + "/" + name;
+		struct stat st;
+		if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+			streams.push_back(path);
+	}
+	closedir(dir);
+
+	std::sort(streams.begin(), streams.end());
+	return streams;
+}
+
+static int removeEntry(const char *path, const struct stat *, int, struct FTW *)
+{
+	return remove(path);
+}
+
+static void createOutputDirectory(const std::string &path)
+{
+	if (fileExists(path) && nftw(path.c_str(), removeEntry, 64, FTW_DEPTH | FTW_PHYS) != 0)
+		throw std::runtime_error("cannot remove " + path + ": " + strerror(errno));
+
+	if (mkdir(path.c_str(), 0755) != 0)
+		throw std::runtime_error("cannot create " + path + ": " + strerror(errno));
+}
+
+//! \brief Index all the streams, each of them by a single thread
+static void indexStreams(std::vector<std::unique_ptr<CTFStreamReader>> &readers)
+{
+	std::atomic<size_t> next(0);
+	std::exception_ptr error;
+	std::atomic<bool> failed(false);
+
+	auto worker = [&]() {
+		size_t i;
+		while (!failed && (i = next++) < readers.size()) {
+			try {
+				readers[i]->index();
+			} catch (...) {
+				if (!failed.exchange(true))
+					error = std::current_exception();
+			}
+		}
+	};
+
+	size_t numThreads = std::max(1U, std::thread::hardware_concurrency());
+	numThreads = std::min(numThreads, readers.size());
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < numThreads; i++)
+		threads.emplace_back(worker);
+	worker();
+
+	for (std::thread &thread : threads)
+		thread.join();
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+static int convert(const std::string &tracePath)
+{
+	std::string userTracePath = findUserTrace(tracePath);
+	if (userTracePath.empty()) {
+		std::cerr << "Error: The supplied input does not appear to be a CTF trace" << std::endl;
+		return 1;
+	}
+
+	if (fileExists(tracePath + "/ctf/kernel/metadata")) {
+		std::cerr << "Warning: the Linux kernel events are not converted by this tool, "
+			<< "use the ctf2prv python converter to obtain the kernel views" << std::endl;
+	}
+
+	const char *verboseValue = getenv("CTF2PRV_VERBOSE");
+	const bool verbose = (verboseValue != nullptr && std::string(verboseValue) == "1");
+	if (verbose)
+		std::cout << "Starting CTF to PRV conversion" << std::endl;
+
+	const char *timeoutValue = getenv("CTF2PRV_TIMEOUT");
+	const long timeout = (timeoutValue != nullptr) ? atol(timeoutValue) : 0;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(timeout);
+
+	CTFMetadata metadata;
+	metadata.load(userTracePath + "/metadata");
+	for (auto &entry : metadata.getEvents())
+		prepareEventClass(entry.second);
+
+	// Map and index all streams in parallel
+	std::vector<std::unique_ptr<CTFStreamReader>> readers;
+	for (const std::string &path : findStreams(userTracePath)) {
+		readers.emplace_back(new CTFStreamReader(path, metadata));
+		readers.back()->open();
+	}
+	indexStreams(readers);
+
+	for (auto &reader : readers) {
+		if (reader->getTruncatedBytes() > 0) {
+			std::cerr << "Warning: ignoring " << reader->getTruncatedBytes()
+				<< " bytes of incomplete events at the end of " << reader->getPath() << std::endl;
+		}
+	}
+
+	// Merge the streams by timestamp with a min-heap holding the next
+	// event of each of them. Ties are broken by stream order
+	typedef std::pair<uint64_t, size_t> HeapEntry;
+	std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+	for (size_t i = 0; i < readers.size(); i++) {
+		if (readers[i]->hasNext())
+			heap.push(std::make_pair(readers[i]->getNextTimestamp(), i));
+	}
+
+	if (heap.empty()) {
+		std::cerr << "Error: The supplied trace does not contain any event" << std::endl;
+		return 1;
+	}
+
+	// Initial events are emitted one nanosecond before the first event
+	// to avoid overlapping with the events derived from it
+	const uint64_t startTime = heap.top().first - 1;
+	const std::string traceName = "trace_"
+		+ metadata.getEnvironment("binary_name") + "_"
+		+ metadata.getEnvironment("pid");
+
+	std::string outputPath = tracePath + "/prv";
+	createOutputDirectory(outputPath);
+
+	ParaverTrace trace;
+	trace.initialize(
+		outputPath + "/" + traceName,
+		metadata.getClockOffset() / 1000000000ULL,
+		startTime,
+		metadata.getEnvironment("cpu_list")
+	);
+
+	RuntimeModel model(trace);
+
+	std::vector<std::unique_ptr<ParaverView>> views;
+	views.emplace_back(new ParaverViewRuntimeCode(model, trace));
+	views.emplace_back(new ParaverViewRuntimeBusyWaiting(model, trace));
+	views.emplace_back(new ParaverViewRuntimeTasks(model, trace));
+	views.emplace_back(new ParaverViewRunningTask(model, trace, ParaverViewRunningTask::Label));
+	views.emplace_back(new ParaverViewRunningTask(model, trace, ParaverViewRunningTask::Source));
+	views.emplace_back(new ParaverViewRunningTask(model, trace, ParaverViewRunningTask::Id));
+	views.emplace_back(new ParaverViewHardwareCounters(model, trace));
+	views.emplace_back(new ParaverViewThreadId(model, trace));
+	views.emplace_back(new ParaverViewRuntimeSubsystems(model, trace));
+	views.emplace_back(new ParaverViewCTFFlush(model, trace));
+	views.emplace_back(new ParaverViewNumberOfCreatedTasks(model, trace));
+	views.emplace_back(new ParaverViewNumberOfBlockedTasks(model, trace));
+	views.emplace_back(new ParaverViewNumberOfRunningTasks(model, trace));
+	views.emplace_back(new ParaverViewNumberOfCreatedThreads(model, trace));
+	views.emplace_back(new ParaverViewNumberOfRunningThreads(model, trace));
+	views.emplace_back(new ParaverViewNumberOfBlockedThreads(model, trace));
+
+	Payload payload;
+	for (auto &view : views)
+		view->start(payload);
+	trace.emitEvent(startTime, 0, payload);
+	payload.clear();
+
+	signal(SIGINT, exitHandler);
+	signal(SIGTERM, exitHandler);
+
+	Event event;
+	uint64_t lastTimestamp = startTime;
+	size_t processed = 0;
+	bool aborted = false;
+
+	while (!heap.empty()) {
+		if (_mustExit || (timeout > 0 && (processed % 65536) == 0
+			&& std::chrono::steady_clock::now() > deadline)
+		) {
+			aborted = true;
+			break;
+		}
+
+		const size_t stream = heap.top().second;
+		heap.pop();
+
+		CTFStreamReader &reader = *readers[stream];
+		reader.next(event);
+		if (reader.hasNext())
+			heap.push(std::make_pair(reader.getNextTimestamp(), stream));
+
+		if (verbose) {
+			std::cout << "event " << event.eventClass->name << ", cpu_id " << event.cpuId
+				<< ", timestamp " << event.timestamp << "\n";
+		}
+
+		if (event.eventClass->kind != EventUnknown) {
+			model.preHook(event);
+			for (auto &view : views)
+				view->process(event, payload);
+			model.postHook(event);
+
+			if (!payload.empty()) {
+				trace.emitEvent(event.timestamp, model.getVirtualCPUId(event), payload);
+				payload.clear();
+			}
+		}
+
+		lastTimestamp = event.timestamp;
+		processed++;
+	}
+
+	trace.finalize(lastTimestamp);
+
+	if (aborted) {
+		std::cout << "Conversion aborted successfully, trace might be incomplete but valid" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	// Accept being called as "<converter> ctf2prv <trace>", which is how
+	// Nanos6 invokes the instrument.ctf.converter.location command
+	int first = 1;
+	if (argc == 3 && std::string(argv[1]) == "ctf2prv")
+		first = 2;
+
+	if (argc - first != 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	try {
+		return convert(argv[first]);
+	} catch (const std::exception &exception) {
+		std::cerr << "Error: " << exception.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,428 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "config-cache.h"
+#include "config-parser.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+#define CONFIG_CACHE_MAGIC "NANOS6CC"
+#define CONFIG_CACHE_VERSION 1
+
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t num_entries;
+	uint64_t data_size;
+	int64_t mtime_sec;
+	int64_t mtime_nsec;
+	uint64_t file_size;
+	uint64_t file_hash;
+	char config_path[MAX_CONFIG_PATH];
+} _nanos6_config_cache_header_t;
+
+typedef struct {
+	char *data;
+	size_t size;
+	size_t capacity;
+} _nanos6_config_cache_buffer_t;
+
+// Entries of the mapped cache, read by the runtime
+const char *_nanos6_config_cache_entries = NULL;
+size_t _nanos6_config_cache_num_entries = 0;
+
+// Path of the cache file or NULL if the cache is disabled
+static const char *_cache_path = NULL;
+
+// Key of the current config file, which is written in the header of the cache
+static _nanos6_config_cache_header_t _key;
+static int _key_valid = 0;
+
+static void *_mapping = NULL;
+static size_t _mapping_size = 0;
+
+
+static uint64_t _nanos6_config_cache_hash(const char *contents, size_t size)
+{
+	// 64-bit FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= (unsigned char) contents[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static inline int _is_scalar_kind(char kind)
+{
+	return (kind == 'b' || kind == 'i' || kind == 'f' || kind == 's');
+}
+
+static inline const char *_skip_string(const char *current, const char *end)
+{
+	if (current >= end)
+		return NULL;
+
+	const char *terminator = memchr(current, '\0', end - current);
+	return (terminator != NULL) ? terminator + 1 : NULL;
+}
+
+// Check that the entries are well-formed, so that they can be traversed without further checks
+static int _nanos6_config_cache_check_entries(const char *data, size_t size, uint32_t num_entries)
+{
+	const char *current = data;
+	const char *end = data + size;
+
+	for (uint32_t e = 0; e < num_entries; ++e) {
+		if (current >= end)
+			return -1;
+
+		char kind = *current;
+		current = _skip_string(current + 1, end);
+		if (current == NULL)
+			return -1;
+
+		if (_is_scalar_kind(kind)) {
+			current = _skip_string(current, end);
+			if (current == NULL)
+				return -1;
+		} else if (kind == 'a') {
+			const char *count = current;
+			current = _skip_string(current, end);
+			if (current == NULL)
+				return -1;
+
+			char *count_end;
+			unsigned long nelems = strtoul(count, &count_end, 10);
+			if (*count == '\0' || *count_end != '\0')
+				return -1;
+
+			for (unsigned long i = 0; i < nelems; ++i) {
+				if (current >= end || !_is_scalar_kind(*current))
+					return -1;
+
+				current = _skip_string(current + 1, end);
+				if (current == NULL)
+					return -1;
+			}
+		} else {
+			return -1;
+		}
+	}
+
+	return (current == end) ? 0 : -1;
+}
+
+int _nanos6_config_cache_load(const char *config_path, const char *contents, size_t size, const struct stat *st)
+{
+	_cache_path = getenv("NANOS6_CONFIG_CACHE");
+	if (_cache_path == NULL || strlen(_cache_path) == 0) {
+		_cache_path = NULL;
+		return -1;
+	}
+
+	// Compute the key of the current config file
+	memset(&_key, 0, sizeof(_key));
+	memcpy(_key.magic, CONFIG_CACHE_MAGIC, sizeof(_key.magic));
+	_key.version = CONFIG_CACHE_VERSION;
+	_key.mtime_sec = st->st_mtim.tv_sec;
+	_key.mtime_nsec = st->st_mtim.tv_nsec;
+	_key.file_size = size;
+	_key.file_hash = _nanos6_config_cache_hash(contents, size);
+	strncpy(_key.config_path, config_path, MAX_CONFIG_PATH - 1);
+	_key_valid = 1;
+
+	int fd = open(_cache_path, O_RDONLY);
+	if (fd < 0) {
+		// There is no cache yet
+		return -1;
+	}
+
+	struct stat cache_st;
+	if (fstat(fd, &cache_st) || (size_t) cache_st.st_size < sizeof(_nanos6_config_cache_header_t)) {
+		close(fd);
+		return -1;
+	}
+
+	size_t mapping_size = cache_st.st_size;
+	void *mapping = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return -1;
+
+	const _nanos6_config_cache_header_t *header = (const _nanos6_config_cache_header_t *) mapping;
+	const char *data = (const char *) mapping + sizeof(_nanos6_config_cache_header_t);
+
+	int valid = (memcmp(header->magic, _key.magic, sizeof(_key.magic)) == 0)
+		&& header->version == _key.version
+		&& header->mtime_sec == _key.mtime_sec
+		&& header->mtime_nsec == _key.mtime_nsec
+		&& header->file_size == _key.file_size
+		&& header->file_hash == _key.file_hash
+		&& strncmp(header->config_path, _key.config_path, MAX_CONFIG_PATH) == 0
+		&& header->data_size == mapping_size - sizeof(_nanos6_config_cache_header_t)
+		&& _nanos6_config_cache_check_entries(data, header->data_size, header->num_entries) == 0;
+
+	if (!valid) {
+		// Stale or corrupted cache; it will be rewritten
+		munmap(mapping, mapping_size);
+		return -1;
+	}
+
+	_mapping = mapping;
+	_mapping_size = mapping_size;
+	_nanos6_config_cache_entries = data;
+	_nanos6_config_cache_num_entries = header->num_entries;
+
+	return 0;
+}
+
+int _nanos6_config_cache_foreach(int (*function)(const char *name, const char *value))
+{
+	const char *current = _nanos6_config_cache_entries;
+	if (current == NULL)
+		return 0;
+
+	for (size_t e = 0; e < _nanos6_config_cache_num_entries; ++e) {
+		char kind = *current;
+		const char *name = current + 1;
+		current = name + strlen(name) + 1;
+
+		if (kind == 'a') {
+			unsigned long nelems = strtoul(current, NULL, 10);
+			current += strlen(current) + 1;
+
+			for (unsigned long i = 0; i < nelems; ++i) {
+				current += strlen(current) + 1;
+			}
+		} else {
+			const char *value = current;
+			current += strlen(current) + 1;
+
+			int ret = function(name, value);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int _nanos6_config_cache_append(_nanos6_config_cache_buffer_t *buffer, const char *string, size_t length)
+{
+	if (buffer->size + length > buffer->capacity) {
+		size_t capacity = (buffer->capacity) ? buffer->capacity : 4096;
+		while (buffer->size + length > capacity)
+			capacity *= 2;
+
+		char *data = realloc(buffer->data, capacity);
+		if (data == NULL)
+			return -1;
+
+		buffer->data = data;
+		buffer->capacity = capacity;
+	}
+
+	memcpy(buffer->data + buffer->size, string, length);
+	buffer->size += length;
+	return 0;
+}
+
+static inline int _nanos6_config_cache_append_string(_nanos6_config_cache_buffer_t *buffer, const char *string)
+{
+	// Append the string including the null character
+	return _nanos6_config_cache_append(buffer, string, strlen(string) + 1);
+}
+
+// Get the kind and the textual value of a raw TOML value
+static int _nanos6_config_cache_convert(toml_raw_t raw, char *kind, char **value)
+{
+	int boolean;
+	int64_t integer;
+	double floating;
+	char number[64];
+
+	*value = NULL;
+	if (raw[0] == '"' || raw[0] == '\'') {
+		*kind = 's';
+		return toml_rtos(raw, value) ? -1 : 0;
+	} else if (!toml_rtob(raw, &boolean)) {
+		*kind = 'b';
+		*value = strdup(boolean ? "true" : "false");
+	} else if (!toml_rtoi(raw, &integer)) {
+		*kind = 'i';
+		snprintf(number, sizeof(number), "%" PRId64, integer);
+		*value = strdup(number);
+	} else if (!toml_rtod(raw, &floating)) {
+		*kind = 'f';
+		snprintf(number, sizeof(number), "%.17g", floating);
+		*value = strdup(number);
+	} else {
+		// Timestamps are not cached
+		return -1;
+	}
+
+	return (*value != NULL) ? 0 : -1;
+}
+
+static int _nanos6_config_cache_append_value(_nanos6_config_cache_buffer_t *buffer, toml_raw_t raw, const char *name)
+{
+	char kind;
+	char *value;
+
+	if (_nanos6_config_cache_convert(raw, &kind, &value))
+		return -1;
+
+	int ret = _nanos6_config_cache_append(buffer, &kind, 1);
+	if (!ret && name != NULL)
+		ret = _nanos6_config_cache_append_string(buffer, name);
+	if (!ret)
+		ret = _nanos6_config_cache_append_string(buffer, value);
+
+	free(value);
+	return ret;
+}
+
+// Recursively flatten the options of a table into the buffer
+static int _nanos6_config_cache_append_table(
+	_nanos6_config_cache_buffer_t *buffer, toml_table_t *table,
+	const char *prefix, uint32_t *num_entries
+) {
+	const char *key;
+	for (int k = 0; (key = toml_key_in(table, k)) != NULL; ++k) {
+		char *name = malloc(strlen(prefix) + strlen(key) + 2);
+		if (name == NULL)
+			return -1;
+
+		// The first key should not be preceeded by a dot
+		sprintf(name, (prefix[0] != '\0') ? "%s.%s" : "%s%s", prefix, key);
+
+		int ret = 0;
+		toml_raw_t raw = toml_raw_in(table, key);
+		toml_array_t *array = toml_array_in(table, key);
+		toml_table_t *subtable = toml_table_in(table, key);
+
+		if (raw != NULL) {
+			ret = _nanos6_config_cache_append_value(buffer, raw, name);
+			++(*num_entries);
+		} else if (array != NULL) {
+			int nelems = toml_array_nelem(array);
+			char count[16];
+			snprintf(count, sizeof(count), "%d", nelems);
+
+			// Only arrays of scalar values are cached
+			if (nelems > 0 && toml_array_kind(array) != 'v')
+				ret = -1;
+			if (!ret)
+				ret = _nanos6_config_cache_append(buffer, "a", 1);
+			if (!ret)
+				ret = _nanos6_config_cache_append_string(buffer, name);
+			if (!ret)
+				ret = _nanos6_config_cache_append_string(buffer, count);
+
+			for (int i = 0; !ret && i < nelems; ++i) {
+				ret = _nanos6_config_cache_append_value(buffer, toml_raw_at(array, i), NULL);
+			}
+			++(*num_entries);
+		} else if (subtable != NULL) {
+			ret = _nanos6_config_cache_append_table(buffer, subtable, name, num_entries);
+		}
+
+		free(name);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int _nanos6_config_cache_write(int fd, const void *data, size_t size)
+{
+	const char *current = (const char *) data;
+	while (size > 0) {
+		ssize_t written = write(fd, current, size);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		current += written;
+		size -= written;
+	}
+	return 0;
+}
+
+void _nanos6_config_cache_store(toml_table_t *conf)
+{
+	if (_cache_path == NULL || !_key_valid)
+		return;
+
+	_nanos6_config_cache_buffer_t buffer = { NULL, 0, 0 };
+	uint32_t num_entries = 0;
+
+	if (_nanos6_config_cache_append_table(&buffer, conf, "", &num_entries)) {
+		if (_config.verbose)
+			fprintf(stderr, "Nanos6 loader could not cache the configuration file: unsupported options\n");
+		free(buffer.data);
+		return;
+	}
+
+	_nanos6_config_cache_header_t header = _key;
+	header.num_entries = num_entries;
+	header.data_size = buffer.size;
+
+	// Write a temporary file and rename it, so that concurrent executions
+	// never see a partially written cache
+	char temporary_path[MAX_CONFIG_PATH];
+	int cnt = snprintf(temporary_path, MAX_CONFIG_PATH, "%s.%d", _cache_path, (int) getpid());
+	if (cnt >= MAX_CONFIG_PATH) {
+		free(buffer.data);
+		return;
+	}
+
+	int fd = open(temporary_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		if (_config.verbose)
+			fprintf(stderr, "Nanos6 loader could not write the configuration cache %s: %s\n", _cache_path, strerror(errno));
+		free(buffer.data);
+		return;
+	}
+
+	int failed = _nanos6_config_cache_write(fd, &header, sizeof(header));
+	if (!failed && buffer.size > 0)
+		failed = _nanos6_config_cache_write(fd, buffer.data, buffer.size);
+	failed |= close(fd);
+	free(buffer.data);
+
+	if (failed || rename(temporary_path, _cache_path)) {
+		if (_config.verbose)
+			fprintf(stderr, "Nanos6 loader could not write the configuration cache %s: %s\n", _cache_path, strerror(errno));
+		unlink(temporary_path);
+	}
+}
+
+void _nanos6_config_cache_free(void)
+{
+	if (_mapping != NULL) {
+		munmap(_mapping, _mapping_size);
+		_mapping = NULL;
+		_mapping_size = 0;
+	}
+
+	_nanos6_config_cache_entries = NULL;
+	_nanos6_config_cache_num_entries = 0;
+}
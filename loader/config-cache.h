@@ -0,0 +1,73 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef NANOS6_LOADER_CONFIG_CACHE_H
+#define NANOS6_LOADER_CONFIG_CACHE_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stddef.h>
+#include <sys/stat.h>
+
+#include "support/toml/toml.h"
+
+
+// The configuration cache stores the options of a config file already
+// flattened and converted, so that warm starts do not have to parse the file.
+// The cache is only used when the NANOS6_CONFIG_CACHE environment variable
+// points to the cache file. The cache is rejected and rewritten whenever the
+// path, the modification time, the size or the hash of the config file differ
+// from the ones stored in the cache.
+//
+// The runtime reads the entries of the cache mapped by the loader through the
+// _nanos6_config_cache_entries and _nanos6_config_cache_num_entries symbols.
+// Each entry is a sequence of null-terminated strings:
+//
+//   entry  := kind name '\0' body
+//   kind   := 'b' (boolean) | 'i' (integer) | 'f' (floating) | 's' (string) | 'a' (array)
+//   body   := value '\0'                               (scalar kinds)
+//           | count '\0' { kind value '\0' }*count     (arrays of scalars)
+//
+// The names contain the full dotted path of the option, and the values are in
+// their textual representation (e.g., "true", "42", "0.5" or the unescaped
+// contents of the string).
+
+//! \brief Try to use the config cache for the given config file
+//!
+//! \param config_path The path of the config file
+//! \param contents The contents of the config file
+//! \param size The size of the config file
+//! \param st The status of the config file
+//!
+//! \returns 0 if there is a valid cache for the config file, which is then
+//! mapped in memory, or -1 otherwise
+__attribute__((visibility("hidden"))) int _nanos6_config_cache_load(
+	const char *config_path, const char *contents, size_t size, const struct stat *st);
+
+//! \brief Write the cache of a config file already parsed
+//!
+//! This function does nothing if the cache is not enabled or the file has
+//! options that cannot be cached. Failures are not fatal, the next execution
+//! will simply parse the config file again
+//!
+//! \param conf The root table of the config file
+__attribute__((visibility("hidden"))) void _nanos6_config_cache_store(toml_table_t *conf);
+
+//! \brief Call a function for each scalar option of the mapped cache
+//!
+//! \param function The function to call with the name and value of each option
+//!
+//! \returns 0 on success, or the first non-zero value returned by the function
+__attribute__((visibility("hidden"))) int _nanos6_config_cache_foreach(
+	int (*function)(const char *name, const char *value));
+
+//! \brief Unmap the cache and release its resources
+__attribute__((visibility("hidden"))) void _nanos6_config_cache_free(void);
+
+
+#endif // NANOS6_LOADER_CONFIG_CACHE_H
@@ -4,6 +4,7 @@
 	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include "config-cache.h"
 #include "config-parser.h"
 #include "loader.h"
 #include "support/toml/toml.h"
@@ -14,6 +15,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #ifndef INSTALLED_CONFIG_DIR
@@ -35,6 +37,7 @@ static void _nanos6_init_config(void)
 	_config.library_path = NULL;
 	_config.report_prefix = NULL;
 	_config.debug = 0;
+	_config.lean = 0;
 	_config.verbose = 0;
 	_config.warn_envars = 1;
 }
@@ -49,6 +52,8 @@ void _nanos6_loader_free_config(void)
 		free(_config.library_path);
 	if (_config.report_prefix)
 		free(_config.report_prefix);
+
+	_nanos6_config_cache_free();
 }
 
 // The following rules are followed to find the config file:
@@ -175,6 +180,8 @@ static int _nanos6_parse_config_tables(toml_table_t *loader_section, toml_table_
 			return -1;
 		if (_toml_try_extract_bool(version_section, &_config.debug, "debug"))
 			return -1;
+		if (_toml_try_extract_bool(version_section, &_config.lean, "lean"))
+			return -1;
 	}
 
 	return 0;
@@ -210,6 +217,15 @@ static int _nanos6_config_parse_individual_override(const char *name, const char
 			fprintf(stderr, "Error: Bad value for %s override\n", name);
 			return -1;
 		}
+	} else if (strcmp(name, "version.lean") == 0) {
+		if (strcmp(value, "true") == 0) {
+			_config.lean = 1;
+		} else if (strcmp(value, "false") == 0) {
+			_config.lean = 0;
+		} else {
+			fprintf(stderr, "Error: Bad value for %s override\n", name);
+			return -1;
+		}
 	} else if (strcmp(name, "loader.verbose") == 0) {
 		if (strcmp(value, "true") == 0) {
 			_config.verbose = 1;
@@ -270,9 +286,9 @@ static void _nanos6_loader_check_envars(void)
 	const char *prefix = "NANOS6";
 	const int plen = strlen(prefix);
 
-	const int nsuffixes = 3;
-	const char *suffix[3] = { "_CONFIG=", "_CONFIG_OVERRIDE=", "_HOME=" };
-	int suffixlen[3];
+	const int nsuffixes = 4;
+	const char *suffix[4] = { "_CONFIG=", "_CONFIG_CACHE=", "_CONFIG_OVERRIDE=", "_HOME=" };
+	int suffixlen[4];
 
 	for (int s = 0; s < nsuffixes; ++s) {
 		suffixlen[s] = strlen(suffix[s]);
@@ -328,9 +344,45 @@ static void _nanos6_loader_check_envars(void)
     }
 }
 
+// Read the contents of the config file, which are returned null-terminated
+static int _nanos6_read_config(char **contents, size_t *size, struct stat *st)
+{
+	FILE *f = fopen(_nanos6_config_path, "r");
+	if (f == NULL) {
+		fprintf(stderr, "Error: Failed to open config file for reading: %s\n", strerror(errno));
+		return -1;
+	}
+
+	if (fstat(fileno(f), st)) {
+		fprintf(stderr, "Error: Failed to get the status of the config file: %s\n", strerror(errno));
+		fclose(f);
+		return -1;
+	}
+
+	*size = st->st_size;
+	*contents = malloc(*size + 1);
+	if (*contents == NULL) {
+		fprintf(stderr, "Error: Failed to allocate memory for the config file\n");
+		fclose(f);
+		return -1;
+	}
+
+	if (fread(*contents, 1, *size, f) != *size) {
+		fprintf(stderr, "Error: Failed to read the config file\n");
+		free(*contents);
+		fclose(f);
+		return -1;
+	}
+	(*contents)[*size] = '\0';
+
+	fclose(f);
+	return 0;
+}
+
 // Find and parse the Nanos6 configuration file
 // The file used (path) is shared with the runtime. However, the runtime will parse independently the file
 // This is because we don't know here which are the expected data types of each variable
+// When the config cache is enabled, both the loader and the runtime use the cached options instead
 // Additionally, every config option used by the loader is included in the [loader] section
 int _nanos6_loader_parse_config(void)
 {
@@ -342,34 +394,49 @@ int _nanos6_loader_parse_config(void)
 		return -1;
 	}
 
-	// Open found config file for reading
-	FILE *f = fopen(_nanos6_config_path, "r");
-	if (f == NULL) {
-		fprintf(stderr, "Error: Failed to open config file for reading: %s\n", strerror(errno));
+	// Read the whole config file, which is needed to validate the config cache
+	char *contents;
+	size_t size;
+	struct stat st;
+	if (_nanos6_read_config(&contents, &size, &st)) {
 		return -1;
 	}
 
-	// Parse the file
-	toml_table_t *conf = toml_parse_file(f, errbuf, sizeof(errbuf));
-	fclose(f);
-
-	if (conf == NULL) {
-		fprintf(stderr, "Error: Failed to parse config file: %s\n", errbuf);
-		return -1;
-	}
+	if (_nanos6_config_cache_load(_nanos6_config_path, contents, size, &st) == 0) {
+		free(contents);
 
-	// Find the [loader] section in the file
-	toml_table_t *loader_section = toml_table_in(conf, "loader");
-	toml_table_t *version_section = toml_table_in(conf, "version");
-	if (loader_section || version_section) {
-		if (_nanos6_parse_config_tables(loader_section, version_section)) {
+		// The cache is valid; take the loader options from the cached entries
+		// without parsing the file
+		if (_nanos6_config_cache_foreach(_nanos6_config_parse_individual_override)) {
 			_nanos6_loader_free_config();
-			toml_free(conf);
 			return -1;
 		}
-	}
+	} else {
+		// Parse the file
+		toml_table_t *conf = toml_parse(contents, errbuf, sizeof(errbuf));
+		free(contents);
+
+		if (conf == NULL) {
+			fprintf(stderr, "Error: Failed to parse config file: %s\n", errbuf);
+			return -1;
+		}
 
-	toml_free(conf);
+		// Find the [loader] section in the file
+		toml_table_t *loader_section = toml_table_in(conf, "loader");
+		toml_table_t *version_section = toml_table_in(conf, "version");
+		if (loader_section || version_section) {
+			if (_nanos6_parse_config_tables(loader_section, version_section)) {
+				_nanos6_loader_free_config();
+				toml_free(conf);
+				return -1;
+			}
+		}
+
+		// Cache the parsed options for the next executions, if enabled
+		_nanos6_config_cache_store(conf);
+
+		toml_free(conf);
+	}
 
 	// Now parse the configuration overrides
 	if (_nanos6_config_parse_override()) {
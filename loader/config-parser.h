@@ -24,6 +24,7 @@ typedef struct {
 	char *library_path;
 	char *report_prefix;
 	int debug;
+	int lean;
 	int verbose;
 	int warn_envars;
 } _nanos6_loader_config_t;
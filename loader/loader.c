@@ -175,10 +175,12 @@ static int _nanos6_loader_impl(void)
 #endif
 
 	_Bool debug = _config.debug;
+	_Bool lean = _config.lean;
 	_Bool verbose = _config.verbose;
 
-	// Check the optimization variant to load
-	char const *optimization = (debug) ? "debug" : "optimized";
+	// Check the optimization variant to load. The debug variant takes
+	// precedence over the lean one
+	char const *optimization = (debug) ? "debug" : ((lean) ? "lean" : "optimized");
 
 	// Check the instrumentation variant to load
 	char const *instrument = _config.instrument;
@@ -192,6 +194,12 @@ static int _nanos6_loader_impl(void)
 		dependencies = default_dependencies;
 	}
 
+	if (!debug && lean && strcmp(instrument, "none")) {
+		fprintf(stderr, "The lean runtime variant cannot be combined with '%s' instrumentation.\n", instrument);
+		fprintf(stderr, "Please disable the version.lean configuration option or set version.instrument to none.\n");
+		return -1;
+	}
+
 	if (verbose) {
 		fprintf(stderr, "Nanos6 loader using '%s' variant with '%s' dependencies and '%s' instrumentation.\n", optimization, dependencies, instrument);
 	}
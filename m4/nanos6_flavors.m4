@@ -166,3 +166,28 @@ AC_DEFUN([SELECT_NANOS6_INSTRUMENTATIONS],
 	]
 )
 
+AC_DEFUN([SELECT_NANOS6_LEAN_VARIANT],
+	[
+		AC_MSG_CHECKING([whether to build the lean variant])
+		AC_ARG_ENABLE(
+			[lean-variant],
+			[AS_HELP_STRING([--enable-lean-variant], [build the lean variant, which strips monitoring, hardware counters, the throttle and cluster support from the hot paths])],
+			[
+				case "${enableval}" in
+				yes)
+					ac_build_lean_variant=yes
+					;;
+				no)
+					ac_build_lean_variant=no
+					;;
+				*)
+					AC_MSG_ERROR([bad value ${enableval} for --enable-lean-variant])
+					;;
+				esac
+			],
+			[ac_build_lean_variant=no]
+		)
+		AC_MSG_RESULT([$ac_build_lean_variant])
+		AM_CONDITIONAL(BUILD_LEAN_VARIANT, test x"${ac_build_lean_variant}" = x"yes")
+	]
+)
@@ -14,6 +14,7 @@
 #include "messenger/Messenger.hpp"
 #include "polling-services/ClusterServicesPolling.hpp"
 #include "polling-services/ClusterServicesTask.hpp"
+#include "polling-services/FetchAggregator.hpp"
 #include "polling-services/HybridPolling.hpp"
 #include "system/RuntimeInfo.hpp"
 #include "ClusterStats.hpp"
@@ -103,6 +104,21 @@ ClusterManager::ClusterManager(std::string const &commType, int argc, char **arg
 	ConfigVariable<bool> mergeReleaseAndFinish("cluster.merge_release_and_finish");
 	_mergeReleaseAndFinish = mergeReleaseAndFinish.getValue();
 
+	ConfigVariable<size_t> taskNewBatchSize("cluster.task_new_batch_size");
+	_taskNewBatchSize = taskNewBatchSize.getValue();
+
+	ConfigVariable<bool> prefetch("cluster.prefetch");
+	_prefetch = prefetch.getValue();
+
+	ConfigVariable<StringifiedMemorySize> prefetchBudget("cluster.prefetch_budget");
+	_prefetchBudget = prefetchBudget.getValue();
+
+	ConfigVariable<bool> sharedFetch("cluster.shared_fetch");
+	_sharedFetch = sharedFetch.getValue();
+
+	ConfigVariable<size_t> sharedFetchThreshold("cluster.shared_fetch_threshold");
+	_sharedFetchThreshold = sharedFetchThreshold.getValue();
+
 	ConfigVariable<int> numMessageHandlerWorkers("cluster.num_message_handler_workers");
 	_numMessageHandlerWorkers = numMessageHandlerWorkers.getValue();
 }
@@ -191,6 +207,9 @@ void ClusterManager::initialize(int argc, char **argv)
 	 * cluster.communication config variable we will not
 	 * initialize the cluster support of Nanos6 */
 	if (commType.getValue() != "disabled") {
+		FatalErrorHandler::failIf(!CompiledFeatures::cluster,
+			"Cluster mode is not available in this runtime variant");
+
 		assert(argc > 0);
 		assert(argv != nullptr);
 		_singleton = new ClusterManager(commType.getValue(), argc, argv);
@@ -356,35 +375,50 @@ void ClusterManager::fetchVector(
 	assert(from->getType() == nanos6_cluster_device);
 	assert((size_t)from->getIndex() < _singleton->_clusterNodes.size());
 
-	ClusterNode const *remoteNode = getClusterNode(from->getIndex());
+	// The fetches are requested later, together with the ones of other
+	// tasks from the same node
+	if (ClusterPollingServices::FetchAggregator::isEnabled()) {
+		ClusterPollingServices::FetchAggregator::addFetches(copySteps, from);
+		return;
+	}
 
-	assert(remoteNode != _singleton->_thisNode);
+	std::vector<ExecutionWorkflow::FragmentInfo> fragments;
+	fragments.reserve(nFragments);
 
-	//! At the moment we do not translate addresses on remote
-	//! nodes, so the region we are fetching, on the remote node is
-	//! the same as the local one
-	MessageDataFetch *msg = new MessageDataFetch(_singleton->_thisNode, nFragments, copySteps);
+	for (ExecutionWorkflow::ClusterDataCopyStep const *step : copySteps) {
+		const std::vector<ExecutionWorkflow::FragmentInfo> &stepFragments = step->getFragments();
+		fragments.insert(fragments.end(), stepFragments.begin(), stepFragments.end());
+	}
 
-	__attribute__((unused)) MessageDataFetch::DataFetchMessageContent *content = msg->getContent();
+	assert(fragments.size() == nFragments);
 
-	size_t index = 0;
+	fetchFragments(fragments, from);
+}
 
-	std::vector<DataTransfer *> temporal(nFragments, nullptr);
+void ClusterManager::fetchFragments(
+	std::vector<ExecutionWorkflow::FragmentInfo> const &fragments,
+	MemoryPlace const *from
+) {
+	assert(_singleton->_msn != nullptr);
+	assert(from != nullptr);
+	assert(from->getType() == nanos6_cluster_device);
+	assert(!fragments.empty());
 
-	for (ExecutionWorkflow::ClusterDataCopyStep const *step : copySteps) {
+	ClusterNode const *remoteNode = getClusterNode(from->getIndex());
 
-		const std::vector<ExecutionWorkflow::FragmentInfo> &fragments = step->getFragments();
+	assert(remoteNode != _singleton->_thisNode);
 
-		for (__attribute__((unused)) ExecutionWorkflow::FragmentInfo const &fragment : fragments) {
-			assert(index < nFragments);
-			assert(content->_remoteRegionInfo[index]._remoteRegion == fragment._region);
-			temporal[index] = fragment._dataTransfer;
+	//! At the moment we do not translate addresses on remote
+	//! nodes, so the region we are fetching, on the remote node is
+	//! the same as the local one
+	MessageDataFetch *msg = new MessageDataFetch(_singleton->_thisNode, fragments);
 
-			++index;
-		}
-	}
+	std::vector<DataTransfer *> temporal;
+	temporal.reserve(fragments.size());
 
-	assert(index == nFragments);
+	for (ExecutionWorkflow::FragmentInfo const &fragment : fragments) {
+		temporal.push_back(fragment._dataTransfer);
+	}
 
 	ClusterPollingServices::PendingQueue<DataTransfer>::addPendingVector(temporal);
 
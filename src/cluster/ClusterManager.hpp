@@ -21,10 +21,12 @@
 #include <MessageDataSend.hpp>
 #include <ClusterShutdownCallback.hpp>
 #include "memory/directory/Directory.hpp"
+#include "system/CompiledFeatures.hpp"
 
 namespace ExecutionWorkflow
 {
 	class ClusterDataCopyStep;
+	struct FragmentInfo;
 }
 
 class ClusterMemoryNode;
@@ -69,6 +71,21 @@ private:
 
 	bool _mergeReleaseAndFinish;
 
+	//! Maximum number of tasks offloaded in a single TASK_NEW_BATCH
+	size_t _taskNewBatchSize;
+
+	//! Prefetch the read-satisfied data of the offloaded tasks
+	bool _prefetch;
+
+	//! Maximum number of bytes being prefetched at the same time
+	size_t _prefetchBudget;
+
+	//! Serve data fetches from the nodes that hold a copy
+	bool _sharedFetch;
+
+	//! Number of requests for the same data served before delegating
+	size_t _sharedFetchThreshold;
+
 	int _numMessageHandlerWorkers;
 
 	//! Cluster hybrid interface for controlling #cores, etc.
@@ -208,7 +225,7 @@ public:
 	{
 		assert(_singleton != nullptr);
 		assert(!_singleton->_clusterNodes.empty());
-		return _singleton->_clusterNodes.size() > 1;
+		return CompiledFeatures::cluster && _singleton->_clusterNodes.size() > 1;
 	}
 
 	static inline bool clusterRequested()
@@ -359,6 +376,17 @@ public:
 		MemoryPlace const *from
 	);
 
+	//! \brief Request the data transfers of some fragments from a node
+	//!
+	//! \param[in] fragments are the fragments to fetch, whose data
+	//!		transfers have already been created
+	//! \param[in] from is the MemoryPlace we fetch the data from. This
+	//!		must be a cluster memory place
+	static void fetchFragments(
+		std::vector<ExecutionWorkflow::FragmentInfo> const &fragments,
+		MemoryPlace const *from
+	);
+
 	//! \brief A barrier across all cluster nodes
 	//!
 	//! This is a collective operation. It needs to be invoked by all
@@ -431,6 +459,36 @@ public:
 		return _singleton->_mergeReleaseAndFinish;
 	}
 
+	static size_t getTaskNewBatchSize()
+	{
+		assert(_singleton != nullptr);
+		return _singleton->_taskNewBatchSize;
+	}
+
+	static bool getPrefetch()
+	{
+		assert(_singleton != nullptr);
+		return _singleton->_prefetch;
+	}
+
+	static size_t getPrefetchBudget()
+	{
+		assert(_singleton != nullptr);
+		return _singleton->_prefetchBudget;
+	}
+
+	static bool getSharedFetch()
+	{
+		assert(_singleton != nullptr);
+		return _singleton->_sharedFetch;
+	}
+
+	static size_t getSharedFetchThreshold()
+	{
+		assert(_singleton != nullptr);
+		return _singleton->_sharedFetchThreshold;
+	}
+
 	static bool getNumMessageHandlerWorkers()
 	{
 		assert(_singleton != nullptr);
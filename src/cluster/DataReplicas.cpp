@@ -0,0 +1,125 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <mutex>
+
+#include "DataReplicas.hpp"
+
+#include <ClusterManager.hpp>
+#include <DataTransfer.hpp>
+#include <LiveDataTransfers.hpp>
+#include <MessageDelivery.hpp>
+
+DataReplicas DataReplicas::_singleton;
+
+int DataReplicas::selectServer(DataAccessRegion const &region, WriteID writeID, int requester)
+{
+	const int current = ClusterManager::getCurrentClusterNode()->getIndex();
+	assert(requester != current);
+
+	if (!ClusterManager::getSharedFetch() || writeID == 0) {
+		return current;
+	}
+
+	const key_t key = getKey(writeID, region);
+
+	std::lock_guard<PaddedSpinLock<>> guard(_singleton._lock);
+
+	auto it = _singleton._entries.find(key);
+	if (it == _singleton._entries.end()) {
+		if (_singleton._entries.size() == _maxEntries) {
+			_singleton._entries.erase(_singleton._entriesOrder.front());
+			_singleton._entriesOrder.pop_front();
+		}
+
+		it = _singleton._entries.emplace(key, Entry{{{current, 0}}, 0}).first;
+		_singleton._entriesOrder.push_back(key);
+	}
+
+	Entry &entry = it->second;
+	entry._numRequests++;
+
+	// The first requests are served from here, and the next ones by the
+	// holder that has served the fewest
+	size_t server = 0;
+	if (entry._numRequests > ClusterManager::getSharedFetchThreshold()) {
+		for (size_t i = 1; i < entry._holders.size(); ++i) {
+			Holder const &holder = entry._holders[i];
+			if (holder._nodeIndex != requester
+				&& holder._numServed < entry._holders[server]._numServed) {
+				server = i;
+			}
+		}
+	}
+
+	entry._holders[server]._numServed++;
+	const int serverIndex = entry._holders[server]._nodeIndex;
+
+	// The requester will hold a copy for the next requests
+	auto holder = std::find_if(entry._holders.begin(), entry._holders.end(),
+		[&](Holder const &h) { return h._nodeIndex == requester; });
+	if (holder == entry._holders.end()) {
+		entry._holders.push_back({requester, 0});
+	}
+
+	return serverIndex;
+}
+
+void DataReplicas::removeHolder(DataAccessRegion const &region, WriteID writeID, int nodeIndex)
+{
+	assert(nodeIndex != ClusterManager::getCurrentClusterNode()->getIndex());
+
+	std::lock_guard<PaddedSpinLock<>> guard(_singleton._lock);
+
+	auto it = _singleton._entries.find(getKey(writeID, region));
+	if (it == _singleton._entries.end()) {
+		return;
+	}
+
+	std::vector<Holder> &holders = it->second._holders;
+	holders.erase(
+		std::remove_if(holders.begin(), holders.end(),
+			[&](Holder const &h) { return h._nodeIndex == nodeIndex; }),
+		holders.end()
+	);
+}
+
+bool DataReplicas::serveCopy(
+	DataAccessRegion const &region,
+	WriteID writeID,
+	int id,
+	MemoryPlace const *requester
+) {
+	assert(requester != nullptr);
+	assert(writeID != 0);
+
+	if (WriteIDManager::checkWriteIDLocal(writeID, region)) {
+		DataTransfer *dt = ClusterManager::sendDataRaw(region, requester, id);
+		ClusterPollingServices::PendingQueue<DataTransfer>::addPending(dt);
+		return true;
+	}
+
+	// The copy may still be arriving, in which case it is forwarded as soon
+	// as it does
+	const int current = ClusterManager::getCurrentMemoryNode()->getIndex();
+
+	return LiveDataTransfers::find(
+		[&](DataTransfer *dtPending) -> bool {
+			if (dtPending->getTarget()->getIndex() != current
+				|| dtPending->getWriteID() != writeID
+				|| !region.fullyContainedIn(dtPending->getDataAccessRegion())) {
+				return false;
+			}
+
+			dtPending->addCompletionCallback([=]() {
+				DataTransfer *dt = ClusterManager::sendDataRaw(region, requester, id);
+				ClusterPollingServices::PendingQueue<DataTransfer>::addPending(dt);
+			});
+			return true;
+		}
+	);
+}
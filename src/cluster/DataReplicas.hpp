@@ -0,0 +1,98 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef DATA_REPLICAS_HPP
+#define DATA_REPLICAS_HPP
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "WriteID.hpp"
+#include "lowlevel/PaddedSpinLock.hpp"
+
+#include <DataAccessRegion.hpp>
+
+class MemoryPlace;
+
+//! Serve read-shared data from the nodes that already hold a copy
+//!
+//! When cluster.shared_fetch is enabled, each node keeps track of the nodes
+//! to which it has served every (WriteID, region) pair. After a number of
+//! requests for the same pair (cluster.shared_fetch_threshold), the next
+//! requests are delegated to the node that holds a copy and has served the
+//! fewest of them, including this node. Every node that gets a copy becomes
+//! a server of the following requests, so the copies spread as in a
+//! binomial tree broadcast instead of being sent by a single node.
+//!
+//! A node that is delegated a request serves it if the WriteID is present
+//! locally, or as soon as its own fetch of the same WriteID completes.
+//! Otherwise, the request is returned to the node that delegated it.
+class DataReplicas {
+	typedef std::pair<WriteID, std::pair<void *, size_t>> key_t;
+
+	struct Holder {
+		//! The index of the node that holds a copy
+		int _nodeIndex;
+
+		//! The number of requests that were assigned to it
+		size_t _numServed;
+	};
+
+	struct Entry {
+		//! The nodes that hold a copy. The first one is this node
+		std::vector<Holder> _holders;
+
+		//! The number of requests received
+		size_t _numRequests;
+	};
+
+	//! The maximum number of (WriteID, region) pairs tracked. The oldest
+	//! ones are forgotten first
+	static constexpr size_t _maxEntries = 1024;
+
+	PaddedSpinLock<> _lock;
+	std::map<key_t, Entry> _entries;
+	std::deque<key_t> _entriesOrder;
+
+	static DataReplicas _singleton;
+
+	static inline key_t getKey(WriteID writeID, DataAccessRegion const &region)
+	{
+		return key_t(writeID, std::make_pair(region.getStartAddress(), region.getSize()));
+	}
+
+public:
+	//! \brief Choose the node that serves a data fetch
+	//!
+	//! \param[in] region is the region requested
+	//! \param[in] writeID is the WriteID of the data requested, or 0 if unknown
+	//! \param[in] requester is the index of the node that requested it
+	//!
+	//! \returns the index of the node that must send the data
+	static int selectServer(DataAccessRegion const &region, WriteID writeID, int requester);
+
+	//! \brief Forget a node that no longer holds a copy
+	static void removeHolder(DataAccessRegion const &region, WriteID writeID, int nodeIndex);
+
+	//! \brief Send a copy of the data to a node on behalf of another one
+	//!
+	//! \param[in] region is the region requested
+	//! \param[in] writeID is the WriteID of the data requested
+	//! \param[in] id is the message id of the requester's fetch
+	//! \param[in] requester is the MemoryPlace of the node that requested it
+	//!
+	//! \returns false if this node does not have nor is fetching the data
+	static bool serveCopy(
+		DataAccessRegion const &region,
+		WriteID writeID,
+		int id,
+		MemoryPlace const *requester
+	);
+};
+
+#endif /* DATA_REPLICAS_HPP */
@@ -175,3 +175,17 @@ void NodeNamespace::enqueueTaskMessagePrivate(MessageTaskNew *message)
 	tryWakeUp();
 }
 
+void NodeNamespace::enqueueTaskMessagesPrivate(std::vector<MessageTaskNew *> const &messages)
+{
+	// We shouldn't receive any task-new after Shutdown message.
+	assert(!_mustShutdown.load());
+
+	_spinlock.lock();
+
+	_queue.insert(_queue.end(), messages.begin(), messages.end());
+
+	_spinlock.unlock();
+
+	// Unblock the executor if it was blocked
+	tryWakeUp();
+}
@@ -10,6 +10,7 @@
 
 #include <deque>
 #include <unistd.h>
+#include <vector>
 
 #include <ClusterShutdownCallback.hpp>
 #include "messages/MessageTaskNew.hpp"
@@ -63,6 +64,10 @@ private:
 	//! \param[in] function The kernel to execute
 	void enqueueTaskMessagePrivate(MessageTaskNew *message);
 
+	//! \brief Add several functions to this executor's stream queue at once
+	//! \param[in] messages The messages of the tasks to create, in order
+	void enqueueTaskMessagesPrivate(std::vector<MessageTaskNew *> const &messages);
+
 public:
 
 	static void body(void *args, void *, nanos6_address_translation_entry_t *)
@@ -166,6 +171,16 @@ public:
 		_singleton->enqueueTaskMessagePrivate(message);
 	}
 
+	//! \brief Add the tasks of a batch to this executor's stream queue
+	//!
+	//! The messages are queued under a single lock acquisition and the
+	//! executor is woken up once for the whole batch
+	//! \param[in] messages The messages of the tasks to create, in order
+	static void enqueueTaskMessages(std::vector<MessageTaskNew *> const &messages)
+	{
+		_singleton->enqueueTaskMessagesPrivate(messages);
+	}
+
 	static bool isEnabled()
 	{
 		return (_singleton != nullptr);
@@ -4,39 +4,36 @@
 	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <map>
+
 #include "MessageDataFetch.hpp"
+#include "MessageDataServe.hpp"
 
 #include <ClusterManager.hpp>
+#include <DataReplicas.hpp>
 #include <MessageDelivery.hpp>
 
 #include "executors/workflow/cluster/ExecutionWorkflowCluster.hpp"
 
 MessageDataFetch::MessageDataFetch(
 	const ClusterNode *from,
-	size_t numFragments,
-	std::vector<ExecutionWorkflow::ClusterDataCopyStep *> const &copySteps
+	std::vector<ExecutionWorkflow::FragmentInfo> const &fragments
 )
-	: Message(DATA_FETCH, sizeof(size_t) + numFragments * sizeof(DataAccessRegionInfo), from)
+	: Message(DATA_FETCH, sizeof(size_t) + fragments.size() * sizeof(DataAccessRegionInfo), from)
 {
 	_content = reinterpret_cast<DataFetchMessageContent *>(_deliverable->payload);
 
-	_content->_nregions = numFragments;
+	_content->_nregions = fragments.size();
 	size_t index = 0;
 
-	for (ExecutionWorkflow::ClusterDataCopyStep const *step : copySteps) {
-
-		const std::vector<ExecutionWorkflow::FragmentInfo> &fragments = step->getFragments();
-
-		for (ExecutionWorkflow::FragmentInfo const &fragment : fragments) {
-			assert(index < numFragments);
-			_content->_remoteRegionInfo[index]._remoteRegion = fragment._region;
-			_content->_remoteRegionInfo[index]._id = fragment._id;
+	for (ExecutionWorkflow::FragmentInfo const &fragment : fragments) {
+		_content->_remoteRegionInfo[index]._remoteRegion = fragment._region;
+		_content->_remoteRegionInfo[index]._id = fragment._id;
+		_content->_remoteRegionInfo[index]._writeID =
+			(fragment._dataTransfer != nullptr) ? fragment._dataTransfer->getWriteID() : 0;
 
-			++index;
-		}
+		++index;
 	}
-
-	assert(index == numFragments);
 }
 
 bool MessageDataFetch::handleMessage()
@@ -45,19 +42,41 @@ bool MessageDataFetch::handleMessage()
 	assert(memoryPlace != nullptr);
 
 	const size_t nFragments = _content->_nregions;
+	const int current = ClusterManager::getCurrentClusterNode()->getIndex();
+
+	// The fragments that other nodes holding a copy will send instead
+	std::map<int, std::vector<DataAccessRegionInfo>> delegated;
 
 	for (size_t i = 0; i < nFragments; ++i) {
+		DataAccessRegionInfo const &regionInfo = _content->_remoteRegionInfo[i];
+
+		const int server = DataReplicas::selectServer(
+			regionInfo._remoteRegion, regionInfo._writeID, getSenderId());
+
+		if (server != current) {
+			delegated[server].push_back(regionInfo);
+			continue;
+		}
 
 		DataTransfer *dt =
 			ClusterManager::sendDataRaw(
-				_content->_remoteRegionInfo[i]._remoteRegion,
+				regionInfo._remoteRegion,
 				memoryPlace,
-				_content->_remoteRegionInfo[i]._id
+				regionInfo._id
 			);
 
 		ClusterPollingServices::PendingQueue<DataTransfer>::addPending(dt);
 	}
 
+	for (auto const &serverRegions : delegated) {
+		MessageDataServe *msg = new MessageDataServe(
+			ClusterManager::getCurrentClusterNode(),
+			getSenderId(),
+			current,
+			serverRegions.second);
+		ClusterManager::sendMessage(msg, ClusterManager::getClusterNode(serverRegions.first));
+	}
+
 	return true;
 }
 
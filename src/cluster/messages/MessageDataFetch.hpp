@@ -12,12 +12,13 @@
 
 #include "Message.hpp"
 #include "MessageId.hpp"
+#include "cluster/WriteID.hpp"
 
 #include <DataAccessRegion.hpp>
 
 namespace ExecutionWorkflow
 {
-	class ClusterDataCopyStep;
+	struct FragmentInfo;
 }
 
 class MessageDataFetch : public Message {
@@ -25,6 +26,7 @@ public:
 	struct DataAccessRegionInfo {
 		int _id;                         // Reply messageID
 		DataAccessRegion _remoteRegion;  // Region fragment
+		WriteID _writeID;                // WriteID of the data, or 0 if unknown
 	};
 
 	struct DataFetchMessageContent {
@@ -40,8 +42,7 @@ private:
 public:
 	MessageDataFetch(
 		const ClusterNode *from,
-		size_t numFragments,
-		std::vector<ExecutionWorkflow::ClusterDataCopyStep *> const &copySteps
+		std::vector<ExecutionWorkflow::FragmentInfo> const &fragments
 	);
 
 	MessageDataFetch(Deliverable *dlv) : Message(dlv)
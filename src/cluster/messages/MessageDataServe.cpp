@@ -0,0 +1,76 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "MessageDataServe.hpp"
+
+#include <ClusterManager.hpp>
+#include <DataReplicas.hpp>
+#include <MessageDelivery.hpp>
+
+MessageDataServe::MessageDataServe(
+	const ClusterNode *from,
+	int requester,
+	int delegator,
+	std::vector<MessageDataFetch::DataAccessRegionInfo> const &regions
+)
+	: Message(DATA_SERVE,
+		sizeof(DataServeMessageContent) + regions.size() * sizeof(MessageDataFetch::DataAccessRegionInfo),
+		from)
+{
+	_content = reinterpret_cast<DataServeMessageContent *>(_deliverable->payload);
+
+	_content->_requester = requester;
+	_content->_delegator = delegator;
+	_content->_nregions = regions.size();
+
+	size_t index = 0;
+	for (MessageDataFetch::DataAccessRegionInfo const &regionInfo : regions) {
+		_content->_remoteRegionInfo[index] = regionInfo;
+		++index;
+	}
+}
+
+bool MessageDataServe::handleMessage()
+{
+	ClusterMemoryNode *requester = ClusterManager::getMemoryNode(_content->_requester);
+	assert(requester != nullptr);
+
+	const bool returned = (_content->_delegator == ClusterManager::getCurrentClusterNode()->getIndex());
+
+	std::vector<MessageDataFetch::DataAccessRegionInfo> missing;
+
+	for (size_t i = 0; i < _content->_nregions; ++i) {
+		MessageDataFetch::DataAccessRegionInfo const &regionInfo = _content->_remoteRegionInfo[i];
+
+		if (returned) {
+			// The node we delegated to no longer holds the data, so send it
+			// from here as requested
+			DataReplicas::removeHolder(regionInfo._remoteRegion, regionInfo._writeID, getSenderId());
+
+			DataTransfer *dt = ClusterManager::sendDataRaw(
+				regionInfo._remoteRegion, requester, regionInfo._id);
+			ClusterPollingServices::PendingQueue<DataTransfer>::addPending(dt);
+
+		} else if (!DataReplicas::serveCopy(
+				regionInfo._remoteRegion, regionInfo._writeID, regionInfo._id, requester)) {
+			missing.push_back(regionInfo);
+		}
+	}
+
+	if (!missing.empty()) {
+		MessageDataServe *msg = new MessageDataServe(
+			ClusterManager::getCurrentClusterNode(),
+			_content->_requester,
+			_content->_delegator,
+			missing);
+		ClusterManager::sendMessage(msg, ClusterManager::getClusterNode(_content->_delegator));
+	}
+
+	return true;
+}
+
+static const bool __attribute__((unused))_registered_dserve =
+	Message::RegisterMSGClass<MessageDataServe>(DATA_SERVE);
@@ -0,0 +1,73 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef MESSAGE_DATA_SERVE_HPP
+#define MESSAGE_DATA_SERVE_HPP
+
+#include <sstream>
+#include <vector>
+
+#include "Message.hpp"
+#include "MessageDataFetch.hpp"
+
+#include <DataAccessRegion.hpp>
+
+//! A message that delegates some data fetches to a node that holds a copy
+//!
+//! The node that receives a DATA_FETCH may ask another node to send the data
+//! to the requester in its place (see DataReplicas). If that node does not
+//! hold the data anymore, it returns the fetches to the delegator, which
+//! then sends the data itself.
+class MessageDataServe : public Message {
+public:
+	struct DataServeMessageContent {
+		//! The index of the node that requested the data
+		int _requester;
+
+		//! The index of the node that received the DATA_FETCH
+		int _delegator;
+
+		size_t _nregions;
+		MessageDataFetch::DataAccessRegionInfo _remoteRegionInfo[];
+	};
+
+private:
+	//! \brief pointer to the message payload
+	DataServeMessageContent *_content;
+
+public:
+	MessageDataServe(
+		const ClusterNode *from,
+		int requester,
+		int delegator,
+		std::vector<MessageDataFetch::DataAccessRegionInfo> const &regions
+	);
+
+	MessageDataServe(Deliverable *dlv) : Message(dlv)
+	{
+		_content = reinterpret_cast<DataServeMessageContent *>(_deliverable->payload);
+	}
+
+	bool handleMessage();
+
+	inline std::string toString() const
+	{
+		std::stringstream ss;
+		const size_t nregions = _content->_nregions;
+		ss << "[requester:" << _content->_requester
+			<< " delegator:" << _content->_delegator
+			<< " regions(" << nregions << "): ";
+
+		for (size_t i = 0; i < nregions; ++i) {
+			ss << _content->_remoteRegionInfo[i]._remoteRegion
+				<< (i < nregions - 1 ? "; " : "]");
+		}
+
+		return ss.str();
+	}
+};
+
+#endif /* MESSAGE_DATA_SERVE_HPP */
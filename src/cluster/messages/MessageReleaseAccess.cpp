@@ -8,6 +8,8 @@
 #include "MessageReleaseAccess.hpp"
 
 #include <ClusterManager.hpp>
+#include <ExecutionWorkflowCluster.hpp>
+#include <ObjectAllocator.hpp>
 #include <TaskOffloading.hpp>
 #include <ClusterUtil.hpp>
 #include "OffloadedTaskId.hpp"
@@ -64,7 +66,8 @@ bool MessageReleaseAccess::handleMessage()
 
 		task->setExecutionStep(nullptr);
 		step->releaseSuccessors();
-		delete step;
+		ObjectAllocator<ExecutionWorkflow::ClusterExecutionStep>::deleteObject(
+			static_cast<ExecutionWorkflow::ClusterExecutionStep *>(step));
 	}
 
 	return true;
@@ -20,8 +20,8 @@ MessageTaskNew::MessageTaskNew(
 	nanos6_task_info_t *taskInfo,
 	nanos6_task_invocation_info_t *taskInvocationInfo,
 	size_t flags,
-	size_t numImplementations,
-	nanos6_task_implementation_info_t *taskImplementations,
+	TaskOffloading::task_type_id_t taskTypeId,
+	bool includeTaskType,
 	size_t numSatInfo,
 	const TaskOffloading::SatisfiabilityInfo *satInfo,
 	size_t argsBlockSize,
@@ -30,28 +30,35 @@ MessageTaskNew::MessageTaskNew(
 ) :
 	Message(TASK_NEW,
 		sizeof(TaskNewMessageContent) +
-		numImplementations * sizeof(nanos6_task_implementation_info_t) +
+		(includeTaskType ? TaskOffloading::TaskTypeTable::getDescriptorSize(taskInfo->implementation_count) : 0) +
 		numSatInfo * sizeof(TaskOffloading::SatisfiabilityInfo) +
 		argsBlockSize,
-		from)
+		from),
+	_taskType(nullptr)
 {
 	assert(taskInfo != nullptr);
 	assert(taskInvocationInfo != nullptr);
-	assert(taskImplementations != nullptr);
+	assert(taskInfo->implementations != nullptr);
+	assert(taskInfo->implementation_count > 0);
 	assert(satInfo != nullptr || numSatInfo == 0);
 	assert(argsBlock != nullptr || argsBlockSize == 0);
 
+	size_t numImplementations = (includeTaskType) ? taskInfo->implementation_count : 0;
+
 	_content = reinterpret_cast<TaskNewMessageContent *>(_deliverable->payload);
-	memcpy(&_content->_taskInfo, taskInfo, sizeof(nanos6_task_info_t));
-	memcpy(&_content->_taskInvocationInfo, taskInvocationInfo, sizeof(nanos6_task_invocation_info_t));
 	memcpy(&_content->_flags, &flags, sizeof(flags));
 	memcpy(&_content->_argsBlockSize, &argsBlockSize, sizeof(argsBlockSize));
+	memcpy(&_content->_taskTypeId, &taskTypeId, sizeof(taskTypeId));
 	memcpy(&_content->_numImplementations, &numImplementations, sizeof(numImplementations));
 	memcpy(&_content->_offloadedTaskId, &offloadedTaskId, sizeof(offloadedTaskId));
 	memcpy(&_content->_numSatInfo, &numSatInfo, sizeof(numSatInfo));
 
-	memcpy(getImplementationsPtr(), taskImplementations,
-		numImplementations * sizeof(nanos6_task_implementation_info_t));
+	if (includeTaskType) {
+		memcpy(getTaskInfoPtr(), taskInfo, sizeof(nanos6_task_info_t));
+		memcpy(getTaskInvocationInfoPtr(), taskInvocationInfo, sizeof(nanos6_task_invocation_info_t));
+		memcpy(getImplementationsPtr(), taskInfo->implementations,
+			numImplementations * sizeof(nanos6_task_implementation_info_t));
+	}
 
 	if (satInfo != nullptr) {
 		memcpy(getSatInfoPtr(), satInfo, numSatInfo * sizeof(TaskOffloading::SatisfiabilityInfo));
@@ -62,8 +69,27 @@ MessageTaskNew::MessageTaskNew(
 	}
 }
 
+void MessageTaskNew::resolveTaskType()
+{
+	// The messages from a node are handled in order, so the first message
+	// of each task type, which includes its descriptor, is handled before
+	// the rest of messages of the type
+	if (_content->_numImplementations > 0) {
+		_taskType = TaskOffloading::TaskTypeTable::registerReceivedType(
+			getSenderId(), _content->_taskTypeId,
+			getTaskInfoPtr(), getTaskInvocationInfoPtr(),
+			_content->_numImplementations, getImplementationsPtr());
+	} else {
+		_taskType = TaskOffloading::TaskTypeTable::getReceivedType(
+			getSenderId(), _content->_taskTypeId);
+	}
+	assert(_taskType != nullptr);
+}
+
 bool MessageTaskNew::handleMessage()
 {
+	resolveTaskType();
+
 	ClusterHybridMetrics::incReceivedNumNewTask();
 	NodeNamespace::enqueueTaskMessage(this);
 
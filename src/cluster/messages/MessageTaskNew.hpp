@@ -7,6 +7,7 @@
 #ifndef MESSAGE_TASKNEW_HPP
 #define MESSAGE_TASKNEW_HPP
 
+#include <cassert>
 #include <sstream>
 
 #include "Message.hpp"
@@ -16,13 +17,12 @@
 #include <SatisfiabilityInfo.hpp>
 
 #include "OffloadedTaskId.hpp"
+#include "TaskTypeTable.hpp"
 
 class MessageTaskNew : public Message {
 	struct TaskNewMessageContent {
-		//! Necessary info for duplicating the task on the remote node
-		nanos6_task_info_t _taskInfo;
-		nanos6_task_invocation_info_t _taskInvocationInfo;
-		nanos6_loop_bounds_t _bounds; // For taskfors
+		//! Loop bounds for taskfors and taskloops
+		nanos6_loop_bounds_t _bounds;
 
 		//! The flags of the task
 		size_t _flags;
@@ -30,7 +30,11 @@ class MessageTaskNew : public Message {
 		//! The size of the Task's argsBlock
 		size_t _argsBlockSize;
 
-		//! The number of task implementations
+		//! The identifier of the task type for the pair of nodes
+		TaskOffloading::task_type_id_t _taskTypeId;
+
+		//! The number of task implementations if the message includes the
+		//! descriptor of the task type, or zero otherwise
 		size_t _numImplementations;
 
 		//! The number of satisfiability information entries
@@ -43,12 +47,14 @@ class MessageTaskNew : public Message {
 		//! buffer holding all the variable length information we need
 		//! to send across.
 		//!
-		//! This includes the actual argsBlock of the task the task
-		//! implementation information and satisfiability information.
+		//! This includes the descriptor of the task type, only in the
+		//! first message of the type sent to the node, the satisfiability
+		//! information and the actual argsBlock of the task.
 		//!
 		//! The format looks like this:
 		//!
-		//! [nanos6_task_implementation_info_t | ... | SatisfiabilityInfo | ... | argsBlock]
+		//! [[nanos6_task_info_t | nanos6_task_invocation_info_t | nanos6_task_implementation_info_t | ...] |
+		//!  SatisfiabilityInfo | ... | argsBlock]
 		//!
 		//! If you need to change this layout amend the previous.
 		char _msgData[];
@@ -57,17 +63,40 @@ class MessageTaskNew : public Message {
 	//! pointer to message payload
 	TaskNewMessageContent *_content;
 
+	//! The cached descriptor of the task type. Only valid in the receiver
+	//! once the message has been handled
+	TaskOffloading::ReceivedTaskType *_taskType;
+
+	//! Returns a pointer in the Message memory holding the task info, if
+	//! the message includes the descriptor of the task type
+	inline nanos6_task_info_t *getTaskInfoPtr() const
+	{
+		return (nanos6_task_info_t *) _content->_msgData;
+	}
+
+	//! Returns a pointer in the Message memory holding the task invocation
+	//! info, if the message includes the descriptor of the task type
+	inline nanos6_task_invocation_info_t *getTaskInvocationInfoPtr() const
+	{
+		return (nanos6_task_invocation_info_t *) (getTaskInfoPtr() + 1);
+	}
+
 	//! Returns a pointer in the Message memory holding the task
-	//! implementation info
+	//! implementation info, if the message includes the descriptor of the
+	//! task type
 	inline nanos6_task_implementation_info_t *getImplementationsPtr() const
 	{
-		return (nanos6_task_implementation_info_t *)_content->_msgData;
+		return (nanos6_task_implementation_info_t *) (getTaskInvocationInfoPtr() + 1);
 	}
 
 	//! Returns a pointer in the Message memory holding the satisfiability
 	//! information we have
 	inline TaskOffloading::SatisfiabilityInfo *getSatInfoPtr() const
 	{
+		if (_content->_numImplementations == 0) {
+			return (TaskOffloading::SatisfiabilityInfo *) _content->_msgData;
+		}
+
 		return (TaskOffloading::SatisfiabilityInfo *)
 			(getImplementationsPtr() + _content->_numImplementations);
 	}
@@ -79,13 +108,17 @@ class MessageTaskNew : public Message {
 	}
 
 public:
+	//! \brief Create a message to offload a task
+	//!
+	//! The descriptor of the task type (the task info, the invocation info
+	//! and the implementations) is only included if includeTaskType is true
 	MessageTaskNew(
 		const ClusterNode *from,
 		nanos6_task_info_t *taskInfo,
 		nanos6_task_invocation_info_t *taskInvokationInfo,
 		size_t flags,
-		size_t numImplementations,
-		nanos6_task_implementation_info_t *taskImplementations,
+		TaskOffloading::task_type_id_t taskTypeId,
+		bool includeTaskType,
 		size_t numSatInfo,
 		TaskOffloading::SatisfiabilityInfo const *satInfo,
 		size_t argsBlockSize,
@@ -93,20 +126,19 @@ public:
 		OffloadedTaskId offloadedTaskId
 	);
 
-	MessageTaskNew(Deliverable *dlv) : Message(dlv)
+	MessageTaskNew(Deliverable *dlv) : Message(dlv), _taskType(nullptr)
 	{
 		_content = reinterpret_cast<TaskNewMessageContent *>(_deliverable->payload);
 	}
 
 	//! Get the task_info_t of the offloaded task
 	//!
-	//! This returns a pointer in memory of the Message. The calling site
-	//! is responsible for copying out from this memory or making sure that
-	//! the memory of the MessageTaskNew is not deallocated for as long as
-	//! needed.
+	//! This returns a pointer to the descriptor of the task type cached
+	//! in the receiver, which is shared by all the tasks of the type
 	inline nanos6_task_info_t *getTaskInfo() const
 	{
-		return &_content->_taskInfo;
+		assert(_taskType != nullptr);
+		return &_taskType->_taskInfo;
 	}
 
 	//! Set loop bounds (for taskfors)
@@ -123,13 +155,12 @@ public:
 
 	//! Get the task_invocation_info_t of the offloaded task
 	//!
-	//! This returns a pointer in memory of the Message. The calling site
-	//! is responsible for copying out from this memory or making sure that
-	//! the memory of the MessageTaskNew is not deallocated for as long as
-	//! needed
+	//! This returns a pointer to the descriptor of the task type cached
+	//! in the receiver, which is shared by all the tasks of the type
 	inline nanos6_task_invocation_info_t *getTaskInvocationInfo() const
 	{
-		return &_content->_taskInvocationInfo;
+		assert(_taskType != nullptr);
+		return &_taskType->_taskInvocationInfo;
 	}
 
 	//! Get the task flags
@@ -144,23 +175,6 @@ public:
 		return _content->_offloadedTaskId;
 	}
 
-	//! Get an array of the available task implementations
-	//!
-	//! This returns a pointer in Message memory holding the information of
-	//! the Task's implementations. The calling site is responsible for
-	//! copying out from this memory or making sure that the Message is not
-	//! deleted for as long as it is needed. The method also returns the
-	//! number of the available task implementations.
-	inline nanos6_task_implementation_info_t *getImplementations(size_t &numImplementations) const
-	{
-		numImplementations = _content->_numImplementations;
-		if (numImplementations == 0) {
-			return nullptr;
-		}
-
-		return getImplementationsPtr();
-	}
-
 	//! Get an array of the available satisfiability information we have
 	//!
 	//! This returns a pointer in memory of the Message. The calling site
@@ -195,12 +209,19 @@ public:
 		return getArgsBlockPtr();
 	}
 
+	//! \brief Find the descriptor of the task type in the receiver
+	//!
+	//! The descriptor is registered if the message includes it, or looked
+	//! up in the types already received from the sender otherwise
+	void resolveTaskType();
+
 	bool handleMessage();
 
 	inline std::string toString() const
 	{
 		std::stringstream ss;
 		ss << "[offloadedTaskId:" << _content->_offloadedTaskId
+			<< " taskTypeId:" << _content->_taskTypeId
 			<< " numSatInfo:" << _content->_numSatInfo
 			<< "]";
 
@@ -0,0 +1,97 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cstdlib>
+#include <cstring>
+
+#include "MessageTaskNew.hpp"
+#include "MessageTaskNewBatch.hpp"
+#include "NodeNamespace.hpp"
+#include "cluster/hybrid/ClusterHybridMetrics.hpp"
+
+size_t MessageTaskNewBatch::computeSize(std::vector<MessageTaskNew *> const &messages)
+{
+	size_t size = sizeof(TaskNewBatchMessageContent);
+	for (MessageTaskNew const *msg : messages) {
+		assert(msg != nullptr);
+		size += sizeof(size_t) + getPaddedSize(msg->getSize());
+	}
+
+	return size;
+}
+
+MessageTaskNewBatch::MessageTaskNewBatch(
+	const ClusterNode *from,
+	std::vector<MessageTaskNew *> &messages
+) :
+	Message(TASK_NEW_BATCH, computeSize(messages), from)
+{
+	assert(!messages.empty());
+
+	_content = reinterpret_cast<TaskNewBatchMessageContent *>(_deliverable->payload);
+	_content->_numTasks = messages.size();
+
+	char *data = _content->_msgData;
+	for (MessageTaskNew *msg : messages) {
+		const size_t size = msg->getSize();
+		memcpy(data, &size, sizeof(size));
+		data += sizeof(size_t);
+
+		memcpy(data, msg->getDeliverable()->payload, size);
+		data += getPaddedSize(size);
+
+		delete msg;
+	}
+	assert(data == _deliverable->payload + getSize());
+
+	messages.clear();
+}
+
+bool MessageTaskNewBatch::handleMessage()
+{
+	const size_t numTasks = _content->_numTasks;
+	assert(numTasks > 0);
+
+	std::vector<MessageTaskNew *> messages;
+	messages.reserve(numTasks);
+
+	const char *data = _content->_msgData;
+	for (size_t i = 0; i < numTasks; ++i) {
+		size_t size;
+		memcpy(&size, data, sizeof(size));
+		data += sizeof(size_t);
+
+		// Rebuild the Deliverable of the individual task, since the
+		// MessageTaskNew outlives the batch until the remote task is
+		// cleaned up
+		Deliverable *dlv = (Deliverable *) malloc(sizeof(msg_header) + size);
+		FatalErrorHandler::failIf(dlv == nullptr, "Could not allocate for unpacking a task batch");
+
+		dlv->header = _deliverable->header;
+		dlv->header.type = TASK_NEW;
+		dlv->header.size = size;
+		memcpy(dlv->payload, data, size);
+		data += getPaddedSize(size);
+
+		// The task types must be resolved in the order the tasks were
+		// offloaded, since only the first one of each type may carry
+		// its descriptor
+		MessageTaskNew *msg = new MessageTaskNew(dlv);
+		msg->resolveTaskType();
+		messages.push_back(msg);
+
+		ClusterHybridMetrics::incReceivedNumNewTask();
+	}
+	assert(data == _deliverable->payload + getSize());
+
+	NodeNamespace::enqueueTaskMessages(messages);
+
+	// The MessageTaskNew of each task will be deleted by remoteTaskCleanup
+	return true;
+}
+
+static const bool __attribute__((unused))_registered_tasknew_batch =
+	Message::RegisterMSGClass<MessageTaskNewBatch>(TASK_NEW_BATCH);
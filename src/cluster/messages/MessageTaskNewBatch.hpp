@@ -0,0 +1,69 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef MESSAGE_TASKNEW_BATCH_HPP
+#define MESSAGE_TASKNEW_BATCH_HPP
+
+#include <sstream>
+#include <vector>
+
+#include "Message.hpp"
+
+class MessageTaskNew;
+
+//! A message that offloads several tasks to the same node at once
+//!
+//! Each task is carried as the payload of the MessageTaskNew that would have
+//! been sent for it, so the receiver rebuilds the individual MessageTaskNew
+//! of each task and submits them all to the namespace together
+class MessageTaskNewBatch : public Message {
+private:
+	struct TaskNewBatchMessageContent {
+		//! The number of tasks in the batch
+		size_t _numTasks;
+
+		//! The payloads of the MessageTaskNew of the tasks, in the order
+		//! they were offloaded. Each one is preceded by its size and
+		//! padded to the alignment of size_t:
+		//!
+		//! [size | payload | ... | size | payload]
+		char _msgData[];
+	};
+
+	//! pointer to message payload
+	TaskNewBatchMessageContent *_content;
+
+	static inline size_t getPaddedSize(size_t size)
+	{
+		return (size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+	}
+
+	static size_t computeSize(std::vector<MessageTaskNew *> const &messages);
+
+public:
+	//! \brief Create a message that carries the given task messages
+	//!
+	//! The task messages are only used to build the batch, so they are
+	//! deleted and the vector is cleared
+	MessageTaskNewBatch(const ClusterNode *from, std::vector<MessageTaskNew *> &messages);
+
+	MessageTaskNewBatch(Deliverable *dlv) : Message(dlv)
+	{
+		_content = reinterpret_cast<TaskNewBatchMessageContent *>(_deliverable->payload);
+	}
+
+	bool handleMessage();
+
+	inline std::string toString() const
+	{
+		std::stringstream ss;
+		ss << "[numTasks:" << _content->_numTasks << "]";
+
+		return ss.str();
+	}
+};
+
+#endif /* MESSAGE_TASKNEW_BATCH_HPP */
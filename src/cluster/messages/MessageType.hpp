@@ -22,7 +22,9 @@
 	HELPER_MACRO(SATISFIABILITY)				\
 	HELPER_MACRO(RELEASE_ACCESS)				\
 	HELPER_MACRO(RELEASE_ACCESS_AND_FINISH)		\
-	HELPER_MACRO(NO_EAGER_SEND)
+	HELPER_MACRO(NO_EAGER_SEND)					\
+	HELPER_MACRO(TASK_NEW_BATCH)				\
+	HELPER_MACRO(DATA_SERVE)
 
 typedef enum {
 #define HELPER_MACRO(val) val,
@@ -9,6 +9,7 @@
 
 #include <functional>
 
+#include "cluster/WriteID.hpp"
 #include "hardware/places/MemoryPlace.hpp"
 
 #include <DataAccessRegion.hpp>
@@ -51,6 +52,13 @@ private:
 	//! An opaque pointer to Messenger-specific data
 	void * _messengerData;
 
+	//! The WriteID of the data being fetched, or 0 if unknown
+	WriteID _writeID;
+
+	//! Whether the data will be overwritten by a later fetch of another
+	//! version once this transfer completes
+	bool _superseded;
+
 public:
 	DataTransfer(
 		DataAccessRegion const &region,
@@ -61,7 +69,7 @@ public:
 		int id,
 		bool isFetch
 	) : _region(region), _source(source), _target(target), _id(id), _MPISource(MPISource), _isFetch(isFetch),
-		_callbacks(), _completed(false), _messengerData(messengerData)
+		_callbacks(), _completed(false), _messengerData(messengerData), _writeID(0), _superseded(false)
 	{
 	}
 
@@ -95,6 +103,32 @@ public:
 		return _id;
 	}
 
+	//! \brief Set the WriteID of the data being fetched
+	inline void setWriteID(WriteID writeID)
+	{
+		_writeID = writeID;
+	}
+
+	//! \brief Return the WriteID of the data being fetched, or 0 if unknown
+	inline WriteID getWriteID() const
+	{
+		return _writeID;
+	}
+
+	//! \brief Mark that another version of the data will be fetched to
+	//! the same memory once this transfer completes
+	inline void markAsSuperseded()
+	{
+		_superseded = true;
+	}
+
+	//! \brief Check whether another version of the data will be fetched
+	//! to the same memory once this transfer completes
+	inline bool isSuperseded() const
+	{
+		return _superseded;
+	}
+
 	//! \brief Set the callback for the DataTransfer
 	//!
 	//! \param[in] callback is the completion callback
@@ -36,6 +36,20 @@ public:
 		_liveDataTransfers.erase(it);
 	}
 
+	//! \brief Look for a pending data transfer without creating a new one
+	//!
+	//! \returns true if checkPending returned true for any of them
+	static bool find(std::function<bool(DataTransfer *)> checkPending)
+	{
+		std::lock_guard<PaddedSpinLock<>> guard(_lock);
+		for (DataTransfer *dataTransfer : _liveDataTransfers) {
+			if (checkPending(dataTransfer)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
 	static bool check(
 		std::function<bool(DataTransfer *)> checkPending,
 		std::function<DataTransfer *()> createNew)
@@ -486,6 +486,11 @@ DataTransfer *MPIMessenger::fetchData(
 
 	FatalErrorHandler::failIf(request == nullptr, "Could not allocate memory for MPI_Request");
 
+	// With shared fetches, another node that holds a copy may send the data
+	// requested by a DATA_FETCH. The message ids are unique across nodes, so
+	// the tag is enough to match it
+	const int mpiRecvSrc = ClusterManager::getSharedFetch() ? MPI_ANY_SOURCE : mpiSrc;
+
 	ExtraeLock();
 	forEachDataPart(
 		address,
@@ -493,7 +498,7 @@ DataTransfer *MPIMessenger::fetchData(
 		messageId,
 		[&](void *currAddress, size_t currSize, int currMessageId) {
 			int tag = getTag(currMessageId);
-			ret = MPI_Irecv(currAddress, currSize, MPI_BYTE, mpiSrc, tag, INTRA_COMM_DATA_RAW, request);
+			ret = MPI_Irecv(currAddress, currSize, MPI_BYTE, mpiRecvSrc, tag, INTRA_COMM_DATA_RAW, request);
 			MPIErrorHandler::handle(ret, INTRA_COMM_DATA_RAW);
 		}
 	);
@@ -4,6 +4,8 @@
 	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <utility>
 #include <vector>
@@ -18,19 +20,24 @@
 #include "tasks/Taskfor.hpp"
 #include "tasks/Taskloop.hpp"
 #include "executors/threads/TaskFinalization.hpp"
+#include "executors/workflow/cluster/ExecutionWorkflowCluster.hpp"
 
 #include <ClusterManager.hpp>
 #include <RemoteTasksInfoMap.hpp>
 #include <DataAccessRegistration.hpp>
+#include <DataAccessRegistrationImplementation.hpp>
 #include <Directory.hpp>
 #include <MessageTaskNew.hpp>
+#include <MessageTaskNewBatch.hpp>
 #include "MessageSatisfiability.hpp"
 #include <MessageNoEagerSend.hpp>
 #include <NodeNamespace.hpp>
 
 #include "cluster/WriteID.hpp"
+#include "cluster/messages/MessageId.hpp"
 #include "cluster/polling-services/MessageDelivery.hpp"
 #include "OffloadedTasksInfoMap.hpp"
+#include "TaskTypeTable.hpp"
 #include <ClusterUtil.hpp>
 #include "scheduling/Scheduler.hpp"
 #include "cluster/hybrid/ClusterHybridMetrics.hpp"
@@ -78,6 +85,180 @@ namespace TaskOffloading {
 		);
 	}
 
+	//! The number of bytes being prefetched
+	static std::atomic<size_t> _prefetchedBytes(0);
+
+	//! \brief Prefetch the data of the read-satisfied accesses of a remote task
+	//!
+	//! The accesses that are read-satisfied in the task new message can be
+	//! fetched while the task waits for the rest of its predecessors. The
+	//! prefetched data is registered by WriteID once it arrives, so the copy
+	//! step of the access finds it either local or pending, as long as the
+	//! WriteID did not change in between.
+	static void prefetchSatisfiedData(Task *task, SatisfiabilityInfo const *satInfo, size_t numSatInfo)
+	{
+		assert(task != nullptr);
+
+		const int currentIndex = ClusterManager::getCurrentMemoryNode()->getIndex();
+
+		// Only the accesses that read the data can be prefetched. The data of
+		// a write-only access could arrive while the task is writing it.
+		std::vector<SatisfiabilityInfo> prefetches;
+		DataAccessRegistration::processAllDataAccesses(
+			task,
+			[&](const DataAccess *access) -> bool {
+				DataAccessType type = access->getType();
+				if (access->isWeak() || (type != READ_ACCESS_TYPE && type != READWRITE_ACCESS_TYPE)) {
+					return true;
+				}
+
+				for (size_t i = 0; i < numSatInfo; ++i) {
+					SatisfiabilityInfo const &sat = satInfo[i];
+					if (!sat._readSat
+						|| sat._writeID == 0
+						|| sat._eagerSendTag != 0
+						|| sat._src == -1
+						|| sat._src == currentIndex
+						|| Directory::isDirectoryMemoryPlaceIdx(sat._src)) {
+						continue;
+					}
+
+					DataAccessRegion region = access->getAccessRegion().intersect(sat._region);
+					if (!region.empty() && !WriteIDManager::checkWriteIDLocal(sat._writeID, region)) {
+						prefetches.push_back(sat);
+						prefetches.back()._region = region;
+					}
+				}
+				return true;
+			}
+		);
+
+		const size_t budget = ClusterManager::getPrefetchBudget();
+		std::map<MemoryPlace const *, std::vector<ExecutionWorkflow::FragmentInfo>> fragments;
+
+		for (SatisfiabilityInfo const &sat : prefetches) {
+			const DataAccessRegion region = sat._region;
+			const WriteID writeID = sat._writeID;
+			const size_t size = region.getSize();
+
+			// The rest of the data is fetched when the task becomes ready
+			if (_prefetchedBytes.fetch_add(size) + size > budget) {
+				_prefetchedBytes -= size;
+				continue;
+			}
+
+			MemoryPlace const *source = ClusterManager::getMemoryNode(sat._src);
+			int id = 0;
+
+			bool pending = LiveDataTransfers::check(
+				// Do not fetch data that is already arriving, since both
+				// transfers would write the same memory
+				[&](DataTransfer *dtPending) -> bool {
+					return dtPending->getTarget()->getIndex() == currentIndex
+						&& !region.intersect(dtPending->getDataAccessRegion()).empty();
+				},
+				[&]() -> DataTransfer * {
+					id = MessageId::nextMessageId(ClusterManager::getMPIFragments(region));
+					DataTransfer *dataTransfer = ClusterManager::fetchDataRaw(
+						region, source, id, /* block */ false);
+
+					dataTransfer->setWriteID(writeID);
+					dataTransfer->addCompletionCallback([=]() {
+						// The data is stale if another version is going
+						// to be fetched over it
+						if (!dataTransfer->isSuperseded()) {
+							WriteIDManager::registerWriteIDasLocal(writeID, region);
+						}
+						_prefetchedBytes -= size;
+					});
+
+					fragments[source].push_back({region, id, dataTransfer});
+					return dataTransfer;
+				}
+			);
+
+			if (pending) {
+				_prefetchedBytes -= size;
+			} else {
+				Instrument::dataFetch(Instrument::Prefetched, region);
+			}
+		}
+
+		for (auto const &sourceFragments : fragments) {
+			ClusterManager::fetchFragments(sourceFragments.second, sourceFragments.first);
+		}
+	}
+
+	//! The tasks offloaded by a thread while an OffloadBatchScope is open
+	struct OffloadBatch {
+		typedef std::pair<const nanos6_task_info_t *, const nanos6_task_invocation_info_t *> task_type_t;
+
+		struct NodeBatch {
+			//! The messages of the tasks offloaded to the node
+			std::vector<MessageTaskNew *> _messages;
+
+			//! The task types whose descriptor is included in the messages
+			std::vector<task_type_t> _includedTypes;
+
+			inline bool includesType(task_type_t const &type) const
+			{
+				return std::find(_includedTypes.begin(), _includedTypes.end(), type) != _includedTypes.end();
+			}
+		};
+
+		//! The number of nested scopes open
+		size_t _depth;
+
+		//! The batches of the nodes, indexed by node index
+		std::vector<NodeBatch> _nodeBatches;
+	};
+
+	static thread_local OffloadBatch _offloadBatch;
+
+	static void sendNodeBatch(OffloadBatch::NodeBatch &batch, ClusterNode *remoteNode)
+	{
+		assert(!batch._messages.empty());
+		assert(remoteNode != nullptr);
+
+		if (batch._messages.size() == 1) {
+			ClusterManager::sendMessage(batch._messages[0], remoteNode);
+			batch._messages.clear();
+		} else {
+			// This deletes the individual messages and clears the vector
+			MessageTaskNewBatch *msg = new MessageTaskNewBatch(
+				ClusterManager::getCurrentClusterNode(), batch._messages);
+			ClusterManager::sendMessage(msg, remoteNode);
+		}
+		assert(batch._messages.empty());
+
+		// The batch is posted, so the next messages of its types can omit
+		// the descriptors
+		for (OffloadBatch::task_type_t const &type : batch._includedTypes) {
+			TaskTypeTable::typeAnnounced(type.first, type.second, remoteNode);
+		}
+		batch._includedTypes.clear();
+	}
+
+	OffloadBatchScope::OffloadBatchScope()
+	{
+		_offloadBatch._depth++;
+	}
+
+	OffloadBatchScope::~OffloadBatchScope()
+	{
+		assert(_offloadBatch._depth > 0);
+		if (--_offloadBatch._depth > 0) {
+			return;
+		}
+
+		for (size_t i = 0; i < _offloadBatch._nodeBatches.size(); ++i) {
+			OffloadBatch::NodeBatch &batch = _offloadBatch._nodeBatches[i];
+			if (!batch._messages.empty()) {
+				sendNodeBatch(batch, ClusterManager::getClusterNode(i));
+			}
+		}
+	}
+
 	void offloadTask(
 		Task *task,
 		SatisfiabilityInfoVector const &satInfo,
@@ -103,10 +284,33 @@ namespace TaskOffloading {
 
 		task->markAsOffloaded();
 
+		// Keep the message in the batch of the node if the thread is in an
+		// OffloadBatchScope
+		OffloadBatch::NodeBatch *batch = nullptr;
+		const size_t maxBatchSize = ClusterManager::getTaskNewBatchSize();
+		if (_offloadBatch._depth > 0 && maxBatchSize > 1) {
+			if (_offloadBatch._nodeBatches.empty()) {
+				_offloadBatch._nodeBatches.resize(ClusterManager::clusterSize());
+			}
+			assert((size_t) remoteNode->getIndex() < _offloadBatch._nodeBatches.size());
+			batch = &_offloadBatch._nodeBatches[remoteNode->getIndex()];
+		}
+
+		// Only the first task of each type sent to the node includes the
+		// descriptor of the type. The tasks of a batch are handled in order
+		// by the receiver, so the descriptor is only needed once per batch
+		bool includeTaskType;
+		task_type_id_t taskTypeId = TaskTypeTable::getSentTypeId(
+			taskInfo, taskInvocationInfo, remoteNode, includeTaskType);
+		if (includeTaskType && batch != nullptr
+			&& batch->includesType(OffloadBatch::task_type_t(taskInfo, taskInvocationInfo))) {
+			includeTaskType = false;
+		}
+
 		MessageTaskNew *msg = new MessageTaskNew(
 			thisNode, taskInfo,
 			taskInvocationInfo, flags,
-			taskInfo->implementation_count, taskInfo->implementations,
+			taskTypeId, includeTaskType,
 			nrSatInfo, satInfoPtr,
 			argsBlockSize, argsBlock,
 			taskId
@@ -122,7 +326,25 @@ namespace TaskOffloading {
 		}
 
 		ClusterHybridMetrics::incSentNumNewTask();
-		ClusterManager::sendMessage(msg, remoteNode);
+
+		if (batch != nullptr) {
+			batch->_messages.push_back(msg);
+			if (includeTaskType) {
+				batch->_includedTypes.emplace_back(taskInfo, taskInvocationInfo);
+			}
+
+			if (batch->_messages.size() >= maxBatchSize) {
+				sendNodeBatch(*batch, remoteNode);
+			}
+		} else {
+			ClusterManager::sendMessage(msg, remoteNode);
+
+			if (includeTaskType) {
+				// The message is posted, so the next messages of the type can
+				// omit the descriptor
+				TaskTypeTable::typeAnnounced(taskInfo, taskInvocationInfo, remoteNode);
+			}
+		}
 
 		// Offloaded tasks do not need the "wait" clause, since any waiting will be handled
 		// already at the remote side.
@@ -263,12 +485,6 @@ namespace TaskOffloading {
 		assert(parent != nullptr);
 
 		nanos6_task_info_t * const taskInfo = msg->getTaskInfo();
-
-		size_t numTaskImplementations;
-		nanos6_task_implementation_info_t *taskImplementations =
-			msg->getImplementations(numTaskImplementations);
-
-		taskInfo->implementations = taskImplementations;
 		nanos6_task_invocation_info_t *taskInvocationInfo = msg->getTaskInvocationInfo();
 
 		size_t argsBlockSize;
@@ -372,6 +588,12 @@ namespace TaskOffloading {
 			// Submit the task
 			AddTask::submitTask(task, parent, true);
 
+			// Start fetching the data that is already available before
+			// propagating the satisfiability that may make the task ready
+			if (numSatInfo > 0 && ClusterManager::getPrefetch()) {
+				prefetchSatisfiedData(task, satInfo, numSatInfo);
+			}
+
 			// If there are some satisfiabilities already arrived OR the task has some accesses in
 			// the satinfo. the process all them.
 			if (numSatInfo > 0 || !remoteTaskInfo._satInfo.empty()) {
@@ -25,6 +25,21 @@ class Task;
 
 namespace TaskOffloading {
 
+	//! \brief Scope in which the tasks offloaded by the current thread are
+	//! sent together
+	//!
+	//! While a scope is open, the MessageTaskNew of the offloaded tasks are
+	//! kept per node instead of sent. They are sent when the outermost scope
+	//! of the thread is closed, or when a node accumulates the maximum
+	//! number of tasks per batch, as a single TASK_NEW_BATCH message per
+	//! node. Scopes can be nested
+	class OffloadBatchScope {
+	public:
+		OffloadBatchScope();
+
+		~OffloadBatchScope();
+	};
+
 	//! \brief Offload a Task to a remote ClusterNode
 	//!
 	//! \param[in] task is the Task we are offloading
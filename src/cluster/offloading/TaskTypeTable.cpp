@@ -0,0 +1,139 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+#include <cstring>
+
+#include "TaskTypeTable.hpp"
+#include "hardware/cluster/ClusterNode.hpp"
+
+#include <ClusterManager.hpp>
+#include <InstrumentCluster.hpp>
+
+
+namespace TaskOffloading {
+
+	TaskTypeTable::TaskTypeTable() :
+		_sentTypes(ClusterManager::clusterSize()),
+		_receivedTypes(ClusterManager::clusterSize()),
+		_bytesSaved(0)
+	{
+	}
+
+	task_type_id_t TaskTypeTable::getSentTypeId(
+		const nanos6_task_info_t *taskInfo,
+		const nanos6_task_invocation_info_t *taskInvocationInfo,
+		const ClusterNode *remoteNode,
+		bool &includeDescriptor
+	) {
+		assert(taskInfo != nullptr);
+		assert(taskInvocationInfo != nullptr);
+		assert(remoteNode != nullptr);
+
+		TaskTypeTable &table = getTable();
+		assert((size_t) remoteNode->getIndex() < table._sentTypes.size());
+		SentTypes &sentTypes = table._sentTypes[remoteNode->getIndex()];
+
+		task_type_id_t id;
+		{
+			std::lock_guard<PaddedSpinLock<>> guard(sentTypes._lock);
+
+			type_key_t key(taskInfo, taskInvocationInfo);
+			auto it = sentTypes._types.find(key);
+			if (it == sentTypes._types.end()) {
+				it = sentTypes._types.emplace(key, SentType({sentTypes._nextId++, false})).first;
+			}
+
+			// Keep sending the descriptor until a message including it has
+			// been posted. Otherwise, a message without it could overtake
+			// the one that announces the type
+			id = it->second._id;
+			includeDescriptor = !it->second._announced;
+		}
+
+		if (!includeDescriptor) {
+			size_t bytesSaved = getDescriptorSize(taskInfo->implementation_count);
+			size_t totalBytesSaved = (table._bytesSaved += bytesSaved);
+
+			// Report the saved bytes in KiB
+			if ((totalBytesSaved >> 10) != ((totalBytesSaved - bytesSaved) >> 10)) {
+				Instrument::emitClusterEvent(Instrument::ClusterEventType::TaskNewBytesSaved, totalBytesSaved >> 10);
+			}
+		}
+
+		return id;
+	}
+
+	void TaskTypeTable::typeAnnounced(
+		const nanos6_task_info_t *taskInfo,
+		const nanos6_task_invocation_info_t *taskInvocationInfo,
+		const ClusterNode *remoteNode
+	) {
+		assert(remoteNode != nullptr);
+
+		TaskTypeTable &table = getTable();
+		SentTypes &sentTypes = table._sentTypes[remoteNode->getIndex()];
+
+		std::lock_guard<PaddedSpinLock<>> guard(sentTypes._lock);
+
+		auto it = sentTypes._types.find(type_key_t(taskInfo, taskInvocationInfo));
+		assert(it != sentTypes._types.end());
+		it->second._announced = true;
+	}
+
+	ReceivedTaskType *TaskTypeTable::registerReceivedType(
+		int senderIndex,
+		task_type_id_t id,
+		const nanos6_task_info_t *taskInfo,
+		const nanos6_task_invocation_info_t *taskInvocationInfo,
+		size_t numImplementations,
+		const nanos6_task_implementation_info_t *implementations
+	) {
+		assert(taskInfo != nullptr);
+		assert(taskInvocationInfo != nullptr);
+		assert(implementations != nullptr);
+
+		TaskTypeTable &table = getTable();
+		assert((size_t) senderIndex < table._receivedTypes.size());
+		ReceivedTypes &receivedTypes = table._receivedTypes[senderIndex];
+
+		std::lock_guard<PaddedSpinLock<>> guard(receivedTypes._lock);
+
+		if (id >= receivedTypes._types.size()) {
+			receivedTypes._types.resize(id + 1);
+		}
+
+		std::unique_ptr<ReceivedTaskType> &type = receivedTypes._types[id];
+		if (type == nullptr) {
+			type.reset(new ReceivedTaskType());
+
+			memcpy(&type->_taskInfo, taskInfo, sizeof(nanos6_task_info_t));
+			memcpy(&type->_taskInvocationInfo, taskInvocationInfo, sizeof(nanos6_task_invocation_info_t));
+			type->_implementations.assign(implementations, implementations + numImplementations);
+
+			// The implementations point to the cached copy from now on
+			type->_taskInfo.implementations = type->_implementations.data();
+		}
+
+		return type.get();
+	}
+
+	ReceivedTaskType *TaskTypeTable::getReceivedType(int senderIndex, task_type_id_t id)
+	{
+		TaskTypeTable &table = getTable();
+		assert((size_t) senderIndex < table._receivedTypes.size());
+		ReceivedTypes &receivedTypes = table._receivedTypes[senderIndex];
+
+		std::lock_guard<PaddedSpinLock<>> guard(receivedTypes._lock);
+
+		// The messages from a node are handled in order, so the descriptor
+		// of the type has been received before
+		assert(id < receivedTypes._types.size());
+		assert(receivedTypes._types[id] != nullptr);
+
+		return receivedTypes._types[id].get();
+	}
+}
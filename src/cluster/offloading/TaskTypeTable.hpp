@@ -0,0 +1,140 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef TASK_TYPE_TABLE_HPP
+#define TASK_TYPE_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <nanos6/task-instantiation.h>
+
+#include "lowlevel/PaddedSpinLock.hpp"
+
+class ClusterNode;
+
+namespace TaskOffloading {
+
+	typedef size_t task_type_id_t;
+
+	//! The descriptor of a task type received from a remote node. It is
+	//! shared by all the remote tasks of that type created on this node
+	struct ReceivedTaskType {
+		nanos6_task_info_t _taskInfo;
+		nanos6_task_invocation_info_t _taskInvocationInfo;
+		std::vector<nanos6_task_implementation_info_t> _implementations;
+	};
+
+	//! Per-node tables of the task types exchanged with the other nodes
+	//!
+	//! The first task of a type offloaded to a node includes the descriptor of
+	//! the type (the task info, the invocation info and the implementations)
+	//! in its MessageTaskNew. Then, the following tasks of the same type only
+	//! include the identifier of the type, which the receiver uses to find
+	//! the descriptor that it cached
+	class TaskTypeTable {
+		typedef std::pair<const nanos6_task_info_t *, const nanos6_task_invocation_info_t *> type_key_t;
+
+		struct SentType {
+			task_type_id_t _id;
+
+			//! Whether a message with the descriptor has already been
+			//! posted, so the next messages can omit it
+			bool _announced;
+		};
+
+		//! The task types offloaded to a node
+		struct SentTypes {
+			std::map<type_key_t, SentType> _types;
+			task_type_id_t _nextId;
+			PaddedSpinLock<> _lock;
+
+			SentTypes() : _types(), _nextId(0), _lock()
+			{
+			}
+		};
+
+		//! The task types received from a node, indexed by their identifier.
+		//! They are not allocated with the MemoryAllocator since the table
+		//! is destroyed at exit, after the allocator has been shut down
+		struct ReceivedTypes {
+			std::vector<std::unique_ptr<ReceivedTaskType>> _types;
+			PaddedSpinLock<> _lock;
+		};
+
+		std::vector<SentTypes> _sentTypes;
+		std::vector<ReceivedTypes> _receivedTypes;
+
+		//! Total bytes of task type descriptors not sent
+		std::atomic<size_t> _bytesSaved;
+
+		TaskTypeTable();
+
+		static TaskTypeTable &getTable()
+		{
+			static TaskTypeTable table;
+			return table;
+		}
+
+	public:
+		//! \brief Get the size of the descriptor of a task type
+		static inline size_t getDescriptorSize(size_t numImplementations)
+		{
+			return sizeof(nanos6_task_info_t)
+				+ sizeof(nanos6_task_invocation_info_t)
+				+ numImplementations * sizeof(nanos6_task_implementation_info_t);
+		}
+
+		//! \brief Get the identifier of a task type to offload a task to a node
+		//!
+		//! \param[in] taskInfo The task info of the task
+		//! \param[in] taskInvocationInfo The invocation info of the task
+		//! \param[in] remoteNode The node where the task is offloaded
+		//! \param[out] includeDescriptor Whether the message must include the
+		//! descriptor of the type. In that case, the caller must call
+		//! typeAnnounced once the message has been posted
+		//!
+		//! \returns The identifier of the task type for that node
+		static task_type_id_t getSentTypeId(
+			const nanos6_task_info_t *taskInfo,
+			const nanos6_task_invocation_info_t *taskInvocationInfo,
+			const ClusterNode *remoteNode,
+			bool &includeDescriptor
+		);
+
+		//! \brief Notify that a message including the descriptor of a task
+		//! type has been posted to a node
+		static void typeAnnounced(
+			const nanos6_task_info_t *taskInfo,
+			const nanos6_task_invocation_info_t *taskInvocationInfo,
+			const ClusterNode *remoteNode
+		);
+
+		//! \brief Register the descriptor of a task type received from a node
+		//!
+		//! If the type was already registered, e.g., because several
+		//! messages included its descriptor, the cached one is kept
+		//!
+		//! \returns The cached descriptor
+		static ReceivedTaskType *registerReceivedType(
+			int senderIndex,
+			task_type_id_t id,
+			const nanos6_task_info_t *taskInfo,
+			const nanos6_task_invocation_info_t *taskInvocationInfo,
+			size_t numImplementations,
+			const nanos6_task_implementation_info_t *implementations
+		);
+
+		//! \brief Get the descriptor of a task type received from a node
+		static ReceivedTaskType *getReceivedType(int senderIndex, task_type_id_t id);
+	};
+}
+
+#endif // TASK_TYPE_TABLE_HPP
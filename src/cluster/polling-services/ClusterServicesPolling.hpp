@@ -10,6 +10,7 @@
 #include "MessageHandler.hpp"
 #include "MessageDelivery.hpp"
 #include "HybridPolling.hpp"
+#include "FetchAggregator.hpp"
 
 namespace ClusterServicesPolling {
 
@@ -63,6 +64,7 @@ namespace ClusterServicesPolling {
 			registerService<ClusterPollingServices::MessageHandler<Message>>("MessageHandler");
 			registerService<ClusterPollingServices::PendingQueue<Message>>("MessageDelivery");
 			registerService<ClusterPollingServices::PendingQueue<DataTransfer>>("DataTransfer");
+			registerService<ClusterPollingServices::FetchAggregator>("FetchAggregator");
 		}
 		registerService<ClusterPollingServices::HybridPolling>("HybridPolling");
 	}
@@ -98,6 +100,7 @@ namespace ClusterServicesPolling {
 			// completion before shutting down the polling services.
 			ClusterPollingServices::PendingQueue<Message>::waitUntilFinished();
 
+			unregisterService<ClusterPollingServices::FetchAggregator>("FetchAggregator");
 			unregisterService<ClusterPollingServices::PendingQueue<DataTransfer>>("DataTransfer");
 			unregisterService<ClusterPollingServices::PendingQueue<Message>>("MessageDelivery");
 			unregisterService<ClusterPollingServices::MessageHandler<Message>>("MessageHandler");
@@ -11,6 +11,8 @@
 #include "MessageDelivery.hpp"
 #include "ClusterWorker.hpp"
 #include "HybridPolling.hpp"
+#include "FetchAggregator.hpp"
+#include "system/ServiceExecutor.hpp"
 
 namespace ClusterServicesTask {
 
@@ -21,9 +23,34 @@ namespace ClusterServicesTask {
 	// must continue. And false to stop the loop. This function must return false when the service
 	// is unregistered and do the needed checks.
 
+	// The polling services are run together by the ServiceExecutor, in a
+	// single task, whereas each worker runs in its own task so that the
+	// workers handle messages in parallel
+
 	// Defined in ClusterManager.cpp
 	extern std::atomic<size_t> _activeClusterTaskServices;
 
+	//! Functions for the ServiceExecutor
+	template <typename T>
+	static bool executeClusterService(__attribute__((unused)) void *data)
+	{
+		if (T::executeService())
+			return true;
+
+		assert(_activeClusterTaskServices.load() > 0);
+		_activeClusterTaskServices.fetch_sub(1);
+		return false;
+	}
+
+	template<typename T>
+	void registerService(uint64_t period = TIMEOUT)
+	{
+		T::registerService();
+
+		_activeClusterTaskServices.fetch_add(1);
+		ServiceExecutor::registerService(executeClusterService<T>, nullptr, period);
+	}
+
 	//! Functions for tasks
 	template <typename T>
 	static void bodyClusterService(__attribute__((unused)) void *args)
@@ -38,9 +65,8 @@ namespace ClusterServicesTask {
 		_activeClusterTaskServices.fetch_sub(1);
 	}
 
-
 	template<typename T>
-	void registerService(const std::string &name)
+	void registerWorker(const std::string &name)
 	{
 		T::registerService();
 
@@ -76,16 +102,22 @@ namespace ClusterServicesTask {
 		assert(MemoryAllocator::isInitialized());
 		assert(_activeClusterTaskServices.load() == 0);
 
-		registerService<ClusterPollingServices::MessageHandler<Message>>("MessageHandler");
-		registerService<ClusterPollingServices::PendingQueue<Message>>("MessageDelivery");
-		registerService<ClusterPollingServices::PendingQueue<DataTransfer>>("DataTransfer");
-		registerService<ClusterPollingServices::HybridPolling>("HybridPolling");
+		registerService<ClusterPollingServices::MessageHandler<Message>>();
+		registerService<ClusterPollingServices::PendingQueue<Message>>();
+		registerService<ClusterPollingServices::PendingQueue<DataTransfer>>();
+
+		// The aggregated fetches must be requested as soon as their window
+		// expires, so poll them once per window
+		size_t window = ClusterPollingServices::FetchAggregator::getWindow();
+		registerService<ClusterPollingServices::FetchAggregator>((window > 0) ? window : TIMEOUT);
+
+		registerService<ClusterPollingServices::HybridPolling>();
 	}
 
 	inline void initializeWorkers(int numWorkers)
 	{
 		for(int i=0; i< numWorkers; i++) {
-			registerService<ClusterPollingServices::ClusterWorker>("ClusterWorker");
+			registerWorker<ClusterPollingServices::ClusterWorker>("ClusterWorker");
 		}
 	}
 
@@ -113,11 +145,15 @@ namespace ClusterServicesTask {
 		// completion before shutting down the polling services.
 		waitUntilFinished();
 
+		unregisterService<ClusterPollingServices::FetchAggregator>();
 		unregisterService<ClusterPollingServices::PendingQueue<DataTransfer>>();
 		unregisterService<ClusterPollingServices::PendingQueue<Message>>();
 		unregisterService<ClusterPollingServices::MessageHandler<Message>>();
 		unregisterService<ClusterPollingServices::HybridPolling>();
 
+		// Wait until the services have stopped
+		ServiceExecutor::shutdown();
+
 		// Note: shutdownWorkers is always called afterwards
 	}
 
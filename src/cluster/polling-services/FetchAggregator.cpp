@@ -0,0 +1,195 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <mutex>
+
+#include "FetchAggregator.hpp"
+#include "LiveDataTransfers.hpp"
+#include "MessageId.hpp"
+#include "executors/workflow/cluster/ExecutionWorkflowCluster.hpp"
+#include "support/config/ConfigVariable.hpp"
+
+#include <ClusterManager.hpp>
+#include <InstrumentCluster.hpp>
+
+ClusterPollingServices::FetchAggregator ClusterPollingServices::FetchAggregator::_singleton;
+
+namespace ClusterPollingServices {
+
+	void FetchAggregator::addFetches(
+		std::vector<ExecutionWorkflow::ClusterDataCopyStep *> const &copySteps,
+		MemoryPlace const *from
+	) {
+		assert(isEnabled());
+		assert(from != nullptr);
+		assert((size_t) from->getIndex() < _singleton._sources.size());
+
+		SourceFetches &source = _singleton._sources[from->getIndex()];
+
+		bool expired;
+		{
+			std::lock_guard<PaddedSpinLock<>> guard(source._lock);
+
+			clock_t::time_point now = clock_t::now();
+			if (source._fetches.empty()) {
+				source._windowStart = now;
+			}
+			expired = (now - source._windowStart >= _singleton._window);
+
+			for (ExecutionWorkflow::ClusterDataCopyStep const *step : copySteps) {
+				DataAccessRegion const &region = step->getRegion();
+				const WriteID writeID = step->getWriteID();
+
+				// Another task may already be waiting for a region that
+				// contains this one
+				auto it = std::find_if(
+					source._fetches.begin(), source._fetches.end(),
+					[&](PendingFetch const &fetch) {
+						return fetch._writeID == writeID && region.fullyContainedIn(fetch._region);
+					}
+				);
+
+				if (it != source._fetches.end()) {
+					it->_callbacks.push_back(step->getPostCallback());
+				} else {
+					source._fetches.push_back({region, writeID, {step->getPostCallback()}});
+					_singleton._numPendingFetches++;
+				}
+			}
+		}
+
+		// Do not wait for the service if the window of the node is over
+		if (expired) {
+			flushSource(from->getIndex(), false);
+		}
+	}
+
+	void FetchAggregator::flushSource(int index, bool force)
+	{
+		SourceFetches &source = _singleton._sources[index];
+
+		std::vector<PendingFetch> fetches;
+		{
+			std::lock_guard<PaddedSpinLock<>> guard(source._lock);
+
+			if (source._fetches.empty()) {
+				return;
+			}
+
+			if (!force && clock_t::now() - source._windowStart < _singleton._window) {
+				return;
+			}
+
+			fetches.swap(source._fetches);
+			_singleton._numPendingFetches -= fetches.size();
+		}
+
+		std::sort(fetches.begin(), fetches.end(),
+			[](PendingFetch const &a, PendingFetch const &b) {
+				return a._region.getStartAddress() < b._region.getStartAddress();
+			}
+		);
+
+		MemoryPlace const *from = ClusterManager::getMemoryNode(index);
+		assert(from != nullptr);
+
+		std::vector<ExecutionWorkflow::FragmentInfo> fragments;
+
+		size_t first = 0;
+		while (first < fetches.size()) {
+			// Merge the following fetches while they overlap or are
+			// contiguous with the current one
+			char *start = (char *) fetches[first]._region.getStartAddress();
+			char *end = (char *) fetches[first]._region.getEndAddress();
+			WriteID writeID = fetches[first]._writeID;
+
+			size_t last = first + 1;
+			while (last < fetches.size()
+				&& (char *) fetches[last]._region.getStartAddress() <= end) {
+				end = std::max(end, (char *) fetches[last]._region.getEndAddress());
+
+				// A merged transfer only has a WriteID if all its parts share it
+				if (fetches[last]._writeID != writeID) {
+					writeID = 0;
+				}
+				++last;
+			}
+
+			DataAccessRegion region(start, end);
+			int id = MessageId::nextMessageId(ClusterManager::getMPIFragments(region));
+			DataTransfer *dataTransfer = ClusterManager::fetchDataRaw(region, from, id, /* block */ false);
+			dataTransfer->setWriteID(writeID);
+
+			for (size_t i = first; i < last; ++i) {
+				for (DataTransfer::data_transfer_callback_t const &callback : fetches[i]._callbacks) {
+					dataTransfer->addCompletionCallback(callback);
+				}
+
+				Instrument::dataFetch(
+					(i == first) ? Instrument::FetchRequired : Instrument::Coalesced,
+					fetches[i]._region);
+			}
+
+			// Only publish the transfer once all its callbacks are set,
+			// since other tasks may add theirs as soon as it is live
+			LiveDataTransfers::add(dataTransfer);
+
+			fragments.push_back({region, id, dataTransfer});
+			first = last;
+		}
+
+		ClusterManager::fetchFragments(fragments, from);
+	}
+
+	bool FetchAggregator::executeService()
+	{
+		// The service is already unregistered, so finish it.
+		if (!_singleton._live.load()) {
+			return false;
+		}
+
+		if (_singleton._numPendingFetches.load() > 0) {
+			for (size_t i = 0; i < _singleton._sources.size(); ++i) {
+				flushSource(i, false);
+			}
+		}
+
+		return true;
+	}
+
+	size_t FetchAggregator::getWindow()
+	{
+		ConfigVariable<size_t> window("cluster.fetch_aggregation_window");
+		return window.getValue();
+	}
+
+	void FetchAggregator::registerService()
+	{
+		assert(_singleton._live.load() == false);
+
+		_singleton._window = std::chrono::microseconds(getWindow());
+
+		std::vector<SourceFetches> sources(ClusterManager::clusterSize());
+		_singleton._sources.swap(sources);
+		_singleton._numPendingFetches = 0;
+
+		_singleton._live = true;
+	}
+
+	void FetchAggregator::unregisterService()
+	{
+		assert(_singleton._live.load() == true);
+
+		// Request any fetch that is still waiting for its window
+		for (size_t i = 0; i < _singleton._sources.size(); ++i) {
+			flushSource(i, true);
+		}
+		assert(_singleton._numPendingFetches.load() == 0);
+
+		_singleton._live = false;
+	}
+}
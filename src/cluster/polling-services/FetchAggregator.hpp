@@ -0,0 +1,105 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef FETCH_AGGREGATOR_HPP
+#define FETCH_AGGREGATOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "lowlevel/PaddedSpinLock.hpp"
+
+#include <DataAccessRegion.hpp>
+#include <DataTransfer.hpp>
+
+class MemoryPlace;
+
+namespace ExecutionWorkflow {
+	class ClusterDataCopyStep;
+}
+
+namespace ClusterPollingServices {
+
+	//! Polling service that aggregates the data fetches from each node
+	//!
+	//! The data fetches requested from a node are kept for a short window
+	//! (cluster.fetch_aggregation_window) so that the fetches of tasks that
+	//! become ready at about the same time are sent together. When the
+	//! window expires, the fetches that overlap or are contiguous are merged
+	//! into a single data transfer, and the completion callbacks of all the
+	//! copy steps are added to it. All the transfers from the same node are
+	//! then requested in a single MessageDataFetch.
+	class FetchAggregator {
+		typedef std::chrono::steady_clock clock_t;
+
+		struct PendingFetch {
+			DataAccessRegion _region;
+			WriteID _writeID;
+			std::vector<DataTransfer::data_transfer_callback_t> _callbacks;
+		};
+
+		//! The fetches pending to be requested from a node
+		struct SourceFetches {
+			PaddedSpinLock<> _lock;
+			std::vector<PendingFetch> _fetches;
+
+			//! When the first of the pending fetches was added
+			clock_t::time_point _windowStart;
+		};
+
+		std::atomic<bool> _live;
+
+		//! The duration of the aggregation window. Zero disables it
+		std::chrono::microseconds _window;
+
+		//! The pending fetches of each node, indexed by node index
+		std::vector<SourceFetches> _sources;
+
+		//! The number of pending fetches of all the nodes
+		std::atomic<size_t> _numPendingFetches;
+
+		static FetchAggregator _singleton;
+
+		//! \brief Request the pending fetches of a node, if the window
+		//! expired or force is true
+		static void flushSource(int index, bool force);
+
+	public:
+		//! \brief Check whether the data fetches must be aggregated
+		static inline bool isEnabled()
+		{
+			return _singleton._live.load() && _singleton._window.count() > 0;
+		}
+
+		//! \brief Get the duration of the aggregation window
+		//!
+		//! \returns The window in microseconds, which is also the period
+		//! at which the service must run
+		static size_t getWindow();
+
+		//! \brief Add the data fetches of some copy steps
+		//!
+		//! The fetches of the node are requested right away if its window
+		//! has already expired
+		//!
+		//! \param[in] copySteps The copy steps whose region must be fetched
+		//! \param[in] from The MemoryPlace of the node to fetch the data from
+		static void addFetches(
+			std::vector<ExecutionWorkflow::ClusterDataCopyStep *> const &copySteps,
+			MemoryPlace const *from
+		);
+
+		// When the function returns false the service stops.
+		static bool executeService();
+
+		static void registerService();
+
+		static void unregisterService();
+	};
+}
+
+#endif /* FETCH_AGGREGATOR_HPP */
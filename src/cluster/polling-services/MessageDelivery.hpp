@@ -168,6 +168,15 @@ namespace ClusterPollingServices {
 			}
 		}
 
+		//! \brief Get the number of elements that are not completed yet
+		static size_t getNumPendings()
+		{
+			// Always take _lock before _incomingLock
+			std::lock_guard<PaddedSpinLock<>> guard1(_singleton._lock);
+			std::lock_guard<PaddedSpinLock<>> guard2(_singleton._incomingLock);
+			return _singleton._pendings.size() + _singleton._incomingPendings.size();
+		}
+
 		static void unregisterService()
 		{
 			assert(_singleton._live.load() == true);
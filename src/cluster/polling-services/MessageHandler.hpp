@@ -61,6 +61,7 @@ namespace ClusterPollingServices {
 				case DMALLOC:
 				case DFREE:
 				case DATA_FETCH:
+				case DATA_SERVE:
 				case DATA_SEND: // Not sure whether worth offloading to workers as just an MPI call
 				case SATISFIABILITY:
 				case NO_EAGER_SEND:
@@ -71,10 +72,11 @@ namespace ClusterPollingServices {
 					break;
 
 				case TASK_NEW:
+				case TASK_NEW_BATCH:
 				case SYS_FINISH:
 					// These messages are handled by the polling service itself.
-					// * TASK_NEW is too trivial: as it only requires queuing the task to be
-					// created and submitted by the namespace
+					// * TASK_NEW and TASK_NEW_BATCH are too trivial: as they only require
+					// queuing the tasks to be created and submitted by the namespace
 					// * SYS_FINISH must be the last message of all to be handled
 					_nonStealableMessages.push_back(msg);
 					break;
@@ -163,8 +165,10 @@ namespace ClusterPollingServices {
 				case DMALLOC:
 				case DFREE:
 				case DATA_FETCH:
+				case DATA_SERVE:
 				case DATA_SEND:
 				case TASK_NEW:
+				case TASK_NEW_BATCH:
 				case SATISFIABILITY:
 				case NO_EAGER_SEND:
 					// These messages have no ordering constraints, so do nothing
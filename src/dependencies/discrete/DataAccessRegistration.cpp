@@ -609,6 +609,13 @@ namespace DataAccessRegistration {
 				}
 			} else {
 				predecessor->setSuccessor(access);
+				Instrument::linkedDataAccesses(
+					predecessor->getInstrumentationId(),
+					task->getInstrumentationTaskId(),
+					Instrument::access_object_type_t::regular_access_type,
+					access->getAccessRegion(),
+					/* direct */ true, /* bidirectional */ false);
+
 				DataAccessMessage message = predecessor->applySingle(ACCESS_HASNEXT, mailBox);
 				fromCurrent = access->applySingle(message.flagsForNext, mailBox);
 				schedule = fromCurrent.schedule;
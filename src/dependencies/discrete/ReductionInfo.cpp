@@ -21,6 +21,10 @@
 #include "devices/CUDAReductionStorage.hpp"
 #endif
 
+#if !USE_OPENACC
+#include "devices/EmulatedReductionStorage.hpp"
+#endif
+
 #include <MemoryAllocator.hpp>
 
 ReductionInfo::ReductionInfo(void *address, size_t length, reduction_type_and_operator_index_t typeAndOperatorIndex,
@@ -85,6 +89,13 @@ DeviceReductionStorage *ReductionInfo::allocateDeviceStorage(nanos6_device_t dev
 			storage = new CUDAReductionStorage(_address, _length, _paddedLength,
 				_initializationFunction, _combinationFunction);
 			break;
+#endif
+#if !USE_OPENACC
+		// The emulated devices take the slot of the OpenACC devices
+		case nanos6_openacc_device:
+			storage = new EmulatedReductionStorage(_address, _length, _paddedLength,
+				_initializationFunction, _combinationFunction);
+			break;
 #endif
 		default:
 			break;
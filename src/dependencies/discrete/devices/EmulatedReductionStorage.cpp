@@ -0,0 +1,120 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+
+#include "EmulatedReductionStorage.hpp"
+#include "MemoryAllocator.hpp"
+#include "hardware/HardwareInfo.hpp"
+
+EmulatedReductionStorage::EmulatedReductionStorage(void *address, size_t length, size_t paddedLength,
+	std::function<void(void *, void *, size_t)> initializationFunction,
+	std::function<void(void *, void *, size_t)> combinationFunction) :
+	DeviceReductionStorage(address, length, paddedLength, initializationFunction, combinationFunction)
+{
+	// The emulated devices take the slot of the OpenACC devices
+	size_t numDevices = HardwareInfo::getComputePlaceCount(nanos6_openacc_device);
+	assert(numDevices != 0);
+	_freeSlotIndices.resize(numDevices, std::vector<size_t>());
+}
+
+void *EmulatedReductionStorage::getFreeSlotStorage(
+	__attribute__((unused)) Task *task,
+	size_t slotIndex,
+	ComputePlace *destinationComputePlace)
+{
+	std::lock_guard<ReductionInfo::spinlock_t> guard(_lock);
+
+	assert(slotIndex < _slots.size());
+	int deviceId = destinationComputePlace->getIndex();
+
+	slot_t &slot = _slots[slotIndex];
+	assert(slot.initialized || slot.storage == nullptr);
+	assert(!slot.initialized || slot.deviceId == deviceId);
+
+	if (!slot.initialized) {
+		slot.storage = MemoryAllocator::alloc(_paddedLength);
+		_initializationFunction(slot.storage, _address, _length);
+
+		slot.initialized = true;
+		slot.deviceId = deviceId;
+	}
+
+	return slot.storage;
+}
+
+void EmulatedReductionStorage::combineInStorage(void *combineDestination)
+{
+	std::lock_guard<ReductionInfo::spinlock_t> guard(_lock);
+
+	assert(combineDestination != nullptr);
+
+	for (size_t i = 0; i < _slots.size(); ++i) {
+		slot_t &slot = _slots[i];
+
+		assert(slot.initialized);
+		assert(slot.storage != nullptr);
+		assert(slot.storage != combineDestination);
+
+		_combinationFunction(combineDestination, slot.storage, _length);
+
+		MemoryAllocator::free(slot.storage, _paddedLength);
+		slot.storage = nullptr;
+		slot.initialized = false;
+	}
+}
+
+size_t EmulatedReductionStorage::getFreeSlotIndex(Task *task, ComputePlace *destinationComputePlace)
+{
+	std::lock_guard<ReductionInfo::spinlock_t> guard(_lock);
+
+	assert(destinationComputePlace->getType() == nanos6_openacc_device);
+	assignation_map_t::iterator itSlot = _currentAssignations.find(task);
+
+	int deviceId = destinationComputePlace->getIndex();
+	assert((size_t)deviceId < _freeSlotIndices.size());
+
+	if (itSlot != _currentAssignations.end()) {
+		size_t currentSlotIndex = itSlot->second;
+
+		assert(_slots[currentSlotIndex].initialized);
+		return currentSlotIndex;
+	}
+
+	size_t freeSlotIndex;
+	if (_freeSlotIndices[deviceId].size() > 0) {
+		// Reuse a free slot of the same device
+		freeSlotIndex = _freeSlotIndices[deviceId].back();
+		_freeSlotIndices[deviceId].pop_back();
+	} else {
+		freeSlotIndex = _slots.size();
+		_slots.emplace_back();
+	}
+
+	_currentAssignations[task] = freeSlotIndex;
+
+	return freeSlotIndex;
+}
+
+void EmulatedReductionStorage::releaseSlotsInUse(Task *task, ComputePlace *computePlace)
+{
+	std::lock_guard<ReductionInfo::spinlock_t> guard(_lock);
+
+	assert(computePlace->getType() == nanos6_openacc_device);
+	assignation_map_t::iterator itSlot = _currentAssignations.find(task);
+
+	if (itSlot != _currentAssignations.end()) {
+		size_t currentSlotIndex = itSlot->second;
+		int deviceId = computePlace->getIndex();
+		assert((size_t)deviceId < _freeSlotIndices.size());
+
+		assert(_slots[currentSlotIndex].storage != nullptr);
+		assert(_slots[currentSlotIndex].initialized);
+		assert(_slots[currentSlotIndex].deviceId == deviceId);
+		_freeSlotIndices[deviceId].emplace_back(currentSlotIndex);
+		_currentAssignations.erase(itSlot);
+	}
+}
@@ -0,0 +1,53 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef EMULATED_REDUCTION_STORAGE_HPP
+#define EMULATED_REDUCTION_STORAGE_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include "dependencies/discrete/DeviceReductionStorage.hpp"
+
+//! \brief Private copies of a reduction on the emulated devices
+//!
+//! Emulated device tasks run on host threads, so their private copies are
+//! allocated in host memory. As in the CUDA devices, each task is assigned a
+//! slot while it runs, and the slots are reused by the following tasks of
+//! the same device until the reduction is combined
+class EmulatedReductionStorage : public DeviceReductionStorage {
+public:
+	struct ReductionSlot {
+		void *storage = nullptr;
+		bool initialized = false;
+		int deviceId = 0;
+	};
+
+	typedef std::unordered_map<Task *, size_t> assignation_map_t;
+	typedef ReductionSlot slot_t;
+
+	EmulatedReductionStorage(void *address, size_t length, size_t paddedLength,
+		std::function<void(void *, void *, size_t)> initializationFunction,
+		std::function<void(void *, void *, size_t)> combinationFunction);
+
+	void *getFreeSlotStorage(Task *task, size_t slotIndex, ComputePlace *destinationComputePlace);
+
+	void combineInStorage(void *combineDestination);
+
+	void releaseSlotsInUse(Task *task, ComputePlace *computePlace);
+
+	size_t getFreeSlotIndex(Task *task, ComputePlace *destinationComputePlace);
+
+	~EmulatedReductionStorage(){};
+
+private:
+	ReductionInfo::spinlock_t _lock;
+	std::vector<slot_t> _slots;
+	assignation_map_t _currentAssignations;
+	std::vector<std::vector<size_t>> _freeSlotIndices;
+};
+
+#endif // EMULATED_REDUCTION_STORAGE_HPP
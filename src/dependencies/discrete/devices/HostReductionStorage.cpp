@@ -1,112 +1,198 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2019-2021 Barcelona Supercomputing Center (BSC)
 */
 
+#include <algorithm>
 #include <cassert>
 
 #include "HostReductionStorage.hpp"
 #include "MemoryAllocator.hpp"
+#include "executors/threads/CPU.hpp"
+#include "hardware/HardwareInfo.hpp"
+#include "lowlevel/threads/HelperThread.hpp"
+
+#include <InstrumentThreadManagement.hpp>
+
+
+//! \brief Helper thread that combines the private copies of a NUMA node
+//!
+//! The thread is bound to one of the CPUs of the node, so that the copies
+//! are read from local memory
+class ReductionCombineThread : public HelperThread {
+	HostReductionStorage *_storage;
+	const std::vector<HostReductionStorage::slot_t *> &_slots;
+
+public:
+	ReductionCombineThread(HostReductionStorage *storage, const std::vector<HostReductionStorage::slot_t *> &slots) :
+		HelperThread("reduction-combine-thread"),
+		_storage(storage),
+		_slots(slots)
+	{
+	}
+
+	void body()
+	{
+		initializeHelperThread();
+		Instrument::threadHasResumed(getInstrumentationId());
+
+		assert(!_slots.empty());
+		bind(_slots[0]->cpu);
+
+		_storage->combineNodeSlots(_slots);
+
+		Instrument::threadWillShutdown(getInstrumentationId());
+	}
+};
 
 
 HostReductionStorage::HostReductionStorage(void *address, size_t length, size_t paddedLength,
 	std::function<void(void *, void *, size_t)> initializationFunction,
 	std::function<void(void *, void *, size_t)> combinationFunction) :
-	DeviceReductionStorage(address, length, paddedLength, initializationFunction, combinationFunction),
-	_freeSlotIndices(CPUManager::getTotalCPUs())
+	DeviceReductionStorage(address, length, paddedLength, initializationFunction, combinationFunction)
 {
 	const long nCpus = CPUManager::getTotalCPUs();
 	assert(nCpus > 0);
 
-	// Create all slots
+	// Create one slot per CPU. Their private copies are allocated lazily
 	_slots.resize(nCpus);
-	_currentCpuSlotIndices.resize(nCpus, -1);
 }
 
 void *HostReductionStorage::getFreeSlotStorage(__attribute__((unused)) Task *task, size_t slotIndex,
-	__attribute__((unused)) ComputePlace *destinationComputePlace)
+	ComputePlace *destinationComputePlace)
 {
 	assert(task != nullptr);
 	assert(destinationComputePlace != nullptr);
 	assert(slotIndex < _slots.size());
 
-	slot_t &slot = _slots[slotIndex];
+	slot_t &slot = *_slots[slotIndex].ptr_to_basetype();
 	assert(slot.initialized || slot.storage == nullptr);
 
 	if (!slot.initialized) {
-		// Allocate new storage
+		// Allocate new storage. The private copy is first touched by the
+		// initialization in its own CPU, which places it on the local node
 		slot.storage = MemoryAllocator::alloc(_paddedLength);
 		_initializationFunction(slot.storage, _address, _length);
+		slot.cpu = (CPU *) destinationComputePlace;
 		slot.initialized = true;
 	}
 
 	return slot.storage;
 }
 
+void HostReductionStorage::freeSlot(slot_t &slot)
+{
+	assert(slot.initialized);
+	assert(slot.storage != nullptr);
+
+	MemoryAllocator::free(slot.storage, _paddedLength);
+	slot.storage = nullptr;
+	slot.initialized = false;
+	slot.cpu = nullptr;
+}
+
+void HostReductionStorage::combineNodeSlots(const std::vector<slot_t *> &slots)
+{
+	assert(!slots.empty());
+
+	slot_t *nodeSlot = slots[0];
+	for (size_t i = 1; i < slots.size(); ++i) {
+		_combinationFunction(nodeSlot->storage, slots[i]->storage, _length);
+		freeSlot(*slots[i]);
+	}
+}
+
 void HostReductionStorage::combineInStorage(void *combineDestination)
 {
 	assert(combineDestination != nullptr);
 
 	// Ensure we see writes from other threads that affected the slots
 	std::atomic_thread_fence(std::memory_order_acquire);
+
+	// Group the private copies by the NUMA node where they were allocated
+	const size_t numNodes = HardwareInfo::getMemoryPlaceCount(nanos6_host_device);
+	std::vector<std::vector<slot_t *>> nodeSlots(numNodes);
+	size_t maxNodeSlots = 0;
+
 	for (size_t i = 0; i < _slots.size(); ++i) {
-		slot_t &slot = _slots[i];
+		slot_t &slot = *_slots[i].ptr_to_basetype();
 
 		if (slot.initialized) {
 			assert(slot.storage != nullptr);
 			assert(slot.storage != combineDestination);
+			assert(slot.cpu != nullptr);
+
+			size_t node = slot.cpu->getNumaNodeId();
+			assert(node < numNodes);
 
-			_combinationFunction(combineDestination, slot.storage, _length);
+			nodeSlots[node].push_back(&slot);
+			maxNodeSlots = std::max(maxNodeSlots, nodeSlots[node].size());
+		}
+	}
 
-			MemoryAllocator::free(slot.storage, _paddedLength);
-			slot.storage = nullptr;
-			slot.initialized = false;
+	// First combine the copies of each node into a single copy per node. When
+	// there is enough data, the nodes are combined in parallel by helper
+	// threads running on each node, and the current thread takes the first one
+	const bool parallel = (maxNodeSlots * _length >= _parallelCombineThreshold);
+	std::vector<ReductionCombineThread *> combineThreads;
+	std::vector<slot_t *> *localSlots = nullptr;
+
+	for (size_t node = 0; node < numNodes; ++node) {
+		if (nodeSlots[node].size() < 2)
+			continue;
+
+		if (!parallel || localSlots == nullptr) {
+			if (parallel) {
+				localSlots = &nodeSlots[node];
+			} else {
+				combineNodeSlots(nodeSlots[node]);
+			}
+		} else {
+			ReductionCombineThread *combineThread = new ReductionCombineThread(this, nodeSlots[node]);
+			combineThread->start(nullptr);
+			combineThreads.push_back(combineThread);
 		}
 	}
+
+	if (localSlots != nullptr) {
+		combineNodeSlots(*localSlots);
+	}
+
+	for (ReductionCombineThread *combineThread : combineThreads) {
+		combineThread->join();
+		delete combineThread;
+	}
+
+	// Then combine the remaining copy of each node into the destination
+	for (size_t node = 0; node < numNodes; ++node) {
+		if (nodeSlots[node].empty())
+			continue;
+
+		slot_t &slot = *nodeSlots[node][0];
+		_combinationFunction(combineDestination, slot.storage, _length);
+		freeSlot(slot);
+	}
 }
 
 size_t HostReductionStorage::getFreeSlotIndex(__attribute__((unused)) Task *task, ComputePlace *destinationComputePlace)
 {
 	assert(destinationComputePlace->getType() == nanos6_host_device);
-	int cpuId = destinationComputePlace->getIndex();
-	assert((size_t)cpuId < _currentCpuSlotIndices.size());
-	long int currentSlotIndex = _currentCpuSlotIndices[cpuId];
-
-	if (currentSlotIndex != -1) {
-		// Storage already assigned to this CPU
-		// Note: Currently, this can only happen with a weakreduction task with
-		// 2 or more (in_final) reduction subtasks that will be requesting storage
-		// Note: Task scheduling points within reduction are currently not supported,
-		// as tied tasks are not yet implemented. If supported, task counters would be
-		// required to avoid the storage to be released at the end of a task while still in use
-
-		assert(_slots[currentSlotIndex].initialized);
-		return currentSlotIndex;
-	}
 
-	int freeSlotIndex = _freeSlotIndices.setFirst();
-	while (freeSlotIndex == -1)
-		freeSlotIndex = _freeSlotIndices.setFirst();
+	// Each CPU always uses its own slot. Tasks are tied and scheduling points
+	// within reduction tasks are not supported, so a slot is never accessed
+	// concurrently by two tasks
+	size_t cpuId = destinationComputePlace->getIndex();
+	assert(cpuId < _slots.size());
 
-	_currentCpuSlotIndices[cpuId] = freeSlotIndex;
-
-	return freeSlotIndex;
+	return cpuId;
 }
 
-void HostReductionStorage::releaseSlotsInUse(__attribute__((unused)) Task *task, ComputePlace *computePlace)
+void HostReductionStorage::releaseSlotsInUse(__attribute__((unused)) Task *task,
+	__attribute__((unused)) ComputePlace *computePlace)
 {
 	assert(computePlace->getType() == nanos6_host_device);
-	size_t cpuId = computePlace->getIndex();
-	assert(cpuId < _currentCpuSlotIndices.size());
-	long int currentSlotIndex = _currentCpuSlotIndices[cpuId];
-
-	// Note: If access is weak and final (promoted), but had no reduction subtasks, this
-	// member can be called when _currentCpuSlotIndices[task] is invalid (hasn't been used)
-	if (currentSlotIndex != -1) {
-		assert(_slots[currentSlotIndex].storage != nullptr);
-		assert(_slots[currentSlotIndex].initialized);
-		_freeSlotIndices.reset(currentSlotIndex);
-		_currentCpuSlotIndices[cpuId] = -1;
-	}
+
+	// The slots stay bound to their CPUs, and their private copies are kept
+	// initialized for the following tasks, until the reduction is combined
 }
@@ -1,20 +1,31 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2019-2021 Barcelona Supercomputing Center (BSC)
 */
 
 #ifndef HOST_REDUCTION_STORAGE_HPP
 #define HOST_REDUCTION_STORAGE_HPP
 
 #include "dependencies/discrete/DeviceReductionStorage.hpp"
-#include "support/bitset/AtomicBitset.hpp"
+#include "lowlevel/Padding.hpp"
 
+class CPU;
+
+//! \brief Private copies of a reduction on the host CPUs
+//!
+//! Each CPU owns a slot for the whole lifetime of the reduction, so that the
+//! tasks and taskfor chunks that participate in it do not have to claim and
+//! release slots. The private copy of a slot is allocated and initialized by
+//! its own CPU the first time it is needed, which places it on the NUMA node
+//! of the CPU. Since only the owner CPU accesses its slot until the reduction
+//! is combined, the slots do not need atomic operations
 class HostReductionStorage : public DeviceReductionStorage {
 public:
 	struct ReductionSlot {
 		void *storage = nullptr;
 		bool initialized = false;
+		CPU *cpu = nullptr;
 	};
 
 	typedef ReductionSlot slot_t;
@@ -33,10 +44,21 @@ public:
 
 	~HostReductionStorage(){};
 
+	//! \brief Combine a set of slots into the first one and free the rest
+	//!
+	//! \param[in] slots The initialized slots of a NUMA node
+	void combineNodeSlots(const std::vector<slot_t *> &slots);
+
 private:
-	std::vector<slot_t> _slots;
-	std::vector<long int> _currentCpuSlotIndices;
-	AtomicBitset<> _freeSlotIndices;
+	//! Minimum amount of data in the private copies of each NUMA node to
+	//! combine the NUMA nodes in parallel
+	static constexpr size_t _parallelCombineThreshold = 4 * 1024 * 1024;
+
+	//! The slots of the CPUs, indexed by the CPU index
+	std::vector<Padded<slot_t>> _slots;
+
+	//! \brief Free the private copy of a slot
+	void freeSlot(slot_t &slot);
 };
 
-#endif // HOST_REDUCTION_STORAGE_HPP
\ No newline at end of file
+#endif // HOST_REDUCTION_STORAGE_HPP
@@ -48,6 +48,7 @@
 #include "ClusterTaskContext.hpp"
 #include <ClusterUtil.hpp>
 #include "cluster/NodeNamespace.hpp"
+#include "TaskOffloading.hpp"
 #endif
 
 #pragma GCC visibility push(hidden)
@@ -1776,6 +1777,11 @@ namespace DataAccessRegistration {
 	{
 		processSatisfiedCommutativeOriginators(hpDependencyData);
 
+#ifdef USE_CLUSTER
+		// The originators offloaded to the same node are sent in a single message
+		TaskOffloading::OffloadBatchScope offloadBatch;
+#endif
+
 		// NOTE: This is done without the lock held and may be slow since it can enter the scheduler
 		for (Task *satisfiedOriginator : hpDependencyData._satisfiedOriginators) {
 			assert(satisfiedOriginator != 0);
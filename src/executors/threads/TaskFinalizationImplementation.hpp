@@ -220,13 +220,11 @@ void TaskFinalization::disposeTask(Task *task)
 			}
 
 			// Non disposable tasks like Taskforsource require a new workflow when they are
-			// reconstructed. SO we need to clear the old workflow here and set the tasks' pointer
-			// to nullptr. Then when added again throw executeTask a new forkflow will be recreated.
-			// Disposable tasks delete the workflow in the task's destructor.
-			if (task->getWorkflow() != nullptr) {
+			// reconstructed. So we need to clear the workflow mark here. Then when added again
+			// through executeTask a new workflow will be recreated.
+			if (task->hasWorkflow()) {
 				assert(task->getExecutionStep() == nullptr);
-				delete task->getWorkflow();
-				task->setWorkflow(nullptr);
+				task->setWorkflowCreated(false);
 			}
 		}
 
@@ -18,6 +18,54 @@
 #include "ThreadManager.hpp"
 #include "executors/threads/WorkerThread.hpp"
 #include "hardware/HardwareInfo.hpp"
+#include "lowlevel/threads/HelperThread.hpp"
+#include "support/config/ConfigVariable.hpp"
+
+#include <InstrumentThreadManagement.hpp>
+
+
+//! \brief Create and resume the initial worker threads of a subset of CPUs
+//!
+//! \param[in] cpus the CPUs that need an initial worker thread
+//! \param[in] first the position of the first CPU of the subset
+//! \param[in] stride the distance between the CPUs of the subset
+static void createInitialThreadsSubset(const std::vector<CPU *> &cpus, size_t first, size_t stride)
+{
+	for (size_t i = first; i < cpus.size(); i += stride) {
+		CPU *cpu = cpus[i];
+		assert(cpu != nullptr);
+
+		WorkerThread *initialThread = ThreadManager::createWorkerThread(cpu);
+		assert(initialThread != nullptr);
+		initialThread->resume(cpu, true);
+	}
+}
+
+//! \brief A helper thread that creates part of the initial worker threads
+class BringupThread : public HelperThread {
+	const std::vector<CPU *> &_cpus;
+	size_t _first;
+	size_t _stride;
+
+public:
+	BringupThread(const std::vector<CPU *> &cpus, size_t first, size_t stride) :
+		HelperThread("bringup-thread"),
+		_cpus(cpus),
+		_first(first),
+		_stride(stride)
+	{
+	}
+
+	void body()
+	{
+		initializeHelperThread();
+		Instrument::threadHasResumed(getInstrumentationId());
+
+		createInitialThreadsSubset(_cpus, _first, _stride);
+
+		Instrument::threadWillShutdown(getInstrumentationId());
+	}
+};
 
 
 ThreadManager::IdleThreads *ThreadManager::_idleThreads;
@@ -110,3 +158,30 @@ void ThreadManager::addShutdownThread(WorkerThread *shutdownThread)
 	CPUManager::addShutdownCPU(cpu);
 }
 
+void ThreadManager::createInitialThreads(const std::vector<CPU *> &cpus)
+{
+	// By default, use one thread per NUMA node, including the current one
+	ConfigVariable<size_t> bringupThreadsConfig("cpumanager.bringup_threads");
+	size_t numBringupThreads = bringupThreadsConfig;
+	if (numBringupThreads == 0) {
+		numBringupThreads = HardwareInfo::getValidMemoryPlaceCount(nanos6_device_t::nanos6_host_device);
+	}
+	numBringupThreads = std::min(std::max(numBringupThreads, (size_t) 1), std::max(cpus.size(), (size_t) 1));
+
+	// The current thread creates its share after starting the helpers
+	std::vector<BringupThread *> bringupThreads;
+	for (size_t i = 1; i < numBringupThreads; ++i) {
+		BringupThread *bringupThread = new BringupThread(cpus, i, numBringupThreads);
+		assert(bringupThread != nullptr);
+
+		bringupThread->start(nullptr);
+		bringupThreads.push_back(bringupThread);
+	}
+
+	createInitialThreadsSubset(cpus, 0, numBringupThreads);
+
+	for (BringupThread *bringupThread : bringupThreads) {
+		bringupThread->join();
+		delete bringupThread;
+	}
+}
@@ -93,6 +93,13 @@ public:
 
 	static void addShutdownThread(WorkerThread *shutdownThread);
 
+	//! \brief create and resume the initial worker thread of each CPU
+	//! The threads are created in parallel by several helper threads
+	//! depending on the cpumanager.bringup_threads option
+	//!
+	//! \param[in] cpus the CPUs that need an initial worker thread
+	static void createInitialThreads(const std::vector<CPU *> &cpus);
+
 	friend class ThreadManagerDebuggingInterface;
 	friend struct CPUThreadingModelData;
 };
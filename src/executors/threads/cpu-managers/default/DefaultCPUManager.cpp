@@ -153,6 +153,9 @@ void DefaultCPUManager::preinitialize()
 
 void DefaultCPUManager::initialize()
 {
+	std::vector<CPU *> workerCPUs;
+	workerCPUs.reserve(_cpus.size());
+
 	for (size_t id = 0; id < _cpus.size(); ++id) {
 		CPU *cpu = _cpus[id];
 		assert(cpu != nullptr);
@@ -164,12 +167,13 @@ void DefaultCPUManager::initialize()
 			// reserve last CPU for the leader thread (not CPU zero which
 			// always runs main when running with Extrae)
 		} else {
-			WorkerThread *initialThread = ThreadManager::createWorkerThread(cpu);
-			assert(initialThread != nullptr);
-			initialThread->resume(cpu, true);
+			workerCPUs.push_back(cpu);
 		}
 	}
 
+	// Create the initial worker threads in parallel
+	ThreadManager::createInitialThreads(workerCPUs);
+
 	_finishedCPUInitialization = true;
 }
 
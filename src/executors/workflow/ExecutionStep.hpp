@@ -7,11 +7,10 @@
 #ifndef EXECUTION_STEP_HPP
 #define EXECUTION_STEP_HPP
 
-#include <functional>
-
 #include "dependencies/DataAccessType.hpp"
 #include "lowlevel/SpinLock.hpp"
 
+#include <cassert>
 #include <mutex>
 #include <vector>
 #include <DataAccessRegion.hpp>
@@ -29,19 +28,31 @@ namespace ExecutionWorkflow {
 
 	// NOTE: objects of this class self-destruct when they finish
 	class Step {
+	public:
+		//! The maximum number of successors of a Step. Only the execution
+		//! Step of a task has two successors, the release and notification
+		//! Steps; all the other Steps have at most one
+		static const int MAX_SUCCESSORS = 2;
+
 	protected:
 		//! pending previous steps
 		int _countdownToRelease;
 
-		//! list of successor Steps
-		std::vector<Step *> _successors;
+		//! successor Steps, stored inline to avoid allocating a container
+		//! for each Step
+		Step *_successors[MAX_SUCCESSORS];
+		int _numSuccessors;
+
+		//! next root Step of the Workflow that contains this Step
+		Step *_nextRoot;
 
 		//! lock to protect access to _successors
-		//! TODO: maybe it makes sense to create an AtomicVector type
 		SpinLock _lock;
 
+		friend class Workflow;
+
 	public:
-		Step() : _countdownToRelease(0), _successors(), _lock()
+		Step() : _countdownToRelease(0), _numSuccessors(0), _nextRoot(nullptr), _lock()
 		{
 		}
 
@@ -60,7 +71,21 @@ namespace ExecutionWorkflow {
 		inline void addSuccessor(Step *step)
 		{
 			std::lock_guard<SpinLock> guard(_lock);
-			_successors.push_back(step);
+			assert(_numSuccessors < MAX_SUCCESSORS);
+			_successors[_numSuccessors++] = step;
+		}
+
+		//! \brief Get the number of successor Steps
+		inline int getNumSuccessors() const
+		{
+			return _numSuccessors;
+		}
+
+		//! \brief Get a successor Step
+		inline Step *getSuccessor(int index) const
+		{
+			assert(index < _numSuccessors);
+			return _successors[index];
 		}
 
 		//! \brief Decrease the number of predecessors and start the Step execution
@@ -82,7 +107,7 @@ namespace ExecutionWorkflow {
 			/* Commenting out the following lock, because it is
 			 * actually not needed and it might lead to a deadlock.
 			 * At this point, the Workflow is created and the
-			 * _successors vector will not be further modified. */
+			 * _successors array will not be further modified. */
 
 			/*
 			 * Actually it must not take the lock because
@@ -90,7 +115,8 @@ namespace ExecutionWorkflow {
 			 * lock.
 			 */
 			//std::lock_guard<SpinLock> guard(_lock);
-			for (auto step: _successors) {
+			for (int i = 0; i < _numSuccessors; ++i) {
+				Step *step = _successors[i];
 				if (step->release()) {
 					step->start();
 				}
@@ -103,6 +129,13 @@ namespace ExecutionWorkflow {
 			return (_countdownToRelease == 0);
 		}
 
+		//! \brief Returns true if the Step is a ClusterDataCopyStep, whose
+		//! data fetches are grouped when the Workflow starts
+		virtual inline bool isClusterDataCopy() const
+		{
+			return false;
+		}
+
 		//! \brief start the execution of a Step
 		virtual inline void start()
 		{
@@ -208,24 +241,52 @@ namespace ExecutionWorkflow {
 		}
 	};
 
-	class NotificationStep : public Step {
-		std::function<void ()> const _callback;
+	//! Notifies that a task has finished its execution and releases its
+	//! accesses. Objects of this class come from the ObjectAllocator
+	class TaskNotificationStep : public Step {
+		Task * const _task;
+		MemoryPlace * const _memoryPlace;
+
 	public:
-		NotificationStep(std::function<void ()> const &callback)
-			: Step(), _callback(callback)
+		TaskNotificationStep(Task *task, MemoryPlace *memoryPlace)
+			: Step(), _task(task), _memoryPlace(memoryPlace)
 		{
 		}
 
 		//! start the execution of the Step
-		inline void start() override
+		void start() override;
+	};
+
+	//! Notifies that a taskfor collaborator has finished its chunk.
+	//! Collaborators do not go through the dependency system. Objects of
+	//! this class come from the ObjectAllocator
+	class CollaboratorNotificationStep : public Step {
+		Task * const _task;
+
+	public:
+		CollaboratorNotificationStep(Task *task)
+			: Step(), _task(task)
 		{
-			if (_callback) {
-				_callback();
-			}
+		}
 
-			releaseSuccessors();
-			delete this;
+		//! start the execution of the Step
+		void start() override;
+	};
+
+	//! Releases a taskwait fragment once its data has been copied. Objects
+	//! of this class come from the ObjectAllocator
+	class TaskwaitNotificationStep : public Step {
+		Task * const _task;
+		DataAccessRegion const _region;
+
+	public:
+		TaskwaitNotificationStep(Task *task, DataAccessRegion const &region)
+			: Step(), _task(task), _region(region)
+		{
 		}
+
+		//! start the execution of the Step
+		void start() override;
 	};
 
 }
@@ -24,6 +24,7 @@
 #include <ExecutionWorkflowCluster.hpp>
 #include <ClusterManager.hpp>
 #include <InstrumentDependencySubsystemEntryPoints.hpp>
+#include <ObjectAllocator.hpp>
 #include "CPUDependencyData.hpp"
 
 namespace ExecutionWorkflow {
@@ -51,9 +52,8 @@ namespace ExecutionWorkflow {
 			* of the following types. This essentially mean that devices,
 			* e.g. Cluster, CUDA, do not support these accesses. */
 		if (access->getType() == REDUCTION_ACCESS_TYPE) {
-			step = new Step();
 			Instrument::exitCreateDataCopyStep(isTaskwait);
-			return step;
+			return nullptr;
 		}
 
 		assert(targetMemoryPlace != nullptr);
@@ -117,9 +117,9 @@ namespace ExecutionWorkflow {
 	{
 		switch(computePlace->getType()) {
 			case nanos6_host_device:
-				return new HostExecutionStep(task, computePlace);
+				return ObjectAllocator<HostExecutionStep>::newObject(task, computePlace);
 			case nanos6_cluster_device:
-				return new ClusterExecutionStep(task, computePlace);
+				return ObjectAllocator<ClusterExecutionStep>::newObject(task, computePlace);
 			default:
 				FatalErrorHandler::fail("Execution workflow does not support this device yet");
 				return nullptr;
@@ -129,29 +129,38 @@ namespace ExecutionWorkflow {
 	DataReleaseStep *Workflow::createDataReleaseStep(Task *task)
 	{
 		if (task->isRemoteTask()) {
-			return new ClusterDataReleaseStep(task->getClusterContext(), task);
+			return ObjectAllocator<ClusterDataReleaseStep>::newObject(task->getClusterContext(), task);
 		}
 
-		return new DataReleaseStep(task);
+		return nullptr;
 	}
 
 
 	void Workflow::start()
 	{
-		std::map<MemoryPlace const*, size_t> fragments;
-		std::map<MemoryPlace const*, std::vector<ClusterDataCopyStep *>> groups;
-
-		// Iterate over all the rootSteps. There will be null copies
-		for (Step *step : _rootSteps) {
-
-			ClusterDataCopyStep *clusterCopy = dynamic_cast<ClusterDataCopyStep *>(step);
-
-			// It is a null copy or some other type.
-			if (!clusterCopy) {
+		// The data fetches from the same source are grouped in a single
+		// request. There are usually very few sources, so they are looked
+		// up linearly
+		struct FetchGroup {
+			MemoryPlace const *_source;
+			size_t _numFragments;
+			std::vector<ClusterDataCopyStep *> _steps;
+		};
+		std::vector<FetchGroup> groups;
+
+		Step *step = _firstRoot;
+		while (step != nullptr) {
+			// Starting the step may destroy it
+			Step *next = step->_nextRoot;
+
+			if (!step->isClusterDataCopy()) {
 				step->start();
+				step = next;
 				continue;
 			}
 
+			ClusterDataCopyStep *clusterCopy = static_cast<ClusterDataCopyStep *>(step);
+
 			// It is a copy step, so group them respect to destination
 			// requiresDataFetch will inmediately release successors when
 			// (!_needsTransfer && !_isTaskwait)
@@ -159,28 +168,138 @@ namespace ExecutionWorkflow {
 				assert(clusterCopy->getTargetMemoryPlace()
 					== ClusterManager::getCurrentMemoryNode());
 
-				MemoryPlace const* source = clusterCopy->getSourceMemoryPlace();
+				MemoryPlace const *source = clusterCopy->getSourceMemoryPlace();
+
+				FetchGroup *group = nullptr;
+				for (FetchGroup &candidate : groups) {
+					if (candidate._source == source) {
+						group = &candidate;
+						break;
+					}
+				}
 
-				fragments[source] += clusterCopy->getNumFragments();
-				groups[source].push_back(clusterCopy);
+				if (group == nullptr) {
+					groups.push_back({source, 0, {}});
+					group = &groups.back();
+				}
+
+				group->_numFragments += clusterCopy->getNumFragments();
+				group->_steps.push_back(clusterCopy);
 			}
+
+			step = next;
 		}
 
-		for (auto const& it : groups) {
-			MemoryPlace const* source = it.first;
+		_firstRoot = nullptr;
+		_lastRoot = nullptr;
 
-			// Instrument::logMessage(
-			// 	Instrument::ThreadInstrumentationContext::getCurrent(),
-			// 	"ClusterDataCopyStep for:", _region,
-			// 	" from Node:", source,
-			// 	" to Node:", ClusterManager::getCurrentMemoryNode()
-			// );
+		for (FetchGroup const &group : groups) {
+			ClusterManager::fetchVector(group._numFragments, group._steps, group._source);
+		}
+	}
 
-			ClusterManager::fetchVector(fragments[source], it.second, source);
+	//! \brief Notify that a task has finished and release its accesses
+	static inline void notifyTaskFinished(Task *task, MemoryPlace *targetMemoryPlace)
+	{
+		WorkerThread *currThread = WorkerThread::getCurrentWorkerThread();
+		CPU * const cpu = (currThread == nullptr) ? nullptr : currThread->getComputePlace();
+
+		// For offloaded tasks with cluster.disable_autowait=false, handle
+		// the early release of dependencies propagated in the namespace. All
+		// other dependencies will be handled using the normal "wait" mechanism.
+		CPUDependencyData localDependencyData;
+		CPUDependencyData &hpDependencyData =
+			(cpu == nullptr) ? localDependencyData : cpu->getDependencyData();
+
+		DataAccessRegistration::unregisterLocallyPropagatedTaskDataAccesses(
+			task,
+			cpu,
+			hpDependencyData);
+
+		if (task->markAsFinished(cpu)) {
+			DataAccessRegistration::unregisterTaskDataAccesses(
+				task,
+				cpu, /*cpu, */
+				hpDependencyData,
+				targetMemoryPlace,
+				false,
+				// For clusters, finalize this task and send the MessageTaskFinished
+				// BEFORE propagating satisfiability to any other tasks. This is to
+				// avoid potentially sending the MessageTaskFinished messages out of
+				// order
+				[&]() -> void {
+					TaskFinalization::taskFinished(task, cpu);
+					if (task->markAsReleased()) {
+						TaskFinalization::disposeTask(task);
+					}
+				}
+			);
 		}
 	}
 
+	//! \brief Notify that a taskfor collaborator has finished
+	static inline void notifyCollaboratorFinished(Task *task)
+	{
+		WorkerThread *currThread = WorkerThread::getCurrentWorkerThread();
+		CPU * const cpu = (currThread == nullptr) ? nullptr : currThread->getComputePlace();
 
+		if (task->markAsFinished(cpu)) {
+			TaskFinalization::taskFinished(task, cpu);
+			if (task->markAsReleased()) {
+				TaskFinalization::disposeTask(task);
+			}
+		}
+	}
+
+	//! \brief Release a taskwait fragment whose data is already in place
+	static inline void notifyTaskwaitFragmentCopied(Task *task, DataAccessRegion const &region)
+	{
+		/* We cannot re-use the 'computePlace', we need to
+		 * retrieve the current Thread and associated
+		 * ComputePlace */
+		WorkerThread *releasingThread = WorkerThread::getCurrentWorkerThread();
+
+		ComputePlace *releasingComputePlace =
+			(releasingThread == nullptr) ? nullptr : releasingThread->getComputePlace();
+
+		/* Here, we are always using a local CPUDependencyData
+		 * object, to avoid the issue where we end-up calling
+		 * this while the thread is already in the dependency
+		 * system, using the CPUDependencyData of its
+		 * ComputePlace. This is a *TEMPORARY* solution, until
+		 * we fix how we handle taskwaits in a more clean
+		 * way. */
+		CPUDependencyData localDependencyData;
+
+		DataAccessRegistration::releaseTaskwaitFragment(
+			task,
+			region,
+			releasingComputePlace,
+			localDependencyData,
+			true
+		);
+	}
+
+	void TaskNotificationStep::start()
+	{
+		notifyTaskFinished(_task, _memoryPlace);
+		releaseSuccessors();
+		ObjectAllocator<TaskNotificationStep>::deleteObject(this);
+	}
+
+	void CollaboratorNotificationStep::start()
+	{
+		notifyCollaboratorFinished(_task);
+		releaseSuccessors();
+		ObjectAllocator<CollaboratorNotificationStep>::deleteObject(this);
+	}
+
+	void TaskwaitNotificationStep::start()
+	{
+		notifyTaskwaitFragmentCopied(_task, _region);
+		releaseSuccessors();
+		ObjectAllocator<TaskwaitNotificationStep>::deleteObject(this);
+	}
 
 	void executeTask(Task *task, ComputePlace *targetComputePlace, MemoryPlace *targetMemoryPlace)
 	{
@@ -193,12 +312,12 @@ namespace ExecutionWorkflow {
 		// This will expose some nasty errors difficult to debug latter. TaskforSource only comes
 		// here twise. When creating the workflow and when deleting the executionStep and releasing
 		// the notificationStep.
-		if (task->isTaskforSource() && task->getWorkflow() != nullptr) {
+		if (task->isTaskforSource() && task->hasWorkflow()) {
 			assert(task->getExecutionStep() != nullptr);
 		}
 #endif
 
-		if (task->getWorkflow() != nullptr) {
+		if (task->hasWorkflow()) {
 			ExecutionWorkflow::Step *executionStep = task->getExecutionStep();
 
 			if (executionStep == nullptr) {
@@ -207,9 +326,7 @@ namespace ExecutionWorkflow {
 				 * for its children to complete. The notification step has
 				 * already been executed, but markAsFinished returned false.
 				 * Now, finally, the wait clause is done, the accesses can be
-				 * unregistered and the task disposed. NOTE:
-				 * task->getWorkflow() is actually a dangling pointer as the
-				 * workflow has already been deleted.
+				 * unregistered and the task disposed.
 				 */
 
 				assert(task->mustDelayRelease());
@@ -269,84 +386,12 @@ namespace ExecutionWorkflow {
 		//! MemoryPlace.
 		task->setMemoryPlace(targetMemoryPlace);
 
-		// int numSymbols = task->getSymbolNum();
-		Workflow *workflow = new Workflow();
-
-		Step *executionStep = workflow->createExecutionStep(task, targetComputePlace);
-
-		Step *notificationStep = nullptr;
-
-
-		if (task->isTaskforCollaborator()) {
-			// Now we only support host's taskfor because they are not offloaded (yet).
-			assert(targetComputePlace->getType() == nanos6_host_device);
-
-			// For collaborators don't go to the Dependency System. It is simpler as they don't have
-			// dependencies.
-			notificationStep = new NotificationStep(
-				[task]() -> void {
-					WorkerThread *currThread = WorkerThread::getCurrentWorkerThread();
-					CPU * const cpu = (currThread == nullptr) ? nullptr : currThread->getComputePlace();
-
-					if (task->markAsFinished(cpu)) {
-						TaskFinalization::taskFinished(task, cpu);
-						if (task->markAsReleased()) {
-							TaskFinalization::disposeTask(task);
-						}
-					}
-				}
-			);
-		} else {
-			// At the moment we only support host and cluster devices.
-			assert(targetComputePlace->getType() == nanos6_host_device
-				||targetComputePlace->getType() == nanos6_cluster_device);
-
-			notificationStep = new NotificationStep(
-				[task, targetComputePlace, targetMemoryPlace]() -> void {
-					WorkerThread *currThread = WorkerThread::getCurrentWorkerThread();
-					CPU * const cpu = (currThread == nullptr) ? nullptr : currThread->getComputePlace();
-
-					// For offloaded tasks with cluster.disable_autowait=false, handle
-					// the early release of dependencies propagated in the namespace. All
-					// other dependencies will be handled using the normal "wait" mechanism.
-					CPUDependencyData localDependencyData;
-					CPUDependencyData &hpDependencyData =
-						(cpu == nullptr) ? localDependencyData : cpu->getDependencyData();
-
-					DataAccessRegistration::unregisterLocallyPropagatedTaskDataAccesses(
-						task,
-						cpu,
-						hpDependencyData);
-
-					if (task->markAsFinished(cpu)) {
-						DataAccessRegistration::unregisterTaskDataAccesses(
-							task,
-							cpu, /*cpu, */
-							hpDependencyData,
-							targetMemoryPlace,
-							false,
-							// For clusters, finalize this task and send the MessageTaskFinished
-							// BEFORE propagating satisfiability to any other tasks. This is to
-							// avoid potentially sending the MessageTaskFinished messages out of
-							// order
-							[&]() -> void {
-								TaskFinalization::taskFinished(task, cpu);
-								if (task->markAsReleased()) {
-									TaskFinalization::disposeTask(task);
-								}
-							}
-						);
-
-					}
-				}
-			);
-		}
+		// The Workflow is only needed while the Steps are created and started
+		Workflow workflow;
 
 		// TODO: Once we have correct management for the Task symbols here we should create the
 		// corresponding allocation steps.
-		DataReleaseStep *releaseStep = workflow->createDataReleaseStep(task);
-		workflow->enforceOrder(executionStep, releaseStep);
-		workflow->enforceOrder(releaseStep, notificationStep);
+		DataReleaseStep *releaseStep = workflow.createDataReleaseStep(task);
 
 		// We must use local dependency data here, not the CPU's dependency data. This is because
 		// we may currently be creating the workflow for an offloaded task, which happens inside
@@ -400,7 +445,7 @@ namespace ExecutionWorkflow {
 					delete homeNodes;
 				}
 #endif
-				Step *dataCopyRegionStep = workflow->createDataCopyStep(
+				Step *dataCopyRegionStep = workflow.createDataCopyStep(
 					currLocation,
 					targetMemoryPlace,
 					region,
@@ -409,29 +454,82 @@ namespace ExecutionWorkflow {
 					hpDependencyData2
 				);
 
-				workflow->enforceOrder(dataCopyRegionStep, executionStep);
-				workflow->addRootStep(dataCopyRegionStep);
+				workflow.addRootStep(dataCopyRegionStep);
 
-				releaseStep->addAccess(dataAccess);
+				if (releaseStep != nullptr) {
+					releaseStep->addAccess(dataAccess);
+				}
 
 				return true;
 			}
 		);
 
+		task->setWorkflowCreated(true);
+		task->setComputePlace(targetComputePlace);
 
-		if (executionStep->ready()) {
-			workflow->enforceOrder(executionStep, notificationStep);
-			workflow->addRootStep(executionStep);
-		}
+		WorkerThread *createCurrThread = WorkerThread::getCurrentWorkerThread();
+		CPU * const createCpu = (createCurrThread == nullptr) ? nullptr : createCurrThread->getComputePlace();
+
+		if (!workflow.hasRootSteps()
+			&& releaseStep == nullptr
+			&& targetComputePlace->getType() == nanos6_host_device
+			&& !task->isTaskforSource()
+			&& createCpu != nullptr
+			&& createCurrThread->getTask() == task) {
+			// Fast path: the task does not need any data copy and the current
+			// thread is the one that must run it. Run it and notify its end
+			// right away, without creating any Step. Taskfor sources are not
+			// eligible, since their execution step is kept while they are
+			// rescheduled for the collaborators
+			runHostTask(task, createCurrThread, createCpu);
+
+			if (task->isTaskforCollaborator()) {
+				notifyCollaboratorFinished(task);
+			} else {
+				notifyTaskFinished(task, targetMemoryPlace);
+			}
+		} else {
+			Step *executionStep = workflow.createExecutionStep(task, targetComputePlace);
 
-		task->setWorkflow(workflow);
-		task->setComputePlace(targetComputePlace);
+			Step *notificationStep = nullptr;
+			if (task->isTaskforCollaborator()) {
+				// Now we only support host's taskfor because they are not offloaded (yet).
+				assert(targetComputePlace->getType() == nanos6_host_device);
+
+				// For collaborators don't go to the Dependency System. It is simpler as they don't have
+				// dependencies.
+				notificationStep = ObjectAllocator<CollaboratorNotificationStep>::newObject(task);
+			} else {
+				// At the moment we only support host and cluster devices.
+				assert(targetComputePlace->getType() == nanos6_host_device
+					||targetComputePlace->getType() == nanos6_cluster_device);
+
+				notificationStep = ObjectAllocator<TaskNotificationStep>::newObject(task, targetMemoryPlace);
+			}
+
+			// The task executes after all its data copies
+			workflow.enforceOrderAfterRootSteps(executionStep);
 
-		// Starting the workflow will either execute the task to
-		// completion (if there are not pending transfers for the
-		// task), or it will setup all the Execution Step will
-		// execute when ready.
-		workflow->start();
+			if (releaseStep != nullptr) {
+				workflow.enforceOrder(executionStep, releaseStep);
+				workflow.enforceOrder(releaseStep, notificationStep);
+				if (executionStep->ready()) {
+					workflow.enforceOrder(executionStep, notificationStep);
+				}
+			} else {
+				workflow.enforceOrder(executionStep, notificationStep);
+			}
+
+			if (executionStep->ready()) {
+				workflow.addRootStep(executionStep);
+			}
+
+			// Starting the workflow will either execute the task to
+			// completion (if there are not pending transfers for the
+			// task), or it will setup all the Execution Step will
+			// execute when ready.
+			workflow.start();
+		}
 
 		// There may be some delayed operations from setLocationFromWorkflow, which
 		// is called when a data transfer is not created because it is found by
@@ -477,43 +575,10 @@ namespace ExecutionWorkflow {
 			return;
 		}
 
-		Workflow *workflow = new Workflow();
-
-
-		Step *notificationStep = new NotificationStep(
-			[task, region, workflow]() -> void {
-				/* We cannot re-use the 'computePlace', we need to
-				 * retrieve the current Thread and associated
-				 * ComputePlace */
-				WorkerThread *releasingThread = WorkerThread::getCurrentWorkerThread();
-
-				ComputePlace *releasingComputePlace =
-					(releasingThread == nullptr) ? nullptr : releasingThread->getComputePlace();
-
-				/* Here, we are always using a local CPUDependencyData
-				 * object, to avoid the issue where we end-up calling
-				 * this while the thread is already in the dependency
-				 * system, using the CPUDependencyData of its
-				 * ComputePlace. This is a *TEMPORARY* solution, until
-				 * we fix how we handle taskwaits in a more clean
-				 * way. */
-				CPUDependencyData localDependencyData;
-
-				DataAccessRegistration::releaseTaskwaitFragment(
-					task,
-					region,
-					releasingComputePlace,
-					localDependencyData,
-					true
-				);
-
-				delete workflow;
-			}
-		);
-
 		MemoryPlace const *currLocation = taskwaitFragment->getLocation();
 
-		Step *copyStep = workflow->createDataCopyStep(
+		Workflow workflow;
+		Step *copyStep = workflow.createDataCopyStep(
 			currLocation,
 			targetLocation,
 			region,
@@ -522,9 +587,17 @@ namespace ExecutionWorkflow {
 			hpDependencyData
 		);
 
-		workflow->addRootStep(copyStep);
-		workflow->enforceOrder(copyStep, notificationStep);
-		workflow->start();
+		if (copyStep == nullptr) {
+			// The data is already in place
+			notifyTaskwaitFragmentCopied(task, region);
+		} else {
+			Step *notificationStep = ObjectAllocator<TaskwaitNotificationStep>::newObject(task, region);
+
+			workflow.addRootStep(copyStep);
+			workflow.enforceOrder(copyStep, notificationStep);
+			workflow.start();
+		}
+
 		Instrument::exitSetupTaskwaitWorkflow();
 	}
 
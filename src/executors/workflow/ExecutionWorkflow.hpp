@@ -36,17 +36,31 @@ namespace ExecutionWorkflow {
 		__attribute__((unused))DataAccess *access,
 		__attribute__((unused))CPUDependencyData &hpDependencyData
 	) {
-		return new Step();
+		// Nothing to copy, so there is no need for a Step
+		return nullptr;
 	}
 
 	extern transfers_map_t _transfersMap;
 
+	//! A Workflow only lives while the Steps of a task are created and
+	//! started. After that, the Steps release and destroy themselves
 	class Workflow {
-		//! Root steps of the workflow
-		std::vector<Step *> _rootSteps;
+		//! Root steps of the workflow, linked through Step::_nextRoot
+		Step *_firstRoot;
+		Step *_lastRoot;
 
 	public:
 
+		Workflow() : _firstRoot(nullptr), _lastRoot(nullptr)
+		{
+		}
+
+		//! \brief Whether the Workflow has any root step
+		inline bool hasRootSteps() const
+		{
+			return (_firstRoot != nullptr);
+		}
+
 		//! \brief Creates a DataCopyStep.
 		//!
 		//! A DataCopyStep copies (if necessary) the (host-addressed)
@@ -61,6 +75,8 @@ namespace ExecutionWorkflow {
 		//!	       need to copy data to. This cannot be NULL.
 		//! \param[in] region is the memory region to copy.
 		//! \param[in] access is the DataAccess to which this copy step relates.
+		//!
+		//! \returns the copy step, or nullptr if no copy is needed
 		Step *createDataCopyStep(
 			MemoryPlace const *sourceMemoryPlace,
 			MemoryPlace const *targetMemoryPlace,
@@ -84,8 +100,12 @@ namespace ExecutionWorkflow {
 		//! A DataReleaseStep triggers events related to the release
 		//! of regions of a DataAccess
 		//!
+		//! Only remote tasks need a DataReleaseStep, since the release of
+		//! their accesses must be notified to the offloader.
+		//!
 		//! \param[in] task is the Task for which we release an access.
-		//! \param[in] access is the DataAccess that we are releasing.
+		//!
+		//! \returns the release step, or nullptr if it is not needed
 		DataReleaseStep *createDataReleaseStep(Task *task);
 
 		// \brief Enforces order between two steps of the Task execution.
@@ -110,7 +130,25 @@ namespace ExecutionWorkflow {
 		//! essentially fires the execution of those Steps.
 		inline void addRootStep(Step *root)
 		{
-			_rootSteps.push_back(root);
+			if (root == nullptr) {
+				return;
+			}
+
+			assert(root->_nextRoot == nullptr);
+			if (_lastRoot == nullptr) {
+				_firstRoot = root;
+			} else {
+				_lastRoot->_nextRoot = root;
+			}
+			_lastRoot = root;
+		}
+
+		//! \brief Make a step execute after all the current root steps
+		inline void enforceOrderAfterRootSteps(Step *successor)
+		{
+			for (Step *root = _firstRoot; root != nullptr; root = root->_nextRoot) {
+				enforceOrder(root, successor);
+			}
 		}
 
 		//! \brief Starts the execution of the workflow.
@@ -17,6 +17,7 @@
 #include "tasks/Taskfor.hpp"
 
 #include <DataAccessRegistration.hpp>
+#include <ObjectAllocator.hpp>
 #include <InstrumentInstrumentationContext.hpp>
 #include <InstrumentThreadInstrumentationContext.hpp>
 #include "cluster/hybrid/ClusterStats.hpp"
@@ -24,54 +25,20 @@
 
 namespace ExecutionWorkflow {
 
-	void HostExecutionStep::start()
+	void runHostTask(Task *task, WorkerThread *currentThread, CPU *cpu)
 	{
-		WorkerThread *currentThread = WorkerThread::getCurrentWorkerThread();
-		CPU *cpu = (currentThread == nullptr) ? nullptr : currentThread->getComputePlace();
-		Task *currentTask = (currentThread == nullptr) ? nullptr : currentThread->getTask();
-
-		//! We are trying to start the execution of the Task from within
-		//! something that is not a WorkerThread, or it does not have
-		//! a CPU or the task assigned to it.
-		//!
-		//! This will happen once the last DataCopyStep finishes and
-		//! releases the ExecutionStep.
-		//!
-		//! In that case we need to add the Task back for scheduling.
-		if (currentThread == nullptr
-			|| cpu == nullptr
-			|| currentTask == nullptr
-			|| (currentTask->isPolling() && _task != currentTask)) {
-
-			_task->setExecutionStep(this);
-		}
+		assert(task != nullptr);
+		assert(currentThread != nullptr);
+		assert(cpu != nullptr);
 
-		// We are trying to start the execution of the Task from within
-		// something that is not a WorkerThread, or it does not have
-		// a CPU or the task assigned to it
-		//
-		// This will happen once the last DataCopyStep finishes and
-		// releases the ExecutionStep
-		//
-		// In that case we need to add the Task back for scheduling
-		if ((cpu == nullptr) 
-			|| (currentThread->getTask() == nullptr)
-			|| (_task->isTaskforSource() && (_task->getExecutionStep() == nullptr))) {
-
-			_task->setExecutionStep(this);
-			Scheduler::addReadyTask(_task, nullptr, BUSY_COMPUTE_PLACE_TASK_HINT);
-
-			return;
-		}
-
-		if (_task->isRunnable()) {
-			_task->setThread(currentThread);
+		if (task->isRunnable()) {
+			task->setThread(currentThread);
 
-			if (_task->hasCode()) {
+			if (task->hasCode()) {
 				const Instrument::task_id_t taskId
-					= _task->isTaskforCollaborator()
-					? _task->getParent()->getInstrumentationTaskId()
-					: _task->getInstrumentationTaskId();
+					= task->isTaskforCollaborator()
+					? task->getParent()->getInstrumentationTaskId()
+					: task->getInstrumentationTaskId();
 
 				Instrument::ThreadInstrumentationContext instrumentationContext(
 					taskId,
@@ -85,12 +52,12 @@ namespace ExecutionWorkflow {
 				size_t tableSize = 0;
 				nanos6_address_translation_entry_t *translationTable =
 					SymbolTranslation::generateTranslationTable(
-						_task, cpu, stackTranslationTable, tableSize);
+						task, cpu, stackTranslationTable, tableSize);
 
 				ClusterStats::startTask(currentThread);
 
 				// Runtime Tracking Point - A task starts its execution
-				TrackingPoints::taskIsExecuting(_task);
+				TrackingPoints::taskIsExecuting(task);
 
 				// Register the stack unless it is the node namespace.
 				// We should not register the stack for the node namespace because
@@ -108,21 +75,21 @@ namespace ExecutionWorkflow {
 				size_t stackSize;
 				void *stackPtr = currentThread->getStackAndSize(/* OUT */ stackSize);
 				DataAccessRegion stackRegion(stackPtr, stackSize);
-				if (!_task->isNodeNamespace()) {
-					DataAccessRegistration::registerLocalAccess(_task, stackRegion, ClusterManager::getCurrentMemoryNode(), /* isStack */ true);
+				if (!task->isNodeNamespace()) {
+					DataAccessRegistration::registerLocalAccess(task, stackRegion, ClusterManager::getCurrentMemoryNode(), /* isStack */ true);
 				}
 
 				// Run the task
 				std::atomic_thread_fence(std::memory_order_acquire);
-				_task->body(translationTable);
-				if (_task->isIf0()) {
-					If0Task::executeNonInline(currentThread, _task, cpu);
+				task->body(translationTable);
+				if (task->isIf0()) {
+					If0Task::executeNonInline(currentThread, task, cpu);
 				}
 				std::atomic_thread_fence(std::memory_order_release);
 
 				// Unregister the stack
-				if (!_task->isNodeNamespace()) {
-					DataAccessRegistration::unregisterLocalAccess(_task, stackRegion, /* isStack */ true);
+				if (!task->isNodeNamespace()) {
+					DataAccessRegistration::unregisterLocalAccess(task, stackRegion, /* isStack */ true);
 				}
 
 				// Update the CPU since the thread may have migrated
@@ -130,7 +97,7 @@ namespace ExecutionWorkflow {
 				instrumentationContext.updateComputePlace(cpu->getInstrumentationId());
 
 				// Runtime Tracking Point - A task completes its execution (user code)
-				TrackingPoints::taskCompletedUserCode(_task);
+				TrackingPoints::taskCompletedUserCode(task);
 
 				// Free up all symbol translation
 				if (tableSize > 0) {
@@ -139,23 +106,66 @@ namespace ExecutionWorkflow {
 				ClusterStats::endTask(currentThread);
 			} else {
 
-				if (_task->isIf0()) {
-					If0Task::executeNonInline(currentThread, _task, cpu);
+				if (task->isIf0()) {
+					If0Task::executeNonInline(currentThread, task, cpu);
 				}
 				// Runtime Tracking Point - A task completes its execution (user code)
-				TrackingPoints::taskCompletedUserCode(_task);
+				TrackingPoints::taskCompletedUserCode(task);
 			}
 
-			DataAccessRegistration::combineTaskReductions(_task, cpu);
+			DataAccessRegistration::combineTaskReductions(task, cpu);
 		}
 
-		if (_task->getCountedAsImmovable()) {
+		if (task->getCountedAsImmovable()) {
 			ClusterHybridMetrics::incNumImmovableTasks(-1);
 		}
+	}
+
+	void HostExecutionStep::start()
+	{
+		WorkerThread *currentThread = WorkerThread::getCurrentWorkerThread();
+		CPU *cpu = (currentThread == nullptr) ? nullptr : currentThread->getComputePlace();
+		Task *currentTask = (currentThread == nullptr) ? nullptr : currentThread->getTask();
+
+		//! We are trying to start the execution of the Task from within
+		//! something that is not a WorkerThread, or it does not have
+		//! a CPU or the task assigned to it.
+		//!
+		//! This will happen once the last DataCopyStep finishes and
+		//! releases the ExecutionStep.
+		//!
+		//! In that case we need to add the Task back for scheduling.
+		if (currentThread == nullptr
+			|| cpu == nullptr
+			|| currentTask == nullptr
+			|| (currentTask->isPolling() && _task != currentTask)) {
+
+			_task->setExecutionStep(this);
+		}
+
+		// We are trying to start the execution of the Task from within
+		// something that is not a WorkerThread, or it does not have
+		// a CPU or the task assigned to it
+		//
+		// This will happen once the last DataCopyStep finishes and
+		// releases the ExecutionStep
+		//
+		// In that case we need to add the Task back for scheduling
+		if ((cpu == nullptr) 
+			|| (currentThread->getTask() == nullptr)
+			|| (_task->isTaskforSource() && (_task->getExecutionStep() == nullptr))) {
+
+			_task->setExecutionStep(this);
+			Scheduler::addReadyTask(_task, nullptr, BUSY_COMPUTE_PLACE_TASK_HINT);
+
+			return;
+		}
+
+		runHostTask(_task, currentThread, cpu);
 
 		// Release the subsequent steps
 		_task->setExecutionStep(nullptr);
 		releaseSuccessors();
-		delete this;
+		ObjectAllocator<HostExecutionStep>::deleteObject(this);
 	}
 }; // namespace ExecutionWorkflow
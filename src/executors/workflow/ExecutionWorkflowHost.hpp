@@ -8,15 +8,25 @@
 #define EXECUTION_WORKFLOW_HOST_HPP
 
 #include "ExecutionStep.hpp"
-#include <functional>
 
 class MemoryPlace;
 class ComputePlace;
+class CPU;
 class Task;
+class WorkerThread;
 struct DataAccess;
 
 namespace ExecutionWorkflow {
 
+	//! \brief Run a task on the current host thread
+	//!
+	//! \param[in] task is the Task to run
+	//! \param[in] currentThread is the WorkerThread running the task
+	//! \param[in] cpu is the CPU of the current thread
+	void runHostTask(Task *task, WorkerThread *currentThread, CPU *cpu);
+
+	//! Executes a task on the host. Objects of this class come from the
+	//! ObjectAllocator
 	class HostExecutionStep : public Step {
 		Task *_task;
 		ComputePlace *_computePlace;
@@ -19,6 +19,7 @@
 #include <TaskOffloading.hpp>
 #include "InstrumentCluster.hpp"
 #include "LiveDataTransfers.hpp"
+#include "FetchAggregator.hpp"
 
 namespace ExecutionWorkflow {
 
@@ -166,8 +167,8 @@ namespace ExecutionWorkflow {
 
 			//! The current node is the source node. We just propagate
 			//! the info we 've gathered
-			assert(_successors.size() == 1);
-			ClusterExecutionStep *execStep = dynamic_cast<ClusterExecutionStep *>(_successors[0]);
+			assert(getNumSuccessors() == 1);
+			ClusterExecutionStep *execStep = dynamic_cast<ClusterExecutionStep *>(getSuccessor(0));
 			assert(execStep != nullptr); // This asserts that the next step is the execution step
 
 			// assert(_read || _write);
@@ -269,6 +270,39 @@ namespace ExecutionWorkflow {
 	}
 
 
+	void ClusterDataCopyStep::fetchAfterStaleTransfer()
+	{
+		int id = 0;
+		DataTransfer *dataTransfer = nullptr;
+
+		bool handled = LiveDataTransfers::check(
+			[&](DataTransfer *dtPending) -> bool {
+				if (dtPending->getTarget()->getIndex() == _targetMemoryPlace->getIndex()
+					&& dtPending->getWriteID() == _writeID
+					&& _fullRegion.fullyContainedIn(dtPending->getDataAccessRegion())) {
+					dtPending->addCompletionCallback(_postcallback);
+					return true;
+				}
+				return false;
+			},
+			[&]() -> DataTransfer * {
+				id = MessageId::nextMessageId(ClusterManager::getMPIFragments(_fullRegion));
+				dataTransfer = ClusterManager::fetchDataRaw(
+					_fullRegion,
+					_sourceMemoryPlace,
+					id,
+					/* block */ false);
+				dataTransfer->setWriteID(_writeID);
+				dataTransfer->addCompletionCallback(_postcallback);
+				return dataTransfer;
+			}
+		);
+
+		if (!handled) {
+			ClusterManager::fetchFragments({FragmentInfo{_fullRegion, id, dataTransfer}}, _sourceMemoryPlace);
+		}
+	}
+
 	bool ClusterDataCopyStep::requiresDataFetch()
 	{
 		assert(ClusterManager::getCurrentMemoryNode() == _targetMemoryPlace);
@@ -299,7 +333,7 @@ namespace ExecutionWorkflow {
 
 		if (!_needsTransfer || lateWriteID) {
 			releaseSuccessors();
-			delete this;
+			ObjectAllocator<ClusterDataCopyStep>::deleteObject(this);
 			return false;
 		}
 
@@ -320,47 +354,76 @@ namespace ExecutionWorkflow {
 			);
 
 			this->releaseSuccessors();
-			delete this;
+			ObjectAllocator<ClusterDataCopyStep>::deleteObject(this);
 		};
 
 		// Now check pending data transfers because the same data transfer
 		// (or one fully containing it) may already be pending. An example
 		// would be when several tasks with an "in" dependency on the same
 		// data region are offloaded at a similar time.
-		bool allHandled = true;
-
 		DataAccessRegion region = _fullRegion;
 
-		int id = 0;
-		bool handled = LiveDataTransfers::check(
+		// This lambda is called for all pending data transfers (with the lock taken)
+		auto checkPending = [&](DataTransfer *dtPending) -> bool {
+
+			// Check whether the pending data transfer has the same target
+			// (this node) and that it fully contains the current region.
+			// Note: it is important to check that the target matches
+			// because outgoing and incoming data transfers are held in the
+			// same queue.  It is possible for an outgoing message transfer
+			// to still be in the queue because of the race condition
+			// between (a) remote task completion and triggering incoming
+			// data fetches and (b) completing the outgoing data transfer.
+
+			const MemoryPlace *pendingTarget = dtPending->getTarget();
+			assert(pendingTarget->getType() == nanos6_cluster_device);
+
+			// A transfer of another version of the data (e.g., a stale
+			// prefetch) cannot be cancelled once posted. If it writes to the
+			// same memory, fetch this version only after it completes, so it
+			// does not overwrite it, and do not register its version as local
+			const WriteID pendingWriteID = dtPending->getWriteID();
+			if (pendingWriteID != 0 && pendingWriteID != _writeID) {
+				if (pendingTarget->getIndex() == _targetMemoryPlace->getIndex()
+					&& !region.intersect(dtPending->getDataAccessRegion()).empty()) {
+					dtPending->markAsSuperseded();
+					dtPending->addCompletionCallback([this]() {
+						fetchAfterStaleTransfer();
+					});
+					return true;
+				}
+				return false;
+			}
+
+			if (pendingTarget->getIndex() == _targetMemoryPlace->getIndex()
+				&& region.fullyContainedIn(dtPending->getDataAccessRegion())) {
 
-			// This lambda is called for all pending data transfers (with the lock taken)
-			[&](DataTransfer *dtPending) {
+				// The pending data transfer contains this region: so add our callback.
+				// Return true as do not need to check any more pending transfers.
+				// Add the callback inside the lambda (with the lock taken).
+				dtPending->addCompletionCallback(_postcallback);
+				return true;
+			}
+			// Not a match: continue checking pending data transfers
+			return false;
+		};
 
-				// Check whether the pending data transfer has the same target
-				// (this node) and that it fully contains the current region.
-				// Note: it is important to check that the target matches
-				// because outgoing and incoming data transfers are held in the
-				// same queue.  It is possible for an outgoing message transfer
-				// to still be in the queue because of the race condition
-				// between (a) remote task completion and triggering incoming
-				// data fetches and (b) completing the outgoing data transfer.
+		if (ClusterPollingServices::FetchAggregator::isEnabled()) {
+			// The data transfer is created by the FetchAggregator, which may
+			// merge it with the fetches of other tasks
+			if (LiveDataTransfers::find(checkPending)) {
+				Instrument::dataFetch(Instrument::FoundInPending, region);
+				return false;
+			}
 
-				const MemoryPlace *pendingTarget = dtPending->getTarget();
-				assert(pendingTarget->getType() == nanos6_cluster_device);
+			return true;
+		}
 
-				if (pendingTarget->getIndex() == _targetMemoryPlace->getIndex()
-					&& region.fullyContainedIn(dtPending->getDataAccessRegion())) {
+		bool allHandled = true;
 
-					// The pending data transfer contains this region: so add our callback.
-					// Return true as do not need to check any more pending transfers.
-					// Add the callback inside the lambda (with the lock taken).
-					dtPending->addCompletionCallback(_postcallback);
-					return true;
-				}
-				// Not a match: continue checking pending data transfers
-				return false;
-			},
+		int id = 0;
+		bool handled = LiveDataTransfers::check(
+			checkPending,
 
 			// This lambda is called if a new data transfer is needed
 			[&]() -> DataTransfer * {
@@ -371,6 +434,7 @@ namespace ExecutionWorkflow {
 					_sourceMemoryPlace,
 					id,
 					/* block */ false);
+				dataTransfer->setWriteID(_writeID);
 				// Add the callback
 				dataTransfer->addCompletionCallback(_postcallback);
 
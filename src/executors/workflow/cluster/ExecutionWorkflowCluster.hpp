@@ -26,6 +26,7 @@
 
 #include <MessageReleaseAccess.hpp>
 #include <MessageDataSend.hpp>
+#include <ObjectAllocator.hpp>
 
 #include "executors/threads/WorkerThread.hpp"
 
@@ -155,6 +156,8 @@ namespace ExecutionWorkflow {
 		DataTransfer *_dataTransfer;
 	};
 
+	//! Fetches a region from a remote node. Objects of this class come
+	//! from the ObjectAllocator
 	class ClusterDataCopyStep : public Step {
 		//! The MemoryPlace that the data will be copied from.
 		MemoryPlace const * const _sourceMemoryPlace;
@@ -184,6 +187,10 @@ namespace ExecutionWorkflow {
 
 		DataTransfer::data_transfer_callback_t _postcallback;
 
+		//! \brief Fetch the data once a transfer of another version of it
+		//! to the same memory has completed
+		void fetchAfterStaleTransfer();
+
 	public:
 		ClusterDataCopyStep(
 			MemoryPlace const *sourceMemoryPlace,
@@ -202,6 +209,11 @@ namespace ExecutionWorkflow {
 		{
 		};
 
+		inline bool isClusterDataCopy() const override
+		{
+			return true;
+		}
+
 		bool requiresDataFetch();
 
 		MemoryPlace const *getSourceMemoryPlace() const
@@ -219,6 +231,16 @@ namespace ExecutionWorkflow {
 			return 1;
 		}
 
+		DataAccessRegion const &getRegion() const
+		{
+			return _fullRegion;
+		}
+
+		WriteID getWriteID() const
+		{
+			return _writeID;
+		}
+
 		const std::vector<FragmentInfo> &getFragments() const
 		{
 			return _regionsFragments;
@@ -230,6 +252,8 @@ namespace ExecutionWorkflow {
 		}
 	};
 
+	//! Releases the accesses of a remote task to its offloader. Objects of
+	//! this class come from the ObjectAllocator
 	class ClusterDataReleaseStep : public DataReleaseStep {
 		//! identifier of the remote task
 		OffloadedTaskId _remoteTaskIdentifier;
@@ -305,7 +329,7 @@ namespace ExecutionWorkflow {
 				ClusterManager::sendMessage(msg, _offloader);
 				_infoLock.unlock();
 
-				delete this;
+				ObjectAllocator<ClusterDataReleaseStep>::deleteObject(this);
 			}
 		}
 
@@ -379,6 +403,8 @@ namespace ExecutionWorkflow {
 		}
 	};
 
+	//! Offloads a task to a remote node. Objects of this class come from
+	//! the ObjectAllocator
 	class ClusterExecutionStep : public Step {
 	private:
 		TaskOffloading::SatisfiabilityInfoVector _satInfo;
@@ -463,8 +489,8 @@ namespace ExecutionWorkflow {
 		//! || The source and the destination is the same
 		//! || I already have the data.
 		if (source->isClusterLocalMemoryPlace()) {
-			// NULL copy (do nothing, just release succesor and delete itself.)
-			return new Step();
+			// NULL copy (nothing to do, so no Step is needed)
+			return nullptr;
 		}
 
 		if (WriteIDManager::checkWriteIDLocal(access->getWriteID(), region)) {
@@ -481,7 +507,7 @@ namespace ExecutionWorkflow {
 			if (access->readSatisfied()) {
 				DataAccessRegistration::setLocationFromWorkflow(access, ClusterManager::getCurrentMemoryNode(), hpDependencyData);
 			}
-			return new Step();
+			return nullptr;
 		}
 
 		// Helpful warning messages in debug build
@@ -568,7 +594,7 @@ namespace ExecutionWorkflow {
 			access->setOutputLocation(nullptr);
 		}
 
-		return new ClusterDataCopyStep(
+		return ObjectAllocator<ClusterDataCopyStep>::newObject(
 			source, target, inregion,
 			access->getOriginator(),
 			access->getWriteID(),
@@ -39,6 +39,12 @@ void HardwareCounters::loadConfiguration()
 	ConfigVariable<bool> pqosEnabled("hardware_counters.pqos.enabled");
 	ConfigVariable<bool> raplEnabled("hardware_counters.rapl.enabled");
 
+	if (!CompiledFeatures::hardwareCounters) {
+		FatalErrorHandler::warnIf(papiEnabled || pqosEnabled || raplEnabled,
+			"Hardware counters are not available in this runtime variant, disabling them");
+		return;
+	}
+
 	// Check which PAPI events are enabled in the config file
 	if (papiEnabled) {
 		bool papiCounterAdded = false;
@@ -214,7 +220,7 @@ void HardwareCounters::threadShutdown()
 
 void HardwareCounters::taskCreated(Task *task, bool enabled)
 {
-	if (_anyBackendEnabled) {
+	if (hardwareCountersEnabled()) {
 		assert(task != nullptr);
 
 		// After the task is created, initialize (construct) hardware counters
@@ -225,7 +231,7 @@ void HardwareCounters::taskCreated(Task *task, bool enabled)
 
 void HardwareCounters::taskReinitialized(Task *task)
 {
-	if (_anyBackendEnabled) {
+	if (hardwareCountersEnabled()) {
 		assert(task != nullptr);
 
 		TaskHardwareCounters &taskCounters = task->getHardwareCounters();
@@ -245,7 +251,7 @@ void HardwareCounters::taskReinitialized(Task *task)
 
 void HardwareCounters::taskCombineCounters(Task *parent, Task *child)
 {
-	if (_anyBackendEnabled) {
+	if (hardwareCountersEnabled()) {
 		assert(parent != nullptr);
 		assert(child != nullptr);
 
@@ -256,7 +262,7 @@ void HardwareCounters::taskCombineCounters(Task *parent, Task *child)
 
 void HardwareCounters::updateTaskCounters(Task *task)
 {
-	if (_anyBackendEnabled) {
+	if (hardwareCountersEnabled()) {
 		WorkerThread *thread = WorkerThread::getCurrentWorkerThread();
 		assert(thread != nullptr);
 		assert(task != nullptr);
@@ -285,7 +291,7 @@ void HardwareCounters::updateTaskCounters(Task *task)
 
 void HardwareCounters::updateRuntimeCounters()
 {
-	if (_anyBackendEnabled) {
+	if (hardwareCountersEnabled()) {
 		WorkerThread *thread = WorkerThread::getCurrentWorkerThread();
 		assert(thread != nullptr);
 
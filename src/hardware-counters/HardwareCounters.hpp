@@ -13,6 +13,7 @@
 #include "SupportedHardwareCounters.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
 #include "support/config/ConfigVariable.hpp"
+#include "system/CompiledFeatures.hpp"
 
 
 class Task;
@@ -83,7 +84,7 @@ public:
 	//! \brief Check whether any backend is enabled
 	static inline bool hardwareCountersEnabled()
 	{
-		return _anyBackendEnabled;
+		return CompiledFeatures::hardwareCounters && _anyBackendEnabled;
 	}
 
 	//! \brief Check whether a backend is enabled
@@ -91,7 +92,7 @@ public:
 	//! \param[in] backend The backend's id
 	static inline bool isBackendEnabled(HWCounters::backends_t backend)
 	{
-		return _enabled[backend];
+		return CompiledFeatures::hardwareCounters && _enabled[backend];
 	}
 
 	//! \brief Out of all the supported events, get the currently enabled ones
@@ -9,6 +9,8 @@
 
 #include "HardwareInfo.hpp"
 #include "hwinfo/HostInfo.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+#include "support/config/ConfigVariable.hpp"
 
 #ifdef USE_CUDA
 #include "hardware/device/cuda/CUDADeviceInfo.hpp"
@@ -16,6 +18,8 @@
 
 #ifdef USE_OPENACC
 #include "hardware/device/openacc/OpenAccDeviceInfo.hpp"
+#else
+#include "hardware/device/emulated/EmulatedDeviceInfo.hpp"
 #endif
 
 std::vector<DeviceInfo *> HardwareInfo::_infos;
@@ -33,6 +37,18 @@ void HardwareInfo::initialize()
 #ifdef USE_CUDA
 	_infos[nanos6_device_t::nanos6_cuda_device] = new CUDADeviceInfo();
 #endif
+
+	// The emulated devices take the slot of the OpenACC devices
+	ConfigVariable<bool> emulatedEnabled("devices.emulated.enabled");
+#ifdef USE_OPENACC
+	FatalErrorHandler::failIf(emulatedEnabled,
+		"Emulated devices cannot be enabled when the runtime is built with OpenACC support");
+#else
+	if (emulatedEnabled) {
+		ConfigVariable<size_t> emulatedCount("devices.emulated.count");
+		_infos[nanos6_device_t::nanos6_openacc_device] = new EmulatedDeviceInfo(emulatedCount);
+	}
+#endif
 // Fill the rest of the devices accordingly, once implemented
 }
 
@@ -13,17 +13,77 @@
 #include "tasks/TaskImplementation.hpp"
 
 #include <DataAccessRegistration.hpp>
+#include <DataAccessRegistrationImplementation.hpp>
 
-void Accelerator::runTask(Task *task)
+ConfigVariable<size_t> Accelerator::_pipelineDepth("devices.pipeline.depth");
+ConfigVariable<size_t> Accelerator::_maxInflightBytes("devices.pipeline.max_inflight_bytes");
+
+size_t Accelerator::getTaskDataSize(Task *task)
 {
-	nanos6_address_translation_entry_t stackTranslationTable[SymbolTranslation::MAX_STACK_SYMBOLS];
+	size_t bytes = 0;
+	DataAccessRegistration::processAllDataAccesses(task,
+		[&](const DataAccess *access) -> bool {
+			if (access->getType() != REDUCTION_ACCESS_TYPE && !access->isWeak()) {
+				bytes += access->getAccessRegion().getSize();
+			}
+			return true;
+		}
+	);
+	return bytes;
+}
 
+void Accelerator::stageTask(Task *task)
+{
 	assert(task != nullptr);
 	task->setComputePlace(_computePlace);
 	task->setMemoryPlace(_memoryPlace);
 
+	if (_maxInflightBytes > 0)
+		_inflightBytes += getTaskDataSize(task);
+
 	setActiveDevice();
 	generateDeviceEvironment(task);
+	prefetchTask(task);
+
+	_stagedTasks.push_back(task);
+}
+
+Task *Accelerator::getNextTask()
+{
+	// Keep the next tasks staged while the first one is launched, so that
+	// their transfers overlap with its execution
+	const size_t maxStagedTasks = _pipelineDepth + 1;
+	const size_t maxInflightBytes = _maxInflightBytes;
+
+	while (_stagedTasks.size() < maxStagedTasks && isAsyncHandleAvailable()) {
+		// Do not stage more tasks if the in-flight data exceeds the limit. The
+		// limit may be exceeded by one task, so that any task can progress
+		if (maxInflightBytes > 0 && _inflightBytes >= maxInflightBytes)
+			break;
+
+		Task *task = Scheduler::getReadyTask(_computePlace);
+		if (task == nullptr)
+			break;
+
+		stageTask(task);
+	}
+
+	if (_stagedTasks.empty())
+		return nullptr;
+
+	Task *task = _stagedTasks.front();
+	_stagedTasks.pop_front();
+	return task;
+}
+
+void Accelerator::runTask(Task *task)
+{
+	nanos6_address_translation_entry_t stackTranslationTable[SymbolTranslation::MAX_STACK_SYMBOLS];
+
+	assert(task != nullptr);
+	assert(task->getComputePlace() == _computePlace);
+
+	setActiveDevice();
 	preRunTask(task);
 
 	size_t tableSize = 0;
@@ -42,6 +102,12 @@ void Accelerator::runTask(Task *task)
 
 void Accelerator::finishTask(Task *task)
 {
+	if (_maxInflightBytes > 0) {
+		const size_t bytes = getTaskDataSize(task);
+		assert(_inflightBytes >= bytes);
+		_inflightBytes -= bytes;
+	}
+
 	finishTaskCleanup(task);
 
 	WorkerThread *currThread = WorkerThread::getCurrentWorkerThread();
@@ -7,8 +7,11 @@
 #ifndef ACCELERATOR_HPP
 #define ACCELERATOR_HPP
 
+#include <deque>
+
 #include "hardware/places/ComputePlace.hpp"
 #include "hardware/places/MemoryPlace.hpp"
+#include "support/config/ConfigVariable.hpp"
 #include "tasks/Task.hpp"
 
 
@@ -27,9 +30,23 @@ protected:
 	MemoryPlace *_memoryPlace;
 	ComputePlace *_computePlace;
 
+	// Tasks that have been staged but not launched yet, in launch order
+	std::deque<Task *> _stagedTasks;
+
+	// Bytes accessed by the staged and running tasks
+	size_t _inflightBytes;
+
+	// Number of tasks staged ahead of the task being launched
+	static ConfigVariable<size_t> _pipelineDepth;
+
+	// Maximum bytes of in-flight tasks before staging more tasks. Zero means unlimited
+	static ConfigVariable<size_t> _maxInflightBytes;
+
 	Accelerator(int handler, nanos6_device_t type) :
 		_deviceHandler(handler),
-		_deviceType(type)
+		_deviceType(type),
+		_stagedTasks(),
+		_inflightBytes(0)
 	{
 		_memoryPlace = new MemoryPlace(_deviceHandler, _deviceType);
 		_computePlace = new ComputePlace(_deviceHandler, _deviceType);
@@ -49,6 +66,27 @@ protected:
 
 	virtual void acceleratorServiceLoop() = 0;
 
+	// Check whether there are free FIFOs to stage more tasks
+	virtual bool isAsyncHandleAvailable() = 0;
+
+	// Issue the asynchronous copies of the task data to the device. They are
+	// enqueued in the FIFO of the task, so they overlap with the execution of
+	// the tasks launched before, and the task runs after them
+	virtual void prefetchTask(Task *)
+	{
+	}
+
+	// Get the size of the data accessed by a task that has to be in the device
+	static size_t getTaskDataSize(Task *task);
+
+	// Assign the task to this device, generate its environment and prefetch its data
+	void stageTask(Task *task);
+
+	// Stage ready tasks ahead of their launch, up to the pipeline depth and the
+	// in-flight bytes limit, and get the next task to launch. The loop of each
+	// device should use this instead of getting ready tasks from the scheduler
+	Task *getNextTask();
+
 	// Each device may use these methods to prepare or conclude task launch if needed
 	virtual void preRunTask(Task *)
 	{
@@ -58,7 +96,8 @@ protected:
 	{
 	}
 
-	// The main device task launch method; It will call pre- & postRunTask
+	// The main device task launch method; It will call pre- & postRunTask.
+	// The task must have been staged before
 	virtual void runTask(Task *task);
 
 	// Device specific operations after task completion may go here (e.g. free environment)
@@ -76,6 +115,7 @@ protected:
 public:
 	virtual ~Accelerator()
 	{
+		assert(_stagedTasks.empty());
 		delete _computePlace;
 		delete _memoryPlace;
 	}
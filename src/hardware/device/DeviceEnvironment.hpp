@@ -16,18 +16,16 @@
 #include <nanos6/cuda_device.h>
 #endif
 
-#if USE_OPENACC
+// The OpenACC environment is always present since the emulated devices
+// use it when the runtime is built without OpenACC support
 #include <nanos6/openacc_device.h>
-#endif
 
 //! Contains the device environment based on configured device types to determine max size
 union DeviceEnvironment {
 #if USE_CUDA
 		nanos6_cuda_device_environment_t cuda;
 #endif
-#if USE_OPENACC
 		nanos6_openacc_device_environment_t openacc;
-#endif
 };
 
 #endif // DEVICE_ENVIRONMENT_HPP
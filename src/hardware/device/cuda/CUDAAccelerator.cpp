@@ -45,11 +45,9 @@ void CUDAAccelerator::acceleratorServiceLoop()
 	bool activeDevice = false;
 
 	do {
-		if (_streamPool.streamAvailable()) {
-			task = Scheduler::getReadyTask(_computePlace);
-			if (task != nullptr) {
-				runTask(task);
-			}
+		task = getNextTask();
+		if (task != nullptr) {
+			runTask(task);
 		}
 		// Only do the setActiveDevice if there have been tasks launched
 		// Having setActiveDevice calls during e.g. bootstrap caused issues
@@ -58,10 +56,10 @@ void CUDAAccelerator::acceleratorServiceLoop()
 			activeDevice = true;
 		}
 		processCUDAEvents();
-	} while (!_activeEvents.empty() && worker);
+	} while ((!_activeEvents.empty() || !_stagedTasks.empty()) && worker);
 
 	// If process was run by LeaderThread, request a WorkerThread to continue.
-	if (!worker && (task != nullptr || !_activeEvents.empty())) {
+	if (!worker && (task != nullptr || !_activeEvents.empty() || !_stagedTasks.empty())) {
 		CPUManager::executeCPUManagerPolicy(nullptr, REQUEST_CPUS, 1);
 	}
 }
@@ -84,8 +82,13 @@ void CUDAAccelerator::preRunTask(Task *task)
 {
 	// set the thread_local static var to be used by nanos6_get_current_cuda_stream()
 	CUDAAccelerator::_currentTask = task;
+}
 
-	// Prefetch available memory locations to the GPU
+// Prefetch available memory locations to the GPU when the task is staged. The
+// prefetches are queued in the stream of the task, so they overlap with the
+// kernels of the tasks launched before and precede the kernel of the task
+void CUDAAccelerator::prefetchTask(Task *task)
+{
 	nanos6_cuda_device_environment_t &env =	task->getDeviceEnvironment().cuda;
 
 	DataAccessRegistration::processAllDataAccesses(task,
@@ -60,6 +60,13 @@ private:
 
 	void processCUDAEvents();
 
+	inline bool isAsyncHandleAvailable() override
+	{
+		return _streamPool.streamAvailable();
+	}
+
+	void prefetchTask(Task *task) override;
+
 	void preRunTask(Task *task) override;
 
 	void postRunTask(Task *task) override;
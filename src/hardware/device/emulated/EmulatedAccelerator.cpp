@@ -0,0 +1,94 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "EmulatedAccelerator.hpp"
+
+#include "executors/threads/CPUManager.hpp"
+#include "executors/threads/WorkerThread.hpp"
+#include "hardware/places/ComputePlace.hpp"
+#include "hardware/places/MemoryPlace.hpp"
+#include "scheduling/Scheduler.hpp"
+
+ConfigVariable<size_t> EmulatedAccelerator::_numQueues("devices.emulated.queues");
+ConfigVariable<size_t> EmulatedAccelerator::_latency("devices.emulated.latency");
+ConfigVariable<size_t> EmulatedAccelerator::_bandwidth("devices.emulated.bandwidth");
+
+int EmulatedAccelerator::pollingService(void *data)
+{
+	EmulatedAccelerator *accel = (EmulatedAccelerator *)data;
+	assert(accel != nullptr);
+
+	accel->acceleratorServiceLoop();
+	return 0;
+}
+
+uint64_t EmulatedAccelerator::getTransferTime(Task *task)
+{
+	uint64_t transferTime = _latency;
+
+	// A bandwidth of 1 MB/s transfers one byte per microsecond
+	const size_t bandwidth = _bandwidth;
+	if (bandwidth > 0)
+		transferTime += getTaskDataSize(task) / bandwidth;
+
+	return transferTime;
+}
+
+void EmulatedAccelerator::prefetchTask(Task *task)
+{
+	EmulatedQueue *queue = (EmulatedQueue *)task->getDeviceData();
+	assert(queue != nullptr);
+
+	queue->stage(getTransferTime(task));
+}
+
+void EmulatedAccelerator::runTask(Task *task)
+{
+	assert(task != nullptr);
+	assert(task->getComputePlace() == _computePlace);
+
+	EmulatedQueue *queue = (EmulatedQueue *)task->getDeviceData();
+	assert(queue != nullptr);
+
+	queue->launch(task, _computePlace);
+	_activeQueues.push_back(queue);
+}
+
+void EmulatedAccelerator::acceleratorServiceLoop()
+{
+	// Check if the thread running the service is a WorkerThread. nullptr means LeaderThread
+	bool worker = (WorkerThread::getCurrentWorkerThread() != nullptr);
+
+	Task *task = nullptr;
+
+	do {
+		task = getNextTask();
+		if (task != nullptr) {
+			runTask(task);
+		}
+		processQueues();
+	} while ((!_activeQueues.empty() || !_stagedTasks.empty()) && worker);
+
+	// If process was run by LeaderThread, request a WorkerThread to continue
+	if (!worker && (task != nullptr || !_activeQueues.empty() || !_stagedTasks.empty())) {
+		CPUManager::executeCPUManagerPolicy(nullptr, REQUEST_CPUS, 1);
+	}
+}
+
+void EmulatedAccelerator::processQueues()
+{
+	auto it = _activeQueues.begin();
+	while (it != _activeQueues.end()) {
+		EmulatedQueue *queue = *it;
+		assert(queue != nullptr);
+		if (queue->isFinished()) {
+			finishTask(queue->complete());
+			it = _activeQueues.erase(it);
+		} else {
+			it++;
+		}
+	}
+}
@@ -0,0 +1,119 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef EMULATED_ACCELERATOR_HPP
+#define EMULATED_ACCELERATOR_HPP
+
+#include <cstdint>
+#include <deque>
+
+#include <nanos6/openacc_device.h>
+#include <nanos6/polling.h>
+
+#include "EmulatedQueuePool.hpp"
+#include "hardware/device/Accelerator.hpp"
+#include "support/config/ConfigVariable.hpp"
+
+// An accelerator without hardware, which runs device tasks on dedicated host
+// threads. Each async queue is served by one thread, and tasks wait for a
+// simulated transfer time before running, which is computed from their data
+// accesses with a latency and bandwidth model. The transfers start when tasks
+// are staged, so they overlap with the execution of the previous tasks. It is
+// used to measure the overheads of the device scheduling path and the overlap
+// between tasks.
+//
+// The emulated devices take the slot of the OpenACC devices, so tasks with
+// the device(openacc) clause compiled without OpenACC run their host code
+class EmulatedAccelerator : public Accelerator {
+private:
+	std::deque<EmulatedQueue *> _activeQueues;
+
+	EmulatedQueuePool _queuePool;
+
+	// Number of async queues, thus host threads, per device
+	static ConfigVariable<size_t> _numQueues;
+
+	// Latency of the simulated transfers in microseconds
+	static ConfigVariable<size_t> _latency;
+
+	// Bandwidth of the simulated transfers in MB/s. Zero means unlimited
+	static ConfigVariable<size_t> _bandwidth;
+
+	inline bool isAsyncHandleAvailable() override
+	{
+		return _queuePool.isQueueAvailable();
+	}
+
+	// Emulated tasks get the environment of the OpenACC tasks
+	inline void generateDeviceEvironment(Task *task) override
+	{
+		nanos6_openacc_device_environment_t &env = task->getDeviceEnvironment().openacc;
+		EmulatedQueue *queue = _queuePool.getAsyncQueue();
+		task->setDeviceData((void *)queue);
+		env.asyncId = queue->getQueueId();
+	}
+
+	inline void finishTaskCleanup(Task *task) override
+	{
+		EmulatedQueue *queue = (EmulatedQueue *)task->getDeviceData();
+		_queuePool.releaseAsyncQueue(queue);
+	}
+
+	inline void registerPolling() override
+	{
+		nanos6_register_polling_service("Emulated device polling service", pollingService, (void *)this);
+	}
+
+	inline void unregisterPolling() override
+	{
+		nanos6_unregister_polling_service("Emulated device polling service", pollingService, (void *)this);
+	}
+
+	// Start the simulated transfers of the task on its queue
+	void prefetchTask(Task *task) override;
+
+	// Launch the task on its queue instead of running it inline
+	void runTask(Task *task) override;
+
+	void acceleratorServiceLoop() override;
+
+	void processQueues();
+
+	// Get the simulated time in microseconds to transfer the data of a task
+	uint64_t getTransferTime(Task *task);
+
+public:
+	EmulatedAccelerator(int deviceIndex) :
+		Accelerator(deviceIndex, nanos6_openacc_device),
+		_queuePool(_numQueues)
+	{
+		registerPolling();
+	}
+
+	~EmulatedAccelerator()
+	{
+		unregisterPolling();
+	}
+
+	static int pollingService(void *data);
+
+	// There is no actual device to select
+	inline void setActiveDevice() override
+	{
+	}
+
+	inline void *getAsyncHandle() override
+	{
+		return (void *)_queuePool.getAsyncQueue();
+	}
+
+	inline void releaseAsyncHandle(void *queue) override
+	{
+		_queuePool.releaseAsyncQueue((EmulatedQueue *)queue);
+	}
+};
+
+#endif // EMULATED_ACCELERATOR_HPP
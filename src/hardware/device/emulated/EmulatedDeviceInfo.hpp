@@ -0,0 +1,69 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef EMULATED_DEVICE_INFO_HPP
+#define EMULATED_DEVICE_INFO_HPP
+
+#include <vector>
+
+#include "EmulatedAccelerator.hpp"
+
+#include "hardware/hwinfo/DeviceInfo.hpp"
+#include "hardware/places/ComputePlace.hpp"
+#include "hardware/places/MemoryPlace.hpp"
+
+class EmulatedDeviceInfo : public DeviceInfo {
+	std::vector<EmulatedAccelerator *> _accelerators;
+
+public:
+	EmulatedDeviceInfo(size_t deviceCount)
+	{
+		_deviceCount = deviceCount;
+		_deviceInitialized = false;
+		_accelerators.reserve(_deviceCount);
+
+		if (_deviceCount > 0) {
+			// Create an Accelerator instance for each emulated device
+			for (size_t i = 0; i < _deviceCount; ++i) {
+				EmulatedAccelerator *accelerator = new EmulatedAccelerator(i);
+				assert(accelerator != nullptr);
+				_accelerators.push_back(accelerator);
+			}
+
+			_deviceInitialized = true;
+		}
+	}
+
+	~EmulatedDeviceInfo()
+	{
+		for (EmulatedAccelerator *accelerator : _accelerators) {
+			assert(accelerator != nullptr);
+			delete accelerator;
+		}
+	}
+
+	inline size_t getComputePlaceCount() const
+	{
+		return _deviceCount;
+	}
+
+	inline ComputePlace *getComputePlace(int handler) const
+	{
+		return _accelerators[handler]->getComputePlace();
+	}
+
+	inline size_t getMemoryPlaceCount() const
+	{
+		return _deviceCount;
+	}
+
+	inline MemoryPlace *getMemoryPlace(int handler) const
+	{
+		return _accelerators[handler]->getMemoryPlace();
+	}
+};
+
+#endif // EMULATED_DEVICE_INFO_HPP
@@ -0,0 +1,211 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef EMULATED_QUEUE_POOL_HPP
+#define EMULATED_QUEUE_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <time.h>
+
+#include "dependencies/SymbolTranslation.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+#include "lowlevel/threads/KernelLevelThread.hpp"
+#include "support/chronometers/std/Chrono.hpp"
+#include "tasks/Task.hpp"
+
+#include <MemoryAllocator.hpp>
+
+
+// An emulated async queue. Each queue is served by a dedicated host thread.
+// The simulated transfers of a task start when the task is staged, and the
+// thread runs the task body once the task is launched and its transfers have
+// finished. Staging, launching and completing tasks is done by the
+// accelerator's polling service, whereas the queue thread only runs the
+// launched task and flags its completion
+class EmulatedQueue : public KernelLevelThread {
+private:
+	int _queueId;
+	Task *_task;
+
+	// Time in microseconds when the simulated transfers of the task finish
+	uint64_t _transferEnd;
+
+	// The translation table of the launched task
+	nanos6_address_translation_entry_t _stackTranslationTable[SymbolTranslation::MAX_STACK_SYMBOLS];
+	nanos6_address_translation_entry_t *_translationTable;
+	size_t _tableSize;
+
+	std::atomic<bool> _finished;
+	std::atomic<bool> _mustExit;
+
+	static inline void waitUntil(uint64_t time)
+	{
+		const uint64_t now = Chrono::now<uint64_t>();
+		if (now >= time)
+			return;
+
+		const uint64_t microseconds = time - now;
+		struct timespec delay = {
+			(time_t) (microseconds / 1000000),
+			(long) ((microseconds % 1000000) * 1000)
+		};
+		// Repeat the call with the remaining time if it was interrupted
+		while (nanosleep(&delay, &delay)) {
+		}
+	}
+
+public:
+	EmulatedQueue(int id) :
+		KernelLevelThread(),
+		_queueId(id),
+		_task(nullptr),
+		_transferEnd(0),
+		_translationTable(nullptr),
+		_tableSize(0),
+		_finished(true),
+		_mustExit(false)
+	{
+		start(nullptr);
+	}
+
+	~EmulatedQueue()
+	{
+		assert(_task == nullptr);
+
+		_mustExit.store(true);
+		resume();
+		join();
+	}
+
+	inline int getQueueId() const
+	{
+		return _queueId;
+	}
+
+	inline bool isFinished() const
+	{
+		return _finished.load(std::memory_order_acquire);
+	}
+
+	inline Task *getTask() const
+	{
+		return _task;
+	}
+
+	// Start the simulated transfers of a staged task
+	inline void stage(uint64_t transferTime)
+	{
+		assert(_task == nullptr);
+		_transferEnd = Chrono::now<uint64_t>() + transferTime;
+	}
+
+	// Hand a staged task over to the queue thread. The task runs once its
+	// transfers have finished
+	inline void launch(Task *task, ComputePlace *computePlace)
+	{
+		assert(task != nullptr);
+		assert(_task == nullptr);
+		assert(isFinished());
+
+		_task = task;
+		_tableSize = 0;
+		_translationTable = SymbolTranslation::generateTranslationTable(
+			task, computePlace, _stackTranslationTable, _tableSize);
+
+		_finished.store(false, std::memory_order_relaxed);
+		resume();
+	}
+
+	// Release the resources of the finished task and return it
+	inline Task *complete()
+	{
+		assert(isFinished());
+
+		Task *task = _task;
+		assert(task != nullptr);
+
+		if (_tableSize > 0)
+			MemoryAllocator::free(_translationTable, _tableSize);
+
+		_task = nullptr;
+		_translationTable = nullptr;
+		_tableSize = 0;
+		return task;
+	}
+
+	void body() override
+	{
+		while (true) {
+			suspend();
+			if (_mustExit.load())
+				break;
+
+			assert(_task != nullptr);
+			waitUntil(_transferEnd);
+
+			_task->body(_translationTable);
+			_finished.store(true, std::memory_order_release);
+		}
+	}
+};
+
+class EmulatedQueuePool {
+private:
+	std::vector<EmulatedQueue *> _queues;
+
+	std::deque<EmulatedQueue *> _queuePool;
+
+public:
+	EmulatedQueuePool(size_t numQueues)
+	{
+		FatalErrorHandler::failIf(numQueues == 0,
+			"devices.emulated.queues must be greater than zero");
+
+		// Count from 1 as the OpenACC queues do
+		_queues.reserve(numQueues);
+		for (size_t i = 1; i <= numQueues; i++) {
+			EmulatedQueue *queue = new EmulatedQueue((int)i);
+			assert(queue != nullptr);
+			_queues.push_back(queue);
+			_queuePool.push_back(queue);
+		}
+	}
+
+	~EmulatedQueuePool()
+	{
+		assert(_queuePool.size() == _queues.size());
+
+		for (EmulatedQueue *queue : _queues) {
+			delete queue;
+		}
+	}
+
+	// Unlike OpenACC queues, emulated queues are backed by threads, so the
+	// pool never grows beyond the configured number of queues
+	inline bool isQueueAvailable() const
+	{
+		return !_queuePool.empty();
+	}
+
+	inline EmulatedQueue *getAsyncQueue()
+	{
+		assert(!_queuePool.empty());
+		EmulatedQueue *queue = _queuePool.front();
+		_queuePool.pop_front();
+		return queue;
+	}
+
+	inline void releaseAsyncQueue(EmulatedQueue *queue)
+	{
+		_queuePool.push_back(queue);
+	}
+};
+
+#endif // EMULATED_QUEUE_POOL_HPP
@@ -29,11 +29,9 @@ void OpenAccAccelerator::acceleratorServiceLoop()
 	bool activeDevice = false;
 
 	do {
-		if (isQueueAvailable()) {
-			task = Scheduler::getReadyTask(_computePlace);
-			if (task != nullptr) {
-				runTask(task);
-			}
+		task = getNextTask();
+		if (task != nullptr) {
+			runTask(task);
 		}
 		// Check if there is merit in setting the device;
 		// Only do the setActiveDevice if there have been tasks launched
@@ -44,10 +42,10 @@ void OpenAccAccelerator::acceleratorServiceLoop()
 			activeDevice = true;
 		}
 		processQueues();
-	} while (!_activeQueues.empty() && worker);
+	} while ((!_activeQueues.empty() || !_stagedTasks.empty()) && worker);
 
 	// If process was run by LeaderThread, request a WorkerThread to continue
-	if (!worker && (task != nullptr || !_activeQueues.empty())) {
+	if (!worker && (task != nullptr || !_activeQueues.empty() || !_stagedTasks.empty())) {
 		CPUManager::executeCPUManagerPolicy(nullptr, REQUEST_CPUS, 1);
 	}
 }
@@ -21,7 +21,7 @@ private:
 
 	OpenAccQueuePool _queuePool;
 
-	inline bool isQueueAvailable()
+	inline bool isAsyncHandleAvailable() override
 	{
 		return _queuePool.isQueueAvailable();
 	}
@@ -5,7 +5,11 @@
 */
 
 #include <cassert>
+#include <climits>
+#include <cstdio>
 #include <hwloc.h>
+#include <string>
+#include <sys/utsname.h>
 #include <unistd.h>
 
 #include "HostInfo.hpp"
@@ -13,6 +17,7 @@
 #include "hardware/places/NUMAPlace.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
 #include "lowlevel/Padding.hpp"
+#include "support/config/ConfigVariable.hpp"
 
 // Workaround to deal with changes in different HWLOC versions
 #if HWLOC_API_VERSION < 0x00010b00
@@ -26,6 +31,104 @@
 #endif
 
 
+//! \brief Initialize an hwloc topology and set its flags
+static void initTopology(hwloc_topology_t &topology)
+{
+	hwloc_topology_init(&topology);  // initialization
+
+#if HWLOC_API_VERSION >= 0x00020100
+	// Do not omit empty NUMA nodes. This option is only supported from hwloc 2.1.0
+	// It will mimic the behaviour of hwloc 1.x with disallowed resources.
+	hwloc_topology_set_flags(topology, HWLOC_TOPOLOGY_FLAG_INCLUDE_DISALLOWED);
+#endif
+}
+
+//! \brief Get a fingerprint of the system whose topology is cached, which
+//! includes the host name, the number of PUs, the kernel and hwloc versions
+static std::string getTopologyFingerprint()
+{
+	char hostname[HOST_NAME_MAX + 1] = "";
+	gethostname(hostname, sizeof(hostname));
+	hostname[HOST_NAME_MAX] = '\0';
+
+	struct utsname systemInfo;
+	if (uname(&systemInfo) != 0) {
+		systemInfo.release[0] = '\0';
+	}
+
+	return std::string(hostname)
+		+ ";pus=" + std::to_string(sysconf(_SC_NPROCESSORS_CONF))
+		+ ";kernel=" + systemInfo.release
+		+ ";hwloc=" + std::to_string(hwloc_get_api_version());
+}
+
+//! \brief Load the topology of the machine, using the topology cache if enabled
+//!
+//! The cached topology stores the fingerprint of the system where it was
+//! discovered in the information of its root object. If the fingerprint does
+//! not match, the topology is discovered again and the cache is replaced
+static void loadTopology(hwloc_topology_t &topology)
+{
+	static const char *fingerprintName = "Nanos6TopologyFingerprint";
+
+	ConfigVariable<std::string> cacheFile("misc.topology_cache");
+	const std::string &cachePath = cacheFile.getValue();
+	std::string fingerprint;
+
+	if (!cachePath.empty()) {
+		fingerprint = getTopologyFingerprint();
+	}
+
+	if (!cachePath.empty() && access(cachePath.c_str(), R_OK) == 0) {
+		// Import the topology exported by a previous execution, which avoids
+		// the discovery of the whole machine
+		initTopology(topology);
+		bool loaded = (hwloc_topology_set_xml(topology, cachePath.c_str()) == 0);
+		if (loaded) {
+#if HWLOC_API_VERSION >= 0x00020000
+			hwloc_topology_set_flags(topology,
+				hwloc_topology_get_flags(topology) | HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM);
+#else
+			hwloc_topology_set_flags(topology, HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM);
+#endif
+			loaded = (hwloc_topology_load(topology) == 0);
+		}
+
+		if (loaded) {
+			hwloc_obj_t root = hwloc_get_root_obj(topology);
+			const char *cachedFingerprint = hwloc_obj_get_info_by_name(root, fingerprintName);
+			if (cachedFingerprint != nullptr && fingerprint == cachedFingerprint)
+				return;
+
+			FatalErrorHandler::warn("The topology cache ", cachePath, " belongs to a different system, discovering the topology");
+		} else {
+			FatalErrorHandler::warn("Could not load the topology cache ", cachePath, ", discovering the topology");
+		}
+
+		hwloc_topology_destroy(topology);
+	}
+
+	initTopology(topology);
+	hwloc_topology_load(topology);   // actual detection
+
+	if (!cachePath.empty()) {
+		hwloc_obj_add_info(hwloc_get_root_obj(topology), fingerprintName, fingerprint.c_str());
+
+		// Export to a temporary file and rename it, so that concurrent
+		// processes never import a partially written cache
+		std::string temporaryPath = cachePath + "." + std::to_string(getpid());
+#if HWLOC_API_VERSION >= 0x00020000
+		int ret = hwloc_topology_export_xml(topology, temporaryPath.c_str(), 0);
+#else
+		int ret = hwloc_topology_export_xml(topology, temporaryPath.c_str());
+#endif
+		if (ret != 0 || rename(temporaryPath.c_str(), cachePath.c_str()) != 0) {
+			FatalErrorHandler::warn("Could not store the topology cache ", cachePath);
+			unlink(temporaryPath.c_str());
+		}
+	}
+}
+
 HostInfo::HostInfo() :
 	_validMemoryPlaces(0)
 {
@@ -38,15 +141,7 @@ HostInfo::HostInfo() :
 
 	//! Hardware discovery
 	hwloc_topology_t topology;
-	hwloc_topology_init(&topology);  // initialization
-
-#if HWLOC_API_VERSION >= 0x00020100
-	// Do not omit empty NUMA nodes. This option is only supported from hwloc 2.1.0
-	// It will mimic the behaviour of hwloc 1.x with disallowed resources.
-	hwloc_topology_set_flags(topology, HWLOC_TOPOLOGY_FLAG_INCLUDE_DISALLOWED);
-#endif
-
-	hwloc_topology_load(topology);   // actual detection
+	loadTopology(topology);
 
 	//! Create NUMA addressSpace
 	AddressSpace *NUMAAddressSpace = new AddressSpace();
@@ -78,6 +78,11 @@ namespace Instrument {
 	//! \param[in] collaboratorId the task identifier of the collaborator returned in the call to enterAddTask
 	void exitInitTaskforCollaborator(task_id_t taskforId, task_id_t collaboratorId, InstrumentationContext const &context = ThreadInstrumentationContext::getCurrent());
 
+	//! This function is called within Nanos6 core each time a task info is
+	//! registered, which happens before creating any task that uses it.
+	//! \param[in] the task info describing the tasks
+	void registeredTaskInfo(nanos6_task_info_t *taskInfo);
+
 	//! This function is called within Nanos6 core, just after registering a
 	//! a new spawned task type but before creating the task.
 	//! \param[in] the task info describing the task
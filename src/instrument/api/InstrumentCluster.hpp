@@ -29,6 +29,8 @@ namespace Instrument {
 		FoundInPending,
 		EarlyWriteID,
 		LateWriteID,
+		Coalesced,
+		Prefetched,
 		MaxDataFetch
 	};
 
@@ -55,6 +57,7 @@ namespace Instrument {
 		ExternalRank,
 		NodeNum,
 		ApprankNum,
+		TaskNewBytesSaved,
 		MaxClusterEventType
 	};
 
@@ -128,6 +128,11 @@ namespace Instrument {
 		tp_taskfor_init_exit();
 	}
 
+	inline void registeredTaskInfo(
+		__attribute__((unused)) nanos6_task_info_t *taskInfo
+	) {
+	}
+
 	inline void registeredNewSpawnedTaskType(nanos6_task_info_t *taskInfo)
 	{
 		const char *label = taskInfo->implementations[0].task_label;
@@ -19,6 +19,7 @@
 #include "ctfapi/CTFUserMetadata.hpp"
 #include "ctfapi/CTFTrace.hpp"
 #include "ctfapi/CTFTypes.hpp"
+#include "ctfapi/stream/CTFFlusher.hpp"
 #include "ctfapi/stream/CTFStream.hpp"
 #include "ctfapi/stream/CTFStreamUnboundedPrivate.hpp"
 #include "ctfapi/stream/CTFStreamUnboundedShared.hpp"
@@ -198,6 +199,10 @@ void Instrument::initialize()
 	initializeCTFEvents(userMetadata);
 	userMetadata->writeMetadataFile(userPath);
 	kernelMetadata->writeMetadataFile(kernelPath);
+
+	// All streams are registered, start writing them in background if
+	// the asynchronous flushing mode is enabled
+	CTFAPI::CTFFlusher::initialize();
 }
 
 void Instrument::shutdown()
@@ -224,6 +229,11 @@ void Instrument::shutdown()
 		}
 	}
 
+	// Write all the subbuffers already published and stop the flusher
+	// thread. The remaining contents are written while shutting down each
+	// stream
+	CTFAPI::CTFFlusher::shutdown();
+
 	// Shutdown Worker thread streams
 	for (ctf_cpu_id_t i = 0; i < totalCPUs; i++) {
 		cpu = cpus[i];
@@ -263,6 +273,15 @@ void Instrument::shutdown()
 	delete externalThreadStream;
 	delete Instrument::getCTFVirtualCPULocalData();
 
+	// Rewrite the user metadata to report the flushing statistics
+	if (CTFAPI::CTFFlusher::isEnabled()) {
+		uint64_t lateFlushes = CTFAPI::CTFFlusher::getLateFlushes();
+		trace.getMetadata()->writeMetadataFile(trace.getUserTracePath());
+		FatalErrorHandler::warnIf(lateFlushes > 0,
+			"ctf: ", lateFlushes, " times events had to wait for the asynchronous flusher"
+		);
+	}
+
 	// move tracing files to final directory
 	trace.convertToParaver();
 	trace.moveTemporalTraceToFinalDirectory();
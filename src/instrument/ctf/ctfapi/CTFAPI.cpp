@@ -21,21 +21,7 @@ extern CTFAPI::CTFEvent *__eventCTFFlush;
 
 uint64_t CTFAPI::getTimestamp()
 {
-	uint64_t timestamp;
-	struct timespec tp;
-	const uint64_t ns = 1000000000ULL;
-
-	// TODO using clock_gettime requires to add -lrt for old glibcs. We
-	// might get rid of this by using the chrono c++ library, but I'm not
-	// confident on which syscall and clock this translates. Should we move
-	// to c++ here? If so, remove the -lrt
-
-	if (clock_gettime(CTF_CLOCK, &tp)) {
-		FatalErrorHandler::failIf(true, std::string("Instrumentation: ctf: clock_gettime syscall: ") + strerror(errno));
-	}
-	timestamp = tp.tv_sec * ns + tp.tv_nsec;
-
-	return timestamp;
+	return CTFClock::getTimestamp();
 }
 
 uint64_t CTFAPI::getRelativeTimestamp()
@@ -96,8 +82,14 @@ void CTFAPI::flushCurrentVirtualCPUBufferIfNeeded(CTFStream *stream, CTFStream *
 	// External threads (but the leader thread) never have a change to call
 	// this function. Hence, locking is not needed
 	if (stream->checkIfNeedsFlush()) {
-		flushSubBuffers(stream, &tsBefore, &tsAfter);
-		writeFlushingTracepoint(report, tsBefore, tsAfter);
+		if (stream->isAsynchronous()) {
+			// Only hand the filled subbuffers to the flusher thread,
+			// there is no stall worth recording
+			stream->flushFilledSubBuffers();
+		} else {
+			flushSubBuffers(stream, &tsBefore, &tsAfter);
+			writeFlushingTracepoint(report, tsBefore, tsAfter);
+		}
 	}
 }
 
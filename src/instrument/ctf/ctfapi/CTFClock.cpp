@@ -0,0 +1,179 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <cassert>
+#include <sched.h>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+#include "CTFClock.hpp"
+#include "executors/threads/CPU.hpp"
+#include "executors/threads/CPUManager.hpp"
+
+
+ConfigVariable<std::string> CTFAPI::CTFClock::_clockSource("instrument.ctf.clock");
+bool CTFAPI::CTFClock::_useTSC = false;
+uint64_t CTFAPI::CTFClock::_tscFrequency = 0;
+uint64_t CTFAPI::CTFClock::_referenceTicks = 0;
+uint64_t CTFAPI::CTFClock::_referenceTimestamp = 0;
+uint64_t CTFAPI::CTFClock::_multiplier = 0;
+
+bool CTFAPI::CTFClock::isTSCInvariant()
+{
+#if defined(__x86_64__)
+	unsigned int eax, ebx, ecx, edx;
+
+	// Check the rdtscp instruction is available
+	if (!__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) || !(edx & (1 << 27)))
+		return false;
+
+	// Check the TSC ticks at a constant rate in all power states
+	if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1 << 8)))
+		return false;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void CTFAPI::CTFClock::sampleClocks(
+	__attribute__((unused)) uint64_t &timestamp,
+	__attribute__((unused)) uint64_t &ticks
+) {
+#if defined(__x86_64__)
+	const int attempts = 16;
+	uint64_t bestWindow = UINT64_MAX;
+
+	// Read the TSC in between two reads of the system clock and keep the
+	// sample with the narrowest window, which is the most accurate one
+	for (int i = 0; i < attempts; i++) {
+		uint64_t before = getSystemTimestamp();
+		uint64_t currentTicks = readTicks();
+		uint64_t after = getSystemTimestamp();
+
+		if (after - before < bestWindow) {
+			bestWindow = after - before;
+			timestamp = before + (after - before) / 2;
+			ticks = currentTicks;
+		}
+	}
+#endif
+}
+
+bool CTFAPI::CTFClock::calibrateTSC()
+{
+#if defined(__x86_64__)
+	const struct timespec calibrationTime = {0, 20 * 1000 * 1000};
+	uint64_t startTimestamp, startTicks;
+	uint64_t endTimestamp, endTicks;
+
+	sampleClocks(startTimestamp, startTicks);
+	struct timespec delay = calibrationTime;
+	while (nanosleep(&delay, &delay)) {
+	}
+	sampleClocks(endTimestamp, endTicks);
+
+	if (endTicks <= startTicks || endTimestamp <= startTimestamp)
+		return false;
+
+	unsigned __int128 elapsedTicks = endTicks - startTicks;
+	uint64_t elapsedTime = endTimestamp - startTimestamp;
+
+	_tscFrequency = (uint64_t) ((elapsedTicks * 1000000000ULL) / elapsedTime);
+	_multiplier = (uint64_t) ((((unsigned __int128) elapsedTime) << _shift) / elapsedTicks);
+	_referenceTicks = endTicks;
+	_referenceTimestamp = endTimestamp;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool CTFAPI::CTFClock::checkTSCSynchronization()
+{
+#if defined(__x86_64__)
+	// Maximum difference between the converted TSC and the system clock
+	const uint64_t tolerance = 10 * 1000;
+	bool synchronized = true;
+	cpu_set_t originalMask;
+
+	int ret = sched_getaffinity(0, sizeof(cpu_set_t), &originalMask);
+	FatalErrorHandler::handle(ret, " when getting the affinity of the main thread");
+
+	// Migrate through all CPUs and check that their TSCs agree with the
+	// calibration done on the first one
+	std::vector<CPU *> const &cpus = CPUManager::getCPUListReference();
+	for (CPU *cpu : cpus) {
+		assert(cpu != nullptr);
+
+		cpu_set_t mask;
+		CPU_ZERO(&mask);
+		CPU_SET(cpu->getSystemCPUId(), &mask);
+		if (sched_setaffinity(0, sizeof(cpu_set_t), &mask) != 0)
+			continue;
+
+		uint64_t timestamp, ticks;
+		sampleClocks(timestamp, ticks);
+
+		uint64_t converted = ticksToTimestamp(ticks);
+		uint64_t offset = (converted > timestamp) ? converted - timestamp : timestamp - converted;
+		if (offset > tolerance) {
+			FatalErrorHandler::warn(
+				"ctf: the TSC of CPU ", cpu->getSystemCPUId(), " is ", offset,
+				" ns away from the system clock"
+			);
+			synchronized = false;
+			break;
+		}
+	}
+
+	ret = sched_setaffinity(0, sizeof(cpu_set_t), &originalMask);
+	FatalErrorHandler::handle(ret, " when restoring the affinity of the main thread");
+
+	return synchronized;
+#else
+	return false;
+#endif
+}
+
+void CTFAPI::CTFClock::initialize()
+{
+	std::string source = _clockSource.getValue();
+
+	_useTSC = false;
+	if (source == "monotonic")
+		return;
+
+	FatalErrorHandler::failIf(source != "tsc",
+		"ctf: invalid clock source '", source, "', valid values are 'monotonic' and 'tsc'"
+	);
+
+	if (!isTSCInvariant()) {
+		FatalErrorHandler::warn("ctf: the TSC is not invariant, falling back to the monotonic clock");
+		return;
+	}
+
+	if (!calibrateTSC()) {
+		FatalErrorHandler::warn("ctf: could not calibrate the TSC, falling back to the monotonic clock");
+		return;
+	}
+
+	if (!checkTSCSynchronization()) {
+		FatalErrorHandler::warn("ctf: the TSC is not synchronized across CPUs, falling back to the monotonic clock");
+		return;
+	}
+
+	_useTSC = true;
+}
@@ -1,14 +1,25 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2020-2021 Barcelona Supercomputing Center (BSC)
 */
 
 #ifndef CTF_CLOCK_HPP
 #define CTF_CLOCK_HPP
 
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
 #include <time.h>
 
+#include "lowlevel/FatalErrorHandler.hpp"
+#include "support/config/ConfigVariable.hpp"
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 // We prefer CLOCK_MONOTONIC_RAW to prevent dynamic NTF time adjustments.
 // However, if the system does not support it, we fall back to CLOCK_MONOTONIC
 
@@ -18,4 +29,98 @@
 #define CTF_CLOCK CLOCK_MONOTONIC
 #endif
 
+namespace CTFAPI {
+
+	//! \brief Source of the CTF event timestamps. Timestamps are always
+	//! given in nanoseconds of the CTF_CLOCK timeline, which is also used by
+	//! the Linux kernel events. When the TSC is invariant and synchronized
+	//! across CPUs, it can be read instead of calling clock_gettime, which
+	//! is not always served through the vDSO. Its ticks are then converted
+	//! to nanoseconds with the parameters calibrated at startup
+	class CTFClock {
+	private:
+		//! Fixed-point shift of the ticks to nanoseconds multiplier
+		static const unsigned int _shift = 32;
+
+		static ConfigVariable<std::string> _clockSource;
+
+		//! Whether timestamps are obtained from the TSC
+		static bool _useTSC;
+
+		//! The calibrated TSC frequency in Hz
+		static uint64_t _tscFrequency;
+
+		//! The TSC and CTF_CLOCK values of the same instant
+		static uint64_t _referenceTicks;
+		static uint64_t _referenceTimestamp;
+
+		//! Nanoseconds per tick, scaled by 2^_shift
+		static uint64_t _multiplier;
+
+		static bool isTSCInvariant();
+		static void sampleClocks(uint64_t &timestamp, uint64_t &ticks);
+		static bool calibrateTSC();
+		static bool checkTSCSynchronization();
+
+#if defined(__x86_64__)
+		static inline uint64_t readTicks()
+		{
+			unsigned int aux;
+			return __rdtscp(&aux);
+		}
+
+		static inline uint64_t ticksToTimestamp(uint64_t ticks)
+		{
+			unsigned __int128 delta = (ticks - _referenceTicks);
+			return _referenceTimestamp + (uint64_t) ((delta * _multiplier) >> _shift);
+		}
+#endif
+
+	public:
+		//! \brief Select the clock source and calibrate it if needed. It
+		//! must be called before obtaining any timestamp
+		static void initialize();
+
+		//! \brief Read the CTF_CLOCK through clock_gettime
+		static inline uint64_t getSystemTimestamp()
+		{
+			struct timespec tp;
+			const uint64_t ns = 1000000000ULL;
+
+			if (clock_gettime(CTF_CLOCK, &tp)) {
+				FatalErrorHandler::fail("Instrumentation: ctf: clock_gettime syscall: ", strerror(errno));
+			}
+
+			return tp.tv_sec * ns + tp.tv_nsec;
+		}
+
+		//! \brief Get the current timestamp in nanoseconds
+		static inline uint64_t getTimestamp()
+		{
+#if defined(__x86_64__)
+			if (_useTSC)
+				return ticksToTimestamp(readTicks());
+#endif
+			return getSystemTimestamp();
+		}
+
+		static inline bool usesTSC()
+		{
+			return _useTSC;
+		}
+
+		//! \brief Get the TSC frequency in Hz, or 0 if not in use
+		static inline uint64_t getTSCFrequency()
+		{
+			return _useTSC ? _tscFrequency : 0;
+		}
+
+		//! \brief Get the name of the clock source in use
+		static inline const char *getSourceName()
+		{
+			return _useTSC ? "tsc" : "monotonic";
+		}
+	};
+}
+
 #endif // CTF_CLOCK_HPP
@@ -23,6 +23,7 @@
 #include <sys/types.h>
 
 #include "CTFAPI.hpp"
+#include "CTFClock.hpp"
 #include "CTFTrace.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
 
@@ -393,6 +394,10 @@ void CTFAPI::CTFTrace::convertToParaver()
 
 void CTFAPI::CTFTrace::initializeTraceTimer()
 {
+	// select and calibrate the clock source before reading it for the
+	// first time
+	CTFClock::initialize();
+
 	// get absolute timestamp used to calculate relative timestamps of all
 	// tracepoints. On Linux, this timestamp is actually relative to boot
 	// time.
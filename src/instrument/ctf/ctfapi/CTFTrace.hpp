@@ -68,6 +68,11 @@ namespace CTFAPI {
 			_kernelMetadata = metadata;
 		}
 
+		CTFUserMetadata *getMetadata() const
+		{
+			return _userMetadata;
+		}
+
 		CTFKernelMetadata *getKernelMetadata() const
 		{
 			return _kernelMetadata;
@@ -100,6 +105,10 @@ namespace CTFAPI {
 		inline std::string getTemporalTracePath() const {
 			return _tmpTracePath;
 		}
+
+		inline std::string getUserTracePath() const {
+			return _userPath;
+		}
 	};
 }
 
@@ -9,6 +9,8 @@
 #include <cinttypes>
 #include <vector>
 
+#include "CTFClock.hpp"
+#include "stream/CTFFlusher.hpp"
 #include "stream/CTFStream.hpp"
 #include "CTFUserMetadata.hpp"
 #include "context/CTFEventContext.hpp"
@@ -49,12 +51,16 @@ const char *CTFAPI::CTFUserMetadata::meta_env =
 	"	cpu_list = \"%s\";\n"
 	"	binary_name = \"%s\";\n"
 	"	pid = %" PRIu64 ";\n"
+	"	async_flush = %d;\n"
+	"	late_flushes = %" PRIu64 ";\n"
+	"	clock_source = \"%s\";\n"
+	"	tsc_frequency = %" PRIu64 ";\n"
 	"};\n\n";
 
 const char *CTFAPI::CTFUserMetadata::meta_clock =
 	"clock {\n"
 	"	name = \"monotonic\";\n"
-	"	description = \"Monotonic Clock\";\n"
+	"	description = \"%s\";\n"
 	"	freq = 1000000000; /* Frequency, in Hz */\n"
 	"	/* clock value offset from Epoch is: offset * (1/freq) */\n"
 	"	offset = %" PRIu64 ";\n"
@@ -162,8 +168,19 @@ void CTFAPI::CTFUserMetadata::writeMetadataFile(std::string userPath)
 	fprintf(f, meta_env,
 		_cpuList.c_str(),
 		trace.getBinaryName(),
-		trace.getPid());
-	fprintf(f, meta_clock, trace.getAbsoluteStartTimestamp());
+		trace.getPid(),
+		CTFFlusher::isEnabled(),
+		CTFFlusher::getLateFlushes(),
+		CTFClock::getSourceName(),
+		CTFClock::getTSCFrequency());
+
+	// Timestamps are always converted to nanoseconds of the monotonic
+	// clock, even if they are read from the TSC
+	std::string clockDescription = "Monotonic Clock";
+	if (CTFClock::usesTSC()) {
+		clockDescription += " (from invariant TSC at " + std::to_string(CTFClock::getTSCFrequency()) + " Hz)";
+	}
+	fprintf(f, meta_clock, clockDescription.c_str(), trace.getAbsoluteStartTimestamp());
 
 	// print context additional structures
 	for (auto it = contexes.begin(); it != contexes.end(); ++it) {
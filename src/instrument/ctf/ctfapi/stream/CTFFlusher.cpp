@@ -0,0 +1,97 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/resource.h>
+
+#include "CTFFlusher.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+
+
+ConfigVariable<bool> CTFAPI::CTFFlusher::_asyncFlushEnabled("instrument.ctf.async_flush");
+CTFAPI::CTFFlusher *CTFAPI::CTFFlusher::_singleton = nullptr;
+uint64_t CTFAPI::CTFFlusher::_lateFlushes = 0;
+
+bool CTFAPI::CTFFlusher::flushPendingSegments()
+{
+	bool flushed = false;
+
+	for (CircularBuffer *buffer : _buffers) {
+		flushed |= buffer->flushPendingSegments();
+	}
+
+	return flushed;
+}
+
+void CTFAPI::CTFFlusher::body()
+{
+	// Time to sleep when there was nothing to write in the last round
+	const struct timespec idleDelay = {0, 500 * 1000};
+
+	// Writing to disk should not steal CPU time from the worker threads,
+	// and the threads producing events never wait for us unless their
+	// buffers are full. Lower our priority as much as possible
+	int ret = setpriority(PRIO_PROCESS, getTid(), 19);
+	FatalErrorHandler::warnIf(ret == -1,
+		"ctf: could not lower the priority of the flusher thread: ",
+		strerror(errno)
+	);
+
+	while (!_mustExit.load(std::memory_order_relaxed)) {
+		if (!flushPendingSegments()) {
+			struct timespec delay = idleDelay;
+			while (nanosleep(&delay, &delay)) {
+			}
+		}
+	}
+
+	// Write whatever was published before being asked to exit
+	flushPendingSegments();
+}
+
+void CTFAPI::CTFFlusher::registerBuffer(CircularBuffer *buffer)
+{
+	assert(buffer != nullptr);
+
+	if (!isEnabled())
+		return;
+
+	if (_singleton == nullptr) {
+		_singleton = new CTFFlusher();
+	}
+
+	buffer->setAsynchronous(true);
+	_singleton->_buffers.push_back(buffer);
+}
+
+void CTFAPI::CTFFlusher::initialize()
+{
+	if (_singleton == nullptr)
+		return;
+
+	_singleton->start(nullptr);
+}
+
+void CTFAPI::CTFFlusher::shutdown()
+{
+	if (_singleton == nullptr)
+		return;
+
+	_singleton->_mustExit.store(true);
+	_singleton->join();
+
+	// Any data published from now on is written by its owner
+	for (CircularBuffer *buffer : _singleton->_buffers) {
+		buffer->setAsynchronous(false);
+		_lateFlushes += buffer->getLateFlushes();
+	}
+
+	delete _singleton;
+	_singleton = nullptr;
+}
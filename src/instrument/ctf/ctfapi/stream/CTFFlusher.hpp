@@ -0,0 +1,83 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CTF_FLUSHER_HPP
+#define CTF_FLUSHER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "CircularBuffer.hpp"
+#include "lowlevel/threads/KernelLevelThread.hpp"
+#include "support/config/ConfigVariable.hpp"
+
+
+namespace CTFAPI {
+
+	//! \brief Low-priority thread that writes the filled subbuffers of all
+	//! CTF streams to disk, so that threads emitting events only need to
+	//! publish them instead of performing the writes themselves
+	class CTFFlusher : public KernelLevelThread {
+	private:
+		//! Whether the asynchronous flushing mode is enabled
+		static ConfigVariable<bool> _asyncFlushEnabled;
+
+		//! The singleton instance
+		static CTFFlusher *_singleton;
+
+		//! Total number of times an event had to wait for the flusher
+		static uint64_t _lateFlushes;
+
+		//! Whether the flusher thread must stop executing
+		std::atomic<bool> _mustExit;
+
+		//! The circular buffers drained by the flusher thread
+		std::vector<CircularBuffer *> _buffers;
+
+		inline CTFFlusher() :
+			KernelLevelThread(),
+			_mustExit(false),
+			_buffers()
+		{
+		}
+
+		bool flushPendingSegments();
+
+	public:
+		//! \brief A loop that drains the published segments of all buffers
+		void body() override;
+
+		//! \brief Check whether the asynchronous flushing mode is enabled
+		static inline bool isEnabled()
+		{
+			return _asyncFlushEnabled.getValue();
+		}
+
+		//! \brief Register a circular buffer to be drained by the flusher
+		//! thread. All buffers must be registered before calling initialize
+		//!
+		//! \param[in] buffer The circular buffer to register
+		static void registerBuffer(CircularBuffer *buffer);
+
+		//! \brief Start the flusher thread if the asynchronous mode is enabled
+		static void initialize();
+
+		//! \brief Write all pending segments, stop the flusher thread and
+		//! switch all registered buffers back to synchronous mode
+		static void shutdown();
+
+		//! \brief Get the number of times an event could not be recorded
+		//! without waiting for the flusher thread. Only meaningful after
+		//! shutting down the flusher thread
+		static inline uint64_t getLateFlushes()
+		{
+			return _lateFlushes;
+		}
+	};
+}
+
+#endif // CTF_FLUSHER_HPP
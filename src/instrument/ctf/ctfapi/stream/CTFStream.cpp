@@ -4,6 +4,7 @@
 	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include "CTFFlusher.hpp"
 #include "CTFStream.hpp"
 
 CTFAPI::CTFStream::CTFStream(
@@ -25,6 +26,7 @@ void CTFAPI::CTFStream::initialize()
 {
 	_circularBuffer.initialize(_size, _node, _path.c_str());
 	addStreamHeader();
+	CTFFlusher::registerBuffer(&_circularBuffer);
 }
 
 void CTFAPI::CTFStream::makePacketHeader(CircularBuffer *circularBuffer, ctf_stream_id_t streamId)
@@ -102,6 +102,11 @@ namespace CTFAPI {
 			_circularBuffer.submit(size);
 		}
 
+		inline bool isAsynchronous() const
+		{
+			return _circularBuffer.isAsynchronous();
+		}
+
 		inline bool checkIfNeedsFlush() {
 			return _circularBuffer.checkIfNeedsFlush();
 		}
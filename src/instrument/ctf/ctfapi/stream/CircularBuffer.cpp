@@ -21,6 +21,7 @@
 
 #include "CircularBuffer.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
+#include "lowlevel/SpinWait.hpp"
 
 #define PAGE_SHIFT (12)
 #define PAGE_SIZE (1 << PAGE_SHIFT)
@@ -143,6 +144,7 @@ void CircularBuffer::resetPointers()
 	_tail = 0;
 	_hole = 0;
 	_wall = _bufferSize;
+	_released.store(0, std::memory_order_relaxed);
 }
 
 void CircularBuffer::flushToFile(char *buf, size_t size)
@@ -168,6 +170,53 @@ void CircularBuffer::flushToFile(char *buf, size_t size)
 	} while (rem > 0);
 }
 
+void CircularBuffer::commitSegment(char *buf, size_t size, uint64_t end)
+{
+	// Nothing to commit
+	if (end == _tail)
+		return;
+
+	if (!_async) {
+		flushToFile(buf, size);
+		_released.store(end, std::memory_order_relaxed);
+		return;
+	}
+
+	// Hand the segment to the flusher thread. The queue only fills up if
+	// the flusher thread is lagging behind, in which case we must wait
+	Segment segment = {buf, size, end};
+	if (!_pendingSegments.push(segment)) {
+		_lateFlushes++;
+		while (!_pendingSegments.push(segment)) {
+			spinWait();
+		}
+		spinWaitRelease();
+	}
+}
+
+void CircularBuffer::waitForPendingSegments()
+{
+	while (_released.load(std::memory_order_acquire) != _tail) {
+		spinWait();
+	}
+	spinWaitRelease();
+}
+
+bool CircularBuffer::flushPendingSegments()
+{
+	Segment segment;
+	bool flushed = false;
+
+	while (_pendingSegments.pop(segment)) {
+		flushToFile(segment.start, segment.size);
+		// Release the space once the contents are on disk
+		_released.store(segment.end, std::memory_order_release);
+		flushed = true;
+	}
+
+	return flushed;
+}
+
 bool CircularBuffer::checkIfNeedsFlush()
 {
 	uint64_t size;
@@ -187,8 +236,10 @@ bool CircularBuffer::alloc(uint64_t size)
 
 	assert(size <= _bufferSize);
 
+	uint64_t released = _released.load(std::memory_order_acquire);
+
 	// There is enough space in the buffer?
-	if (_head + size - _tail > _bufferSize) {
+	if (_head + size - released > _bufferSize) {
 		return false;
 	}
 
@@ -198,7 +249,7 @@ bool CircularBuffer::alloc(uint64_t size)
 		_hole = _head;
 		_head = next_wall;
 		// if not, is the next space contiguous?
-		if (_head + size - _tail > _bufferSize) {
+		if (_head + size - released > _bufferSize) {
 			return false;
 		}
 	}
@@ -214,8 +265,10 @@ uint64_t CircularBuffer::allocAtLeast(uint64_t minSize)
 
 	assert(minSize <= _bufferSize);
 
+	uint64_t released = _released.load(std::memory_order_acquire);
+
 	// Is there enough space in the buffer?
-	if (_head + minSize - _tail > _bufferSize) {
+	if (_head + minSize - released > _bufferSize) {
 		return 0;
 	}
 
@@ -226,14 +279,14 @@ uint64_t CircularBuffer::allocAtLeast(uint64_t minSize)
 		_hole = _head;
 		_head = nextWall;
 		// We cannot cross the border again so what's left is what we have
-		available = _bufferSize - (_head - _tail);
+		available = _bufferSize - (_head - released);
 		// Check again the available size, after moving the _head there might
 		// no longer be enough space
 		available = (available >= minSize)? available : 0;
 	} else {
 		// If yes, get the minimum between the real space left and and
 		// the maximum contiguous space
-		available = std::min(_bufferSize - (_head - _tail), nextWall - _head);
+		available = std::min(_bufferSize - (_head - released), nextWall - _head);
 	}
 
 	return available;
@@ -247,7 +300,7 @@ void CircularBuffer::flushUpToTheWrap()
 		return;
 
 	seg = (_tail < _hole) ? _hole : _wall;
-	flushToFile(_buffer + (_tail & _mask), seg - _tail);
+	commitSegment(_buffer + (_tail & _mask), seg - _tail, _wall);
 	_tail = _wall;
 	_wall += _bufferSize;
 }
@@ -258,7 +311,16 @@ void CircularBuffer::flushAll()
 	flushUpToTheWrap();
 
 	// Next flush up to _head
-	flushToFile(_buffer + (_tail & _mask), _head - _tail);
+	commitSegment(_buffer + (_tail & _mask), _head - _tail, _head);
+	_tail = _head;
+
+	// In asynchronous mode, the caller needs the whole buffer back, so we
+	// have no choice but to wait for the flusher thread if it has not
+	// written all the segments yet
+	if (_async && _released.load(std::memory_order_acquire) != _tail) {
+		_lateFlushes++;
+		waitForPendingSegments();
+	}
 
 	// Move pointers to the beginning of the buffer; we want head to be as
 	// far as possible from the wall
@@ -275,12 +337,13 @@ void CircularBuffer::flushFilledSubBuffers()
 	// Next, flush up to the next subbuffer. Here we priorize flushing
 	// size aligned blocks rather than flushing everything
 	size = ((_head - _tail) & ~_subBufferMask);
-	flushToFile(_buffer + (_tail & _mask), size);
+	commitSegment(_buffer + (_tail & _mask), size, _tail + size);
 	_tail += size;
 
 	// If we have flushed everything, return pointers to the beginning of
-	// the buffer, we want head to be as far as possible from the wall
-	if (_tail == _head) {
+	// the buffer, we want head to be as far as possible from the wall. In
+	// asynchronous mode the flusher thread might still be writing them
+	if (!_async && _tail == _head) {
 		resetPointers();
 	}
 
@@ -4,12 +4,28 @@
 	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
 */
 
+#ifndef CIRCULAR_BUFFER_HPP
+#define CIRCULAR_BUFFER_HPP
+
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 
+#include <boost/lockfree/spsc_queue.hpp>
+
 class CircularBuffer {
 
 private:
+	//! A range of the buffer that has been handed to the flusher thread
+	struct Segment {
+		char *start;
+		uint64_t size;
+		//! The logical position of the tail once the segment is on disk
+		uint64_t end;
+	};
+
+	typedef boost::lockfree::spsc_queue<Segment, boost::lockfree::capacity<16>> segment_queue_t;
+
 	char *_buffer;
 	uint64_t _bufferSize;
 	uint64_t _subBufferSize;
@@ -24,9 +40,26 @@ private:
 	uint64_t _fileOffset;
 	int _node;
 
+	//! Logical position up to which the buffer contents are already on
+	//! disk and can be overwritten. In synchronous mode it always matches
+	//! _tail. In asynchronous mode _tail only marks what has been handed to
+	//! the flusher thread, which advances this position once written
+	std::atomic<uint64_t> _released;
+
+	//! Whether filled segments are written by the flusher thread
+	bool _async;
+
+	//! Segments pending to be written by the flusher thread
+	segment_queue_t _pendingSegments;
+
+	//! Number of times the owner had to wait for the flusher thread
+	uint64_t _lateFlushes;
+
 	void initializeFile(const char *path);
 	void initializeBuffer(uint64_t size, int node);
 	void flushToFile(char *buf, size_t size);
+	void commitSegment(char *buf, size_t size, uint64_t end);
+	void waitForPendingSegments();
 	void flushUpToTheWrap();
 	void resetPointers();
 
@@ -36,7 +69,12 @@ private:
 	}
 
 public:
-	CircularBuffer() {};
+	CircularBuffer() :
+		_released(0),
+		_async(false),
+		_lateFlushes(0)
+	{
+	}
 
 	void initialize(uint64_t size, int node, const char *path);
 	void flushAll();
@@ -46,6 +84,30 @@ public:
 	bool alloc(uint64_t size);
 	uint64_t allocAtLeast(uint64_t minSize);
 
+	//! \brief Write the segments handed over by the owner of the buffer
+	//! Only the flusher thread may call this function
+	//!
+	//! \return Whether any segment has been written
+	bool flushPendingSegments();
+
+	//! \brief Switch between synchronous and asynchronous flushing. The
+	//! flusher thread must not be running when calling this function
+	inline void setAsynchronous(bool async)
+	{
+		assert(_pendingSegments.read_available() == 0);
+		_async = async;
+	}
+
+	inline bool isAsynchronous() const
+	{
+		return _async;
+	}
+
+	inline uint64_t getLateFlushes() const
+	{
+		return _lateFlushes;
+	}
+
 	inline void *getBuffer()
 	{
 		return (void *) (_buffer + (_head & _mask));
@@ -58,3 +120,5 @@ public:
 	}
 
 };
+
+#endif // CIRCULAR_BUFFER_HPP
@@ -0,0 +1,129 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef EXTRAE_THREAD_COUNT_LOCK_HPP
+#define EXTRAE_THREAD_COUNT_LOCK_HPP
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+#include "lowlevel/Padding.hpp"
+#include "lowlevel/SpinLock.hpp"
+#include "lowlevel/SpinWait.hpp"
+
+
+namespace Instrument {
+	namespace Extrae {
+		//! \brief Synchronizes the emission of events with the changes of the
+		//! number of threads known by Extrae
+		//!
+		//! Emitting events is the frequent operation, and changing the number of
+		//! threads is rare. Thus, each emitting thread only announces that it is
+		//! emitting in its own cache line and checks whether a change is ongoing.
+		//! Changing the number of threads starts a new epoch, in which emitters
+		//! wait, and waits until the emitters of the previous epoch finish
+		class ThreadCountLock {
+		private:
+			struct alignas(CACHELINE_SIZE) emitter_slot_t {
+				std::atomic<bool> _emitting;
+
+				emitter_slot_t() :
+					_emitting(false)
+				{
+				}
+			};
+
+			//! Whether a thread is changing the number of threads
+			std::atomic<bool> _changing;
+
+			//! Serializes the changes of the number of threads
+			SpinLock _changeLock;
+
+			//! The slots of all the threads that have emitted events. Slots
+			//! are never released, since threads rarely finish
+			SpinLock _slotsLock;
+			std::vector<emitter_slot_t *> _slots;
+
+			inline emitter_slot_t &getSlot()
+			{
+				static thread_local emitter_slot_t *slot = nullptr;
+
+				if (slot == nullptr) {
+					slot = new emitter_slot_t();
+
+					std::lock_guard<SpinLock> guard(_slotsLock);
+					_slots.push_back(slot);
+				}
+
+				return *slot;
+			}
+
+		public:
+			ThreadCountLock() :
+				_changing(false),
+				_changeLock(),
+				_slotsLock(),
+				_slots()
+			{
+			}
+
+			//! \brief Start emitting events. Must not be nested
+			inline void readLock()
+			{
+				emitter_slot_t &slot = getSlot();
+				assert(!slot._emitting.load(std::memory_order_relaxed));
+
+				while (true) {
+					// Both accesses are sequentially consistent, so that either
+					// this thread sees the change or the changer sees this slot
+					slot._emitting.store(true);
+					if (!_changing.load())
+						return;
+
+					// Step back until the change finishes
+					slot._emitting.store(false, std::memory_order_release);
+					while (_changing.load(std::memory_order_relaxed)) {
+						spinWait();
+					}
+					spinWaitRelease();
+				}
+			}
+
+			//! \brief Finish emitting events
+			inline void readUnlock()
+			{
+				getSlot()._emitting.store(false, std::memory_order_release);
+			}
+
+			//! \brief Start changing the number of threads
+			inline void writeLock()
+			{
+				_changeLock.lock();
+				_changing.store(true);
+
+				// Wait for the threads that were already emitting events
+				std::lock_guard<SpinLock> guard(_slotsLock);
+				for (emitter_slot_t *slot : _slots) {
+					while (slot->_emitting.load()) {
+						spinWait();
+					}
+				}
+				spinWaitRelease();
+			}
+
+			//! \brief Finish changing the number of threads
+			inline void writeUnlock()
+			{
+				_changing.store(false, std::memory_order_release);
+				_changeLock.unlock();
+			}
+		};
+	}
+}
+
+#endif // EXTRAE_THREAD_COUNT_LOCK_HPP
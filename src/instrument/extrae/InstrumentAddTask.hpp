@@ -14,7 +14,6 @@
 #include "../support/InstrumentThreadLocalDataSupport.hpp"
 
 #include <cassert>
-#include <mutex>
 
 class Task;
 
@@ -86,19 +85,20 @@ namespace Instrument {
 			ce.Communications[0].size = 0;
 			ce.Communications[0].partner = EXTRAE_COMM_PARTNER_MYSELF;
 			ce.Communications[0].id = _extraeTaskInfo->_taskId;
-			_extraeTaskInfo->_predecessors.emplace(0, instantiation_dependency_tag);
-		}
-
-		if (Extrae::_traceAsThreads) {
-			_extraeThreadCountLock.readLock();
+			_extraeTaskInfo->_predecessors.append(
+				Extrae::predecessor_entry_t(0, instantiation_dependency_tag)
+			);
 		}
 
+		// The functions of task infos are recorded when they are registered.
+		// Only record here the ones of task infos that were never registered
 		assert(taskInfo != nullptr);
-		{
-			Extrae::user_fct_t user_fct(taskInfo);
+		if (taskInfo->task_type_data == nullptr) {
+			Extrae::registerUserFunction(taskInfo);
+		}
 
-			std::lock_guard<SpinLock> guard(Extrae::_userFunctionMapLock);
-			Extrae::_userFunctionMap.insert(user_fct);
+		if (Extrae::_traceAsThreads) {
+			_extraeThreadCountLock.readLock();
 		}
 
 		ExtraeAPI::emit_CombinedEvents(&ce);
@@ -230,6 +230,11 @@ namespace Instrument {
 		}
 	}
 
+	inline void registeredTaskInfo(nanos6_task_info_t *taskInfo)
+	{
+		Extrae::registerUserFunction(taskInfo);
+	}
+
 	inline void registeredNewSpawnedTaskType(__attribute__((unused)) nanos6_task_info_t *taskInfo)
 	{
 	}
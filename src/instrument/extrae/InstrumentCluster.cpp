@@ -38,7 +38,8 @@ namespace Instrument {
 		(extrae_type_t) EventType::OFFLOAD_HEADROOM,
 		(extrae_type_t) EventType::EXTERNAL_RANK,
 		(extrae_type_t) EventType::NODE_NUM,
-		(extrae_type_t) EventType::APPRANK_NUM
+		(extrae_type_t) EventType::APPRANK_NUM,
+		(extrae_type_t) EventType::TASK_NEW_BYTES_SAVED
 	};
 
 	static const char *clusterEventTypeToName[MaxClusterEventType] = {
@@ -62,7 +63,8 @@ namespace Instrument {
 		"Offload headroom: number of extra above those being sent now",
 		"External rank (rank in original MPI_COMM_WORLD) [counting from 1]",
 		"Node number [counting from 1]",
-		"Application rank [counting from 1]"
+		"Application rank [counting from 1]",
+		"Cumulative KiB of task type descriptors omitted from task new messages"
 	};
 
 	static std::atomic<int> _totalOffloadedTasksWaiting;
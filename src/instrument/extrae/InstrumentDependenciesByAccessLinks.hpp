@@ -90,11 +90,7 @@ namespace Instrument {
 		bool mustEmit = false;
 		if (!dataAccessId._weak) {
 			targetTaskId._taskInfo->_lock.lock();
-			auto it = targetTaskId._taskInfo->_predecessors.find(entry);
-			if (it == targetTaskId._taskInfo->_predecessors.end()) {
-				targetTaskId._taskInfo->_predecessors.insert(entry);
-				mustEmit = true;
-			}
+			mustEmit = targetTaskId._taskInfo->_predecessors.insert(entry);
 			targetTaskId._taskInfo->_lock.unlock();
 		}
 
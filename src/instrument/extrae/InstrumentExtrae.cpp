@@ -59,7 +59,7 @@ namespace Instrument {
 	std::atomic<size_t> _liveTasks(0);
 	std::atomic<size_t> _nextTracingPointKey(1);
 
-	RWSpinLock _extraeThreadCountLock;
+	Extrae::ThreadCountLock _extraeThreadCountLock;
 
 	int _externalThreadCount = 0;
 
@@ -7,6 +7,7 @@
 #ifndef INSTRUMENT_EXTRAE_HPP
 #define INSTRUMENT_EXTRAE_HPP
 
+#include "ExtraeThreadCountLock.hpp"
 #include "PreloadedExtraeBouncer.hpp"
 
 #include <nanos6.h>
@@ -14,7 +15,6 @@
 #include "InstrumentThreadId.hpp"
 #include "InstrumentTracingPointTypes.hpp"
 #include "support/config/ConfigVariable.hpp"
-#include "lowlevel/RWSpinLock.hpp"
 #include "lowlevel/SpinLock.hpp"
 #include "system/ompss/SpawnFunction.hpp"
 
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -105,6 +106,18 @@ namespace Instrument {
 
 		extern SpinLock _userFunctionMapLock;
 		extern user_fct_map_t _userFunctionMap;
+
+		//! \brief Record the function run by the tasks of a task info, so that
+		//! it is registered in Extrae at the end of the execution
+		inline void registerUserFunction(nanos6_task_info_t *taskInfo)
+		{
+			assert(taskInfo != nullptr);
+
+			user_fct_t userFunction(taskInfo);
+
+			std::lock_guard<SpinLock> guard(_userFunctionMapLock);
+			_userFunctionMap.insert(userFunction);
+		}
 	}
 
 	enum {
@@ -209,6 +222,7 @@ namespace Instrument {
 				EXTERNAL_RANK = 9800014,
 				NODE_NUM = 9800015,
 				APPRANK_NUM = 9800016,
+				TASK_NEW_BYTES_SAVED = 9800017,
 
 				// Dependencies system
 				DEPENDENCIES_SUBSYSTEM = 9900000,
@@ -264,7 +278,7 @@ namespace Instrument {
 	extern std::atomic<size_t> _liveTasks;
 	extern std::atomic<size_t> _nextTracingPointKey;
 
-	extern RWSpinLock _extraeThreadCountLock;
+	extern Extrae::ThreadCountLock _extraeThreadCountLock;
 
 	extern int _externalThreadCount;
 
@@ -154,9 +154,8 @@ namespace Instrument {
 					parentInTaskwait = taskId._taskInfo->_parent._taskInfo->_taskId;
 					ce.nCommunications++;
 
-					taskId._taskInfo->_parent._taskInfo->_predecessors.emplace(
-						taskId._taskInfo->_taskId,
-						control_dependency_tag
+					taskId._taskInfo->_parent._taskInfo->_predecessors.append(
+						Extrae::predecessor_entry_t(taskId._taskInfo->_taskId, control_dependency_tag)
 					);
 				}
 
@@ -376,9 +375,8 @@ namespace Instrument {
 						parentInTaskwait = taskforId._taskInfo->_parent._taskInfo->_taskId;
 						ce.nCommunications++;
 
-						taskforId._taskInfo->_parent._taskInfo->_predecessors.emplace(
-							taskforId._taskInfo->_taskId,
-							control_dependency_tag
+						taskforId._taskInfo->_parent._taskInfo->_predecessors.append(
+							Extrae::predecessor_entry_t(taskforId._taskInfo->_taskId, control_dependency_tag)
 						);
 					}
 					taskforId._taskInfo->_parent._taskInfo->_lock.unlock();
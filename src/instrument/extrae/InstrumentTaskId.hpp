@@ -15,7 +15,7 @@
 #include "InstrumentExtrae.hpp"
 
 #include <atomic>
-#include <set>
+#include <vector>
 
 
 namespace Instrument {
@@ -62,6 +62,78 @@ namespace Instrument {
 	namespace Extrae {
 		typedef std::pair<size_t, dependency_tag_t> predecessor_entry_t; // Task and strength
 
+		//! \brief The predecessors of a task. The first ones are kept inside the
+		//! list, so most tasks never allocate memory for them
+		class PredecessorList {
+		private:
+			enum {
+				inline_capacity = 8
+			};
+
+			predecessor_entry_t _inline[inline_capacity];
+			size_t _size;
+
+			//! Holds all the entries once the inline ones are exhausted
+			std::vector<predecessor_entry_t> _overflow;
+
+		public:
+			PredecessorList() :
+				_size(0),
+				_overflow()
+			{
+			}
+
+			//! \brief Add an entry that is known not to be in the list
+			inline void append(const predecessor_entry_t &entry)
+			{
+				if (_overflow.empty() && _size < inline_capacity) {
+					_inline[_size] = entry;
+				} else {
+					if (_overflow.empty()) {
+						_overflow.reserve(2 * inline_capacity);
+						_overflow.assign(_inline, _inline + _size);
+					}
+					_overflow.push_back(entry);
+				}
+				_size++;
+			}
+
+			//! \brief Add an entry unless it is already in the list
+			//!
+			//! \returns Whether the entry was added
+			inline bool insert(const predecessor_entry_t &entry)
+			{
+				for (const predecessor_entry_t &current : *this) {
+					if (current == entry)
+						return false;
+				}
+
+				append(entry);
+				return true;
+			}
+
+			inline void clear()
+			{
+				_size = 0;
+				_overflow.clear();
+			}
+
+			inline size_t size() const
+			{
+				return _size;
+			}
+
+			inline const predecessor_entry_t *begin() const
+			{
+				return _overflow.empty() ? _inline : _overflow.data();
+			}
+
+			inline const predecessor_entry_t *end() const
+			{
+				return begin() + _size;
+			}
+		};
+
 		struct TaskInfo {
 			nanos6_task_info_t *_taskInfo;
 			size_t _taskId;
@@ -72,7 +144,7 @@ namespace Instrument {
 			std::atomic<bool> _inTaskwait;
 
 			SpinLock _lock;
-			std::set<predecessor_entry_t> _predecessors;
+			PredecessorList _predecessors;
 
 			TaskInfo()
 				: _taskInfo(nullptr), _taskId(~0UL), _nestingLevel(-1), _priority(0), _parent(),
@@ -72,7 +72,7 @@ namespace Instrument {
 			ce.Communications[0].id = taskId._taskInfo->_taskId;
 
 			taskId._taskInfo->_lock.lock();
-			taskId._taskInfo->_predecessors.emplace(0, control_dependency_tag);
+			taskId._taskInfo->_predecessors.insert(Extrae::predecessor_entry_t(0, control_dependency_tag));
 			taskId._taskInfo->_lock.unlock();
 		}
 
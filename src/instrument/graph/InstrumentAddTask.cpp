@@ -6,7 +6,6 @@
 
 
 #include <cassert>
-#include <mutex>
 
 #include "ExecutionSteps.hpp"
 #include "InstrumentAddTask.hpp"
@@ -21,17 +20,9 @@ namespace Instrument {
 	using namespace Graph;
 
 
-	task_id_t enterCreateTask(
-		__attribute__((unused)) nanos6_task_info_t *taskInfo,
-		__attribute__((unused)) nanos6_task_invocation_info_t *taskInvokationInfo,
-		__attribute__((unused)) size_t flags,
-		__attribute__((unused)) bool taskRuntimeTransition,
-		InstrumentationContext const &context
-	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
-
-		// Get an ID for the task
-		task_id_t taskId = _nextTaskId++;
+	static void replayEnterCreateTask(graph_event_t const &event)
+	{
+		InstrumentationContext const &context = event._context;
 
 		// Set up the parent phase
 		if (context._taskId != task_id_t()) {
@@ -55,41 +46,26 @@ namespace Instrument {
 			}
 		}
 
-		create_task_step_t *createTaskStep = new create_task_step_t(context, taskId);
+		create_task_step_t *createTaskStep = new create_task_step_t(context, event._taskId);
 		_executionSequence.push_back(createTaskStep);
-
-		return taskId;
 	}
 
 
-	void createdArgsBlock(
-		__attribute__((unused)) task_id_t taskId,
-		__attribute__((unused)) void *argsBlockPointer,
-		__attribute__((unused)) size_t originalArgsBlockSize,
-		__attribute__((unused)) size_t argsBlockSize,
-		__attribute__((unused)) InstrumentationContext const &context)
+	static void replayCreatedTask(graph_event_t const &event)
 	{
-	}
-
-
-	void createdTask(
-		void *taskObject,
-		task_id_t taskId,
-		__attribute__((unused)) InstrumentationContext const &context
-	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		InstrumentationContext const &context = event._context;
+		task_id_t taskId = event._taskId;
 
 		// Create the task information
 		task_info_t &taskInfo = _taskToInfoMap[taskId];
 		assert(taskInfo._phaseList.empty());
 
-		Task *task = (Task *) taskObject;
-		taskInfo._nanos6_task_info = task->getTaskInfo();
-		taskInfo._nanos6_task_invocation_info = task->getTaskInvokationInfo();
+		taskInfo._nanos6_task_info = (nanos6_task_info_t *) event._pointer;
+		taskInfo._nanos6_task_invocation_info = (nanos6_task_invocation_info_t *) event._otherPointer;
 		taskInfo._parent = context._taskId;
 		taskInfo._status = not_created_status; // The simulation comes afterwards
 
-		taskInfo._isIf0 = task->isIf0();
+		taskInfo._isIf0 = event._isIf0;
 
 		if (context._taskId != task_id_t()) {
 			task_info_t &parentInfo = _taskToInfoMap[context._taskId];
@@ -118,6 +94,49 @@ namespace Instrument {
 		}
 	}
 
+
+	task_id_t enterCreateTask(
+		__attribute__((unused)) nanos6_task_info_t *taskInfo,
+		__attribute__((unused)) nanos6_task_invocation_info_t *taskInvokationInfo,
+		__attribute__((unused)) size_t flags,
+		__attribute__((unused)) bool taskRuntimeTransition,
+		InstrumentationContext const &context
+	) {
+		// Get an ID for the task
+		task_id_t taskId = _nextTaskId++;
+
+		graph_event_t &event = recordGraphEvent(replayEnterCreateTask, context);
+		event._taskId = taskId;
+
+		return taskId;
+	}
+
+
+	void createdArgsBlock(
+		__attribute__((unused)) task_id_t taskId,
+		__attribute__((unused)) void *argsBlockPointer,
+		__attribute__((unused)) size_t originalArgsBlockSize,
+		__attribute__((unused)) size_t argsBlockSize,
+		__attribute__((unused)) InstrumentationContext const &context)
+	{
+	}
+
+
+	void createdTask(
+		void *taskObject,
+		task_id_t taskId,
+		InstrumentationContext const &context
+	) {
+		// The task may no longer exist when the event is processed
+		Task *task = (Task *) taskObject;
+
+		graph_event_t &event = recordGraphEvent(replayCreatedTask, context);
+		event._taskId = taskId;
+		event._pointer = task->getTaskInfo();
+		event._otherPointer = task->getTaskInvokationInfo();
+		event._isIf0 = task->isIf0();
+	}
+
 	task_id_t enterInitTaskforCollaborator(
 		__attribute__((unused)) task_id_t taskforId,
 		__attribute__((unused)) nanos6_task_info_t *taskInfo,
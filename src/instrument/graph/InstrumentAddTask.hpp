@@ -37,6 +37,11 @@ namespace Instrument {
 	) {
 	}
 
+	inline void registeredTaskInfo(
+		__attribute__((unused)) nanos6_task_info_t *taskInfo
+	) {
+	}
+
 	inline void registeredNewSpawnedTaskType(
 		__attribute__((unused)) nanos6_task_info_t *taskInfo
 	) {
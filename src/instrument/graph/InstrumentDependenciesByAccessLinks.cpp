@@ -19,20 +19,23 @@
 namespace Instrument {
 	using namespace Graph;
 
-	data_access_id_t createdDataAccess(
-		data_access_id_t *superAccessId,
-		DataAccessType accessType, bool weak, DataAccessRegion region,
-		bool readSatisfied, bool writeSatisfied, bool globallySatisfied,
-		access_object_type_t objectType,
-		task_id_t originatorTaskId, InstrumentationContext const &context
-	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
-
-		data_access_id_t dataAccessId = Graph::_nextDataAccessId++;
+	static void replayCreatedDataAccess(graph_event_t const &event)
+	{
+		InstrumentationContext const &context = event._context;
+		data_access_id_t superAccess = event._superAccessId;
+		data_access_id_t dataAccessId = event._accessId;
+		DataAccessType accessType = event._accessType;
+		DataAccessRegion const &region = event._region;
+		bool weak = event._weak;
+		bool readSatisfied = event._readSatisfied;
+		bool writeSatisfied = event._writeSatisfied;
+		bool globallySatisfied = event._globallySatisfied;
+		access_object_type_t objectType = event._objectType;
+		task_id_t originatorTaskId = event._taskId;
 
 		create_data_access_step_t *step = new create_data_access_step_t(
 			context,
-			(superAccessId != nullptr ? *superAccessId : data_access_id_t()),
+			superAccess,
 			dataAccessId, accessType, region, weak,
 			readSatisfied, writeSatisfied, globallySatisfied,
 			originatorTaskId
@@ -55,11 +58,7 @@ namespace Instrument {
 		task_info_t &parentInfo = _taskToInfoMap[parentId];
 
 		access->_id = dataAccessId;
-		if (superAccessId != nullptr) {
-			access->_superAccess = *superAccessId;
-		} else {
-			access->_superAccess = data_access_id_t();
-		}
+		access->_superAccess = superAccess;
 
 		access->_originator = originatorTaskId;
 		if (!isTaskwaitFragment) {
@@ -106,11 +105,52 @@ namespace Instrument {
 			taskwait_fragment_t *taskwaitFragment = (taskwait_fragment_t *) access;
 			taskwaitFragment->_taskGroup = parentTaskGroup;
 		}
+	}
+
+
+	data_access_id_t createdDataAccess(
+		data_access_id_t *superAccessId,
+		DataAccessType accessType, bool weak, DataAccessRegion region,
+		bool readSatisfied, bool writeSatisfied, bool globallySatisfied,
+		access_object_type_t objectType,
+		task_id_t originatorTaskId, InstrumentationContext const &context
+	) {
+		data_access_id_t dataAccessId = Graph::_nextDataAccessId++;
+		data_access_id_t superAccess = (superAccessId != nullptr ? *superAccessId : data_access_id_t());
+
+		graph_event_t &event = recordGraphEvent(replayCreatedDataAccess, context);
+		event._superAccessId = superAccess;
+		event._accessId = dataAccessId;
+		event._accessType = accessType;
+		event._region = region;
+		event._weak = weak;
+		event._readSatisfied = readSatisfied;
+		event._writeSatisfied = writeSatisfied;
+		event._globallySatisfied = globallySatisfied;
+		event._objectType = objectType;
+		event._taskId = originatorTaskId;
 
 		return dataAccessId;
 	}
 
 
+	static void replayUpgradedDataAccess(graph_event_t const &event)
+	{
+		upgrade_data_access_step_t *step = new upgrade_data_access_step_t(
+			event._context,
+			event._accessId,
+			event._accessType, event._weak,
+			event._becomesUnsatisfied
+		);
+		_executionSequence.push_back(step);
+
+		// We need the final type of each access to calculate the full graph
+		access_t *access = _accessIdToAccessMap[event._accessId];
+		assert(access != nullptr);
+		access->_type = event._accessType;
+	}
+
+
 	void upgradedDataAccess(
 		data_access_id_t &dataAccessId,
 		__attribute__((unused)) DataAccessType previousAccessType,
@@ -125,20 +165,23 @@ namespace Instrument {
 			return;
 		}
 
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayUpgradedDataAccess, context);
+		event._accessId = dataAccessId;
+		event._accessType = newAccessType;
+		event._weak = newWeakness;
+		event._becomesUnsatisfied = becomesUnsatisfied;
+	}
 
-		upgrade_data_access_step_t *step = new upgrade_data_access_step_t(
-			context,
-			dataAccessId,
-			newAccessType, newWeakness,
-			becomesUnsatisfied
+
+	static void replayDataAccessBecomesSatisfied(graph_event_t const &event)
+	{
+		data_access_becomes_satisfied_step_t *step = new data_access_becomes_satisfied_step_t(
+			event._context,
+			event._accessId,
+			event._globallySatisfied,
+			event._taskId
 		);
 		_executionSequence.push_back(step);
-
-		// We need the final type of each access to calculate the full graph
-		access_t *access = _accessIdToAccessMap[dataAccessId];
-		assert(access != nullptr);
-		access->_type = newAccessType;
 	}
 
 
@@ -147,51 +190,50 @@ namespace Instrument {
 		bool globallySatisfied,
 		task_id_t targetTaskId, InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
-
-		data_access_becomes_satisfied_step_t *step = new data_access_becomes_satisfied_step_t(
-			context,
-			dataAccessId,
-			globallySatisfied,
-			targetTaskId
-		);
-		_executionSequence.push_back(step);
+		graph_event_t &event = recordGraphEvent(replayDataAccessBecomesSatisfied, context);
+		event._accessId = dataAccessId;
+		event._globallySatisfied = globallySatisfied;
+		event._taskId = targetTaskId;
 	}
 
 
-	void modifiedDataAccessRegion(
-		data_access_id_t &dataAccessId,
-		DataAccessRegion newRegion,
-		InstrumentationContext const &context
-	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
-
+	static void replayModifiedDataAccessRegion(graph_event_t const &event)
+	{
 		modified_data_access_region_step_t *step = new modified_data_access_region_step_t(
-			context,
-			dataAccessId,
-			newRegion
+			event._context,
+			event._accessId,
+			event._region
 		);
 		_executionSequence.push_back(step);
 
 		// We need the final region of each access to calculate the full graph
-		access_t *access = _accessIdToAccessMap[dataAccessId];
+		access_t *access = _accessIdToAccessMap[event._accessId];
 		assert(access != nullptr);
-		access->_accessRegion = newRegion;
+		access->_accessRegion = event._region;
 	}
 
 
-	data_access_id_t fragmentedDataAccess(
+	void modifiedDataAccessRegion(
 		data_access_id_t &dataAccessId,
 		DataAccessRegion newRegion,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayModifiedDataAccessRegion, context);
+		event._accessId = dataAccessId;
+		event._region = newRegion;
+	}
+
+
+	static void replayFragmentedDataAccess(graph_event_t const &event)
+	{
+		InstrumentationContext const &context = event._context;
+		data_access_id_t dataAccessId = event._accessId;
+		data_access_id_t newDataAccessId = event._otherAccessId;
+		DataAccessRegion const &newRegion = event._region;
 
 		access_t *originalAccess = _accessIdToAccessMap[dataAccessId];
 		assert(originalAccess != nullptr);
 
-		data_access_id_t newDataAccessId = Graph::_nextDataAccessId++;
-
 		fragment_data_access_step_t *step = new fragment_data_access_step_t(
 			context,
 			dataAccessId, newDataAccessId, newRegion
@@ -253,22 +295,34 @@ namespace Instrument {
 
 		// Link the new access/fragment into the access group
 		originalAccess->_nextGroupAccess = newDataAccessId;
-
-		return newDataAccessId;
 	}
 
 
-	data_access_id_t createdDataSubaccessFragment(
+	data_access_id_t fragmentedDataAccess(
 		data_access_id_t &dataAccessId,
+		DataAccessRegion newRegion,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		data_access_id_t newDataAccessId = Graph::_nextDataAccessId++;
+
+		graph_event_t &event = recordGraphEvent(replayFragmentedDataAccess, context);
+		event._accessId = dataAccessId;
+		event._otherAccessId = newDataAccessId;
+		event._region = newRegion;
+
+		return newDataAccessId;
+	}
+
+
+	static void replayCreatedDataSubaccessFragment(graph_event_t const &event)
+	{
+		InstrumentationContext const &context = event._context;
+		data_access_id_t dataAccessId = event._accessId;
+		data_access_id_t newDataAccessId = event._otherAccessId;
 
 		access_t *originalAccess = _accessIdToAccessMap[dataAccessId];
 		assert(originalAccess != nullptr);
 
-		data_access_id_t newDataAccessId = Graph::_nextDataAccessId++;
-
 		create_subaccess_fragment_step_t *step = new create_subaccess_fragment_step_t(
 			context,
 			dataAccessId, newDataAccessId
@@ -300,60 +354,89 @@ namespace Instrument {
 		taskGroup->_liveFragments.insert(AccessFragmentWrapper(fragment));
 
 		_accessIdToAccessMap[newDataAccessId] = fragment;
-
-		return newDataAccessId;
 	}
 
 
-	void completedDataAccess(
+	data_access_id_t createdDataSubaccessFragment(
 		data_access_id_t &dataAccessId,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		data_access_id_t newDataAccessId = Graph::_nextDataAccessId++;
+
+		graph_event_t &event = recordGraphEvent(replayCreatedDataSubaccessFragment, context);
+		event._accessId = dataAccessId;
+		event._otherAccessId = newDataAccessId;
+
+		return newDataAccessId;
+	}
 
+
+	static void replayCompletedDataAccess(graph_event_t const &event)
+	{
 		completed_data_access_step_t *step = new completed_data_access_step_t(
-			context,
-			dataAccessId
+			event._context,
+			event._accessId
 		);
 		_executionSequence.push_back(step);
 	}
 
 
-	void dataAccessBecomesRemovable(
+	void completedDataAccess(
 		data_access_id_t &dataAccessId,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayCompletedDataAccess, context);
+		event._accessId = dataAccessId;
+	}
+
 
+	static void replayDataAccessBecomesRemovable(graph_event_t const &event)
+	{
 		data_access_becomes_removable_step_t *step = new data_access_becomes_removable_step_t(
-			context,
-			dataAccessId
+			event._context,
+			event._accessId
 		);
 		_executionSequence.push_back(step);
 	}
 
 
-	void removedDataAccess(
+	void dataAccessBecomesRemovable(
 		data_access_id_t &dataAccessId,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayDataAccessBecomesRemovable, context);
+		event._accessId = dataAccessId;
+	}
 
+
+	static void replayRemovedDataAccess(graph_event_t const &event)
+	{
 		removed_data_access_step_t *step = new removed_data_access_step_t(
-			context,
-			dataAccessId
+			event._context,
+			event._accessId
 		);
 		_executionSequence.push_back(step);
 	}
 
 
-	void linkedDataAccesses(
-		data_access_id_t &sourceAccessId, task_id_t sinkTaskId, access_object_type_t sinkObjectType,
-		DataAccessRegion region,
-		bool direct, bool bidirectional,
+	void removedDataAccess(
+		data_access_id_t &dataAccessId,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayRemovedDataAccess, context);
+		event._accessId = dataAccessId;
+	}
+
+
+	static void replayLinkedDataAccesses(graph_event_t const &event)
+	{
+		InstrumentationContext const &context = event._context;
+		data_access_id_t sourceAccessId = event._accessId;
+		task_id_t sinkTaskId = event._taskId;
+		access_object_type_t sinkObjectType = event._objectType;
+		DataAccessRegion const &region = event._region;
+		bool direct = event._direct;
+		bool bidirectional = event._bidirectional;
 
 		access_t *sourceAccess = _accessIdToAccessMap[sourceAccessId];
 		assert(sourceAccess != nullptr);
@@ -371,17 +454,50 @@ namespace Instrument {
 	}
 
 
+	void linkedDataAccesses(
+		data_access_id_t &sourceAccessId, task_id_t sinkTaskId, access_object_type_t sinkObjectType,
+		DataAccessRegion region,
+		bool direct, bool bidirectional,
+		InstrumentationContext const &context
+	) {
+		graph_event_t &event = recordGraphEvent(replayLinkedDataAccesses, context);
+		event._accessId = sourceAccessId;
+		event._taskId = sinkTaskId;
+		event._objectType = sinkObjectType;
+		event._region = region;
+		event._direct = direct;
+		event._bidirectional = bidirectional;
+	}
+
+
+	static void replayUnlinkedDataAccesses(graph_event_t const &event)
+	{
+		unlinked_data_accesses_step_t *step = new unlinked_data_accesses_step_t(
+			event._context,
+			event._accessId, event._taskId, event._direct
+		);
+		_executionSequence.push_back(step);
+	}
+
+
 	void unlinkedDataAccesses(
 		data_access_id_t &sourceAccessId,
 		task_id_t sinkTaskId, __attribute__((unused)) access_object_type_t sinkObjectType,
 		bool direct,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayUnlinkedDataAccesses, context);
+		event._accessId = sourceAccessId;
+		event._taskId = sinkTaskId;
+		event._direct = direct;
+	}
 
-		unlinked_data_accesses_step_t *step = new unlinked_data_accesses_step_t(
-			context,
-			sourceAccessId, sinkTaskId, direct
+
+	static void replayReparentedDataAccess(graph_event_t const &event)
+	{
+		reparented_data_access_step_t *step = new reparented_data_access_step_t(
+			event._context,
+			event._otherAccessId, event._superAccessId, event._accessId
 		);
 		_executionSequence.push_back(step);
 	}
@@ -393,11 +509,19 @@ namespace Instrument {
 		data_access_id_t &dataAccessId,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+		graph_event_t &event = recordGraphEvent(replayReparentedDataAccess, context);
+		event._otherAccessId = oldSuperAccessId;
+		event._superAccessId = newSuperAccessId;
+		event._accessId = dataAccessId;
+	}
 
-		reparented_data_access_step_t *step = new reparented_data_access_step_t(
-			context,
-			oldSuperAccessId, newSuperAccessId, dataAccessId
+
+	static void replayNewDataAccessProperty(graph_event_t const &event)
+	{
+		new_data_access_property_step_t *step = new new_data_access_property_step_t(
+			event._context,
+			event._accessId,
+			(char const *) event._pointer, (char const *) event._otherPointer
 		);
 		_executionSequence.push_back(step);
 	}
@@ -409,14 +533,10 @@ namespace Instrument {
 		char const *longPropertyName,
 		InstrumentationContext const &context
 	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
-
-		new_data_access_property_step_t *step = new new_data_access_property_step_t(
-			context,
-			dataAccessId,
-			shortPropertyName, longPropertyName
-		);
-		_executionSequence.push_back(step);
+		graph_event_t &event = recordGraphEvent(replayNewDataAccessProperty, context);
+		event._accessId = dataAccessId;
+		event._pointer = shortPropertyName;
+		event._otherPointer = longPropertyName;
 	}
 
 	void newDataAccessLocation(
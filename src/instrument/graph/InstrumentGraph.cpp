@@ -4,6 +4,10 @@
 	Copyright (C) 2015-2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 #include "InstrumentGraph.hpp"
 
 #include <InstrumentTaskId.hpp>
@@ -24,10 +28,61 @@ namespace Instrument {
 		usermutex_to_id_map_t _usermutexToId;
 		execution_sequence_t _executionSequence;
 
-		SpinLock _graphLock;
-
 		ConfigVariable<bool> _showDependencyStructures("instrument.graph.show_dependency_structures");
 		ConfigVariable<bool> _showRegions("instrument.graph.show_regions");
 		ConfigVariable<bool> _showLog("instrument.graph.show_log");
+
+		//! The event buffers of all threads, which are only registered once
+		static std::vector<graph_event_buffer_t *> _graphEventBuffers;
+		static SpinLock _graphEventBuffersLock;
+
+
+		graph_event_buffer_t &getGraphEventBuffer()
+		{
+			static thread_local graph_event_buffer_t *buffer = nullptr;
+
+			if (buffer == nullptr) {
+				buffer = new graph_event_buffer_t();
+
+				std::lock_guard<SpinLock> guard(_graphEventBuffersLock);
+				_graphEventBuffers.push_back(buffer);
+			}
+
+			return *buffer;
+		}
+
+
+		void replayGraphEvents()
+		{
+			std::vector<graph_event_t *> events;
+			{
+				std::lock_guard<SpinLock> guard(_graphEventBuffersLock);
+				for (graph_event_buffer_t *buffer : _graphEventBuffers) {
+					for (graph_event_t &event : *buffer) {
+						events.push_back(&event);
+					}
+				}
+			}
+
+			// Each buffer is already ordered, but the interleaving between
+			// threads must be rebuilt. The sort is stable so that the events
+			// of a thread with the same timestamp keep their order
+			std::stable_sort(events.begin(), events.end(),
+				[](graph_event_t const *a, graph_event_t const *b) {
+					return a->_timestamp < b->_timestamp;
+				}
+			);
+
+			for (graph_event_t *event : events) {
+				assert(event->_handler != nullptr);
+				event->_handler(*event);
+			}
+
+			// The buffers stay registered, since their threads may still be alive
+			std::lock_guard<SpinLock> guard(_graphEventBuffersLock);
+			for (graph_event_buffer_t *buffer : _graphEventBuffers) {
+				buffer->clear();
+			}
+		}
 	}
 }
@@ -16,6 +16,7 @@
 #include "system/ompss/UserMutex.hpp"
 
 #include <InstrumentDataAccessId.hpp>
+#include <InstrumentInstrumentationContext.hpp>
 #include <InstrumentTaskId.hpp>
 
 #include <instrument/api/InstrumentDependenciesByAccessLinks.hpp>
@@ -25,6 +26,8 @@
 #include <atomic>
 #include <bitset>
 #include <cassert>
+#include <cstdint>
+#include <ctime>
 #include <deque>
 #include <list>
 #include <map>
@@ -474,7 +477,86 @@ namespace Instrument {
 		//! \brief sequence of task executions with their corresponding CPU
 		extern execution_sequence_t _executionSequence;
 
-		extern SpinLock _graphLock;
+		struct graph_event_t;
+
+		//! \brief Updates the graph with the arguments of an event
+		typedef void (*graph_event_handler_t)(graph_event_t const &event);
+
+		//! \brief A graph event whose processing is deferred until shutdown
+		//!
+		//! Events are fixed-size records, so recording them does not allocate
+		//! memory other than the chunks of the buffer. Each kind of event only
+		//! fills the fields that its handler reads
+		struct graph_event_t {
+			//! Handler of the event, which also identifies its kind
+			graph_event_handler_t _handler;
+
+			//! Monotonic time at which the event happened, in nanoseconds
+			uint64_t _timestamp;
+
+			InstrumentationContext _context;
+
+			task_id_t _taskId;
+			task_id_t _otherTaskId;
+
+			data_access_id_t _accessId;
+			data_access_id_t _otherAccessId;
+			data_access_id_t _superAccessId;
+
+			DataAccessRegion _region;
+			DataAccessType _accessType;
+			access_object_type_t _objectType;
+
+			bool _weak;
+			bool _readSatisfied;
+			bool _writeSatisfied;
+			bool _globallySatisfied;
+			bool _becomesUnsatisfied;
+			bool _direct;
+			bool _bidirectional;
+			bool _isIf0;
+
+			//! Arguments passed by address, such as the task info, the user
+			//! mutex or the property names
+			void const *_pointer;
+			void const *_otherPointer;
+		};
+
+		//! \brief Append-only buffer of the events of a thread
+		typedef std::deque<graph_event_t> graph_event_buffer_t;
+
+		//! \brief Get the event buffer of the current thread
+		graph_event_buffer_t &getGraphEventBuffer();
+
+		//! \brief Record an event into the buffer of the current thread
+		//!
+		//! \param[in] handler The function that processes the event at shutdown
+		//! \param[in] context The instrumentation context of the event
+		//!
+		//! \returns The new event, whose arguments must be filled by the caller
+		static inline graph_event_t &recordGraphEvent(
+			graph_event_handler_t handler,
+			InstrumentationContext const &context
+		) {
+			// The events of all threads are merged by their timestamp, so
+			// they do not need to share a counter
+			struct timespec now;
+			__attribute__((unused)) int rc = clock_gettime(CLOCK_MONOTONIC, &now);
+			assert(rc == 0);
+
+			graph_event_buffer_t &buffer = getGraphEventBuffer();
+			buffer.emplace_back();
+
+			graph_event_t &event = buffer.back();
+			event._handler = handler;
+			event._timestamp = (uint64_t) now.tv_sec * 1000000000UL + now.tv_nsec;
+			event._context = context;
+
+			return event;
+		}
+
+		//! \brief Process all recorded events in their global order
+		void replayGraphEvents();
 
 		extern ConfigVariable<bool> _showDependencyStructures;
 		extern ConfigVariable<bool> _showRegions;
@@ -1395,6 +1395,9 @@ namespace Instrument {
 			FatalErrorHandler::handle(errno, " trying to create directory '", dir, "'");
 		}
 
+		// Rebuild the graph from the events recorded during the execution
+		replayGraphEvents();
+
 		// Derive the actual edges from the access links
 		generateEdges();
 
@@ -38,6 +38,20 @@ namespace Instrument {
 			stream << content1;
 			fillStream(stream, contents...);
 		}
+		
+		static inline void replayLogMessage(graph_event_t const &event)
+		{
+			std::string const *message = (std::string const *) event._pointer;
+			assert(message != nullptr);
+			
+			log_message_step_t *step = new log_message_step_t(
+				event._context,
+				*message
+			);
+			_executionSequence.push_back(step);
+			
+			delete message;
+		}
 	}
 	
 	
@@ -47,12 +61,9 @@ namespace Instrument {
 		std::ostringstream stream;
 		fillStream(stream, contents...);
 		
-		std::lock_guard<SpinLock> guard(_graphLock);
-		log_message_step_t *step = new log_message_step_t(
-			context,
-			stream.str()
-		);
-		_executionSequence.push_back(step);
+		// The message does not fit in the event, so it is kept apart
+		graph_event_t &event = recordGraphEvent(replayLogMessage, context);
+		event._pointer = new std::string(stream.str());
 	}
 	
 }
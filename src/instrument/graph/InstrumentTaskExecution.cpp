@@ -10,52 +10,69 @@
 
 #include <InstrumentInstrumentationContext.hpp>
 
-#include <mutex>
-
 
 namespace Instrument {
 	using namespace Graph;
 
 
-	void startTask(__attribute__((unused)) task_id_t taskId, InstrumentationContext const &context)
+	static void replayStartTask(graph_event_t const &event)
 	{
-		std::lock_guard<SpinLock> guard(_graphLock);
-		enter_task_step_t *enterTaskStep = new enter_task_step_t(context);
+		enter_task_step_t *enterTaskStep = new enter_task_step_t(event._context);
 		_executionSequence.push_back(enterTaskStep);
 	}
 
-	void endTask(__attribute__((unused)) task_id_t taskId, InstrumentationContext const &context)
+	static void replayEndTask(graph_event_t const &event)
 	{
-		std::lock_guard<SpinLock> guard(_graphLock);
-		exit_task_step_t *exitTaskStep = new exit_task_step_t(context);
+		exit_task_step_t *exitTaskStep = new exit_task_step_t(event._context);
 		_executionSequence.push_back(exitTaskStep);
 	}
 
-	void startTaskforCollaborator(__attribute__((unused)) task_id_t taskforId, __attribute__((unused)) task_id_t collaboratorId, __attribute__((unused)) bool first, InstrumentationContext const &context)
+	static void replayStartTaskforCollaborator(graph_event_t const &event)
 	{
-		assert(_taskToInfoMap.find(taskforId) != _taskToInfoMap.end());
-		task_info_t &taskforInfo = _taskToInfoMap[taskforId];
+		assert(_taskToInfoMap.find(event._taskId) != _taskToInfoMap.end());
+		task_info_t &taskforInfo = _taskToInfoMap[event._taskId];
 
-		std::lock_guard<SpinLock> guard(_graphLock);
 		if (taskforInfo._state == INITIAL) {
-			enter_task_step_t *enterTaskStep = new enter_task_step_t(context);
+			enter_task_step_t *enterTaskStep = new enter_task_step_t(event._context);
 			_executionSequence.push_back(enterTaskStep);
 			taskforInfo._state = STARTED;
 		}
 		assert(taskforInfo._state == STARTED);
 	}
 
-	void endTaskforCollaborator(__attribute__((unused)) task_id_t taskforId, __attribute__((unused)) task_id_t collaboratorId, bool last, InstrumentationContext const &context)
+	static void replayEndTaskforCollaborator(graph_event_t const &event)
+	{
+		assert(_taskToInfoMap.find(event._taskId) != _taskToInfoMap.end());
+		task_info_t &taskforInfo = _taskToInfoMap[event._taskId];
+
+		assert(taskforInfo._state == STARTED);
+		exit_task_step_t *exitTaskStep = new exit_task_step_t(event._context);
+		_executionSequence.push_back(exitTaskStep);
+		taskforInfo._state = FINISHED;
+	}
+
+
+	void startTask(__attribute__((unused)) task_id_t taskId, InstrumentationContext const &context)
+	{
+		recordGraphEvent(replayStartTask, context);
+	}
+
+	void endTask(__attribute__((unused)) task_id_t taskId, InstrumentationContext const &context)
+	{
+		recordGraphEvent(replayEndTask, context);
+	}
+
+	void startTaskforCollaborator(task_id_t taskforId, __attribute__((unused)) task_id_t collaboratorId, __attribute__((unused)) bool first, InstrumentationContext const &context)
+	{
+		graph_event_t &event = recordGraphEvent(replayStartTaskforCollaborator, context);
+		event._taskId = taskforId;
+	}
+
+	void endTaskforCollaborator(task_id_t taskforId, __attribute__((unused)) task_id_t collaboratorId, bool last, InstrumentationContext const &context)
 	{
 		if (last) {
-			assert(_taskToInfoMap.find(taskforId) != _taskToInfoMap.end());
-			task_info_t &taskforInfo = _taskToInfoMap[taskforId];
-
-			std::lock_guard<SpinLock> guard(_graphLock);
-			assert(taskforInfo._state == STARTED);
-			exit_task_step_t *exitTaskStep = new exit_task_step_t(context);
-			_executionSequence.push_back(exitTaskStep);
-			taskforInfo._state = FINISHED;
+			graph_event_t &event = recordGraphEvent(replayEndTaskforCollaborator, context);
+			event._taskId = taskforId;
 		}
 	}
 }
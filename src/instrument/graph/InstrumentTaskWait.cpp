@@ -18,18 +18,13 @@ namespace Instrument {
 	using namespace Graph;
 
 
-	void enterTaskWait(
-		task_id_t taskId,
-		char const *invocationSource,
-		task_id_t if0TaskId,
-		__attribute__((unused)) bool taskRuntimeTransition,
-		InstrumentationContext const &context
-	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
+	static void replayEnterTaskWait(graph_event_t const &event)
+	{
+		task_id_t taskId = event._taskId;
 		task_info_t &taskInfo = _taskToInfoMap[taskId];
 
 		taskwait_id_t taskwaitId = _nextTaskwaitId++;
-		taskwait_t *taskwait = new taskwait_t(taskwaitId, invocationSource, if0TaskId);
+		taskwait_t *taskwait = new taskwait_t(taskwaitId, (char const *) event._pointer, event._otherTaskId);
 		taskwait->_task = taskId;
 		taskwait->_taskPhaseIndex = taskInfo._phaseList.size();
 		_taskwaitToInfoMap[taskwaitId] = taskwait;
@@ -40,19 +35,15 @@ namespace Instrument {
 			currentPhase->_nextTaskwaitId = taskwaitId;
 		}
 
-		enter_taskwait_step_t *enterTaskwaitStep = new enter_taskwait_step_t(context, taskwaitId);
+		enter_taskwait_step_t *enterTaskwaitStep = new enter_taskwait_step_t(event._context, taskwaitId);
 		taskInfo._phaseList.push_back(taskwait);
 		_executionSequence.push_back(enterTaskwaitStep);
 	}
 
 
-	void exitTaskWait(
-		task_id_t taskId,
-		__attribute__((unused)) bool taskRuntimeTransition,
-		InstrumentationContext const &context
-	) {
-		std::lock_guard<SpinLock> guard(_graphLock);
-		task_info_t &taskInfo = _taskToInfoMap[taskId];
+	static void replayExitTaskWait(graph_event_t const &event)
+	{
+		task_info_t &taskInfo = _taskToInfoMap[event._taskId];
 
 		assert(!taskInfo._phaseList.empty());
 		phase_t *taskwaitPhase = taskInfo._phaseList.back();
@@ -60,8 +51,32 @@ namespace Instrument {
 		assert(taskwait != nullptr);
 		taskwait_id_t taskwaitId = taskwait->_taskwaitId;
 
-		exit_taskwait_step_t *exitTaskwaitStep = new exit_taskwait_step_t(context, taskwaitId);
+		exit_taskwait_step_t *exitTaskwaitStep = new exit_taskwait_step_t(event._context, taskwaitId);
 		_executionSequence.push_back(exitTaskwaitStep);
+	}
+
+
+	void enterTaskWait(
+		task_id_t taskId,
+		char const *invocationSource,
+		task_id_t if0TaskId,
+		__attribute__((unused)) bool taskRuntimeTransition,
+		InstrumentationContext const &context
+	) {
+		graph_event_t &event = recordGraphEvent(replayEnterTaskWait, context);
+		event._taskId = taskId;
+		event._otherTaskId = if0TaskId;
+		event._pointer = invocationSource;
+	}
+
+
+	void exitTaskWait(
+		task_id_t taskId,
+		__attribute__((unused)) bool taskRuntimeTransition,
+		InstrumentationContext const &context
+	) {
+		graph_event_t &event = recordGraphEvent(replayExitTaskWait, context);
+		event._taskId = taskId;
 
 		// Instead of calling to Instrument::returnToTask we later on reuse the exitTaskwaitStep to also reactivate the task
 	}
@@ -19,7 +19,7 @@
 namespace Instrument {
 	using namespace Graph;
 	
-	static inline usermutex_id_t getUserMutexId(UserMutex *userMutex, __attribute__((unused)) std::lock_guard<SpinLock> const &guard)
+	static inline usermutex_id_t getUserMutexId(UserMutex *userMutex)
 	{
 		usermutex_id_t usermutexId;
 		
@@ -34,35 +34,47 @@ namespace Instrument {
 		return usermutexId;
 	}
 	
-	void acquiredUserMutex(UserMutex *userMutex, InstrumentationContext const &context)
+	static void replayAcquiredUserMutex(graph_event_t const &event)
 	{
-		std::lock_guard<SpinLock> guard(_graphLock);
-		
-		usermutex_id_t usermutexId = getUserMutexId(userMutex, guard);
+		usermutex_id_t usermutexId = getUserMutexId((UserMutex *) event._pointer);
 		
-		enter_usermutex_step_t *enterUsermutexStep = new enter_usermutex_step_t(context, usermutexId);
+		enter_usermutex_step_t *enterUsermutexStep = new enter_usermutex_step_t(event._context, usermutexId);
 		_executionSequence.push_back(enterUsermutexStep);
 	}
 	
-	void blockedOnUserMutex(UserMutex *userMutex, InstrumentationContext const &context)
+	static void replayBlockedOnUserMutex(graph_event_t const &event)
 	{
-		std::lock_guard<SpinLock> guard(_graphLock);
+		usermutex_id_t usermutexId = getUserMutexId((UserMutex *) event._pointer);
 		
-		usermutex_id_t usermutexId = getUserMutexId(userMutex, guard);
-		
-		block_on_usermutex_step_t *blockOnUsermutexStep = new block_on_usermutex_step_t(context, usermutexId);
+		block_on_usermutex_step_t *blockOnUsermutexStep = new block_on_usermutex_step_t(event._context, usermutexId);
 		_executionSequence.push_back(blockOnUsermutexStep);
 	}
 	
-	void releasedUserMutex(UserMutex *userMutex, InstrumentationContext const &context)
+	static void replayReleasedUserMutex(graph_event_t const &event)
 	{
-		std::lock_guard<SpinLock> guard(_graphLock);
+		usermutex_id_t usermutexId = getUserMutexId((UserMutex *) event._pointer);
 		
-		usermutex_id_t usermutexId = getUserMutexId(userMutex, guard);
-		
-		exit_usermutex_step_t *exitUsermutexStep = new exit_usermutex_step_t(context, usermutexId);
+		exit_usermutex_step_t *exitUsermutexStep = new exit_usermutex_step_t(event._context, usermutexId);
 		_executionSequence.push_back(exitUsermutexStep);
 	}
 	
+	void acquiredUserMutex(UserMutex *userMutex, InstrumentationContext const &context)
+	{
+		graph_event_t &event = recordGraphEvent(replayAcquiredUserMutex, context);
+		event._pointer = userMutex;
+	}
+	
+	void blockedOnUserMutex(UserMutex *userMutex, InstrumentationContext const &context)
+	{
+		graph_event_t &event = recordGraphEvent(replayBlockedOnUserMutex, context);
+		event._pointer = userMutex;
+	}
+	
+	void releasedUserMutex(UserMutex *userMutex, InstrumentationContext const &context)
+	{
+		graph_event_t &event = recordGraphEvent(replayReleasedUserMutex, context);
+		event._pointer = userMutex;
+	}
+	
 }
 
@@ -20,7 +20,9 @@ namespace Instrument {
 		bool,
 		InstrumentationContext const &context
 	) {
-		Stats::TaskTypeAndTimes *taskTypeAndTimes = new Stats::TaskTypeAndTimes(taskInfo, (context._taskId != task_id_t()));
+		Stats::TaskTypeAndTimes *taskTypeAndTimes = new Stats::TaskTypeAndTimes(
+			taskInfo, (context._taskId != task_id_t()), context._taskId._contents
+		);
 
 		return taskTypeAndTimes;
 	}
@@ -76,6 +78,11 @@ namespace Instrument {
 	) {
 	}
 
+	inline void registeredTaskInfo(
+		__attribute__((unused)) nanos6_task_info_t *taskInfo
+	) {
+	}
+
 	inline void registeredNewSpawnedTaskType(
 		__attribute__((unused)) nanos6_task_info_t *taskInfo
 	) {
@@ -36,7 +36,9 @@ namespace Instrument {
 		"Fetch required",
 		"Found in pending",
 		"Early Write ID",
-		"Late Write ID"
+		"Late Write ID",
+		"Coalesced",
+		"Prefetched"
 	};
 
 	void initClusterCounters()
@@ -1 +0,0 @@
-../null/InstrumentDataAccessId.hpp
\ No newline at end of file
@@ -0,0 +1,40 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2015-2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef INSTRUMENT_STATS_DATA_ACCESS_ID_HPP
+#define INSTRUMENT_STATS_DATA_ACCESS_ID_HPP
+
+
+namespace Instrument {
+	namespace Stats {
+		struct TaskTypeAndTimes;
+	}
+
+	//! The data accesses are identified by the task that originated them,
+	//! which is all that the critical path analysis needs. Fragments and
+	//! taskwait accesses do not have an originator
+	struct data_access_id_t {
+		Stats::TaskTypeAndTimes *_originator;
+
+		data_access_id_t(Stats::TaskTypeAndTimes *originator = nullptr)
+			: _originator(originator)
+		{
+		}
+
+		bool operator==(data_access_id_t const &other) const
+		{
+			return (_originator == other._originator);
+		}
+
+		bool operator!=(data_access_id_t const &other) const
+		{
+			return (_originator != other._originator);
+		}
+	};
+}
+
+
+#endif // INSTRUMENT_STATS_DATA_ACCESS_ID_HPP
@@ -0,0 +1,154 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2015-2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef INSTRUMENT_STATS_DEPENDENCIES_BY_ACCESS_LINK_HPP
+#define INSTRUMENT_STATS_DEPENDENCIES_BY_ACCESS_LINK_HPP
+
+
+#include "InstrumentStats.hpp"
+#include "instrument/api/InstrumentDependenciesByAccessLinks.hpp"
+
+
+namespace Instrument {
+	inline data_access_id_t createdDataAccess(
+		__attribute__((unused)) data_access_id_t *superAccessId,
+		__attribute__((unused)) DataAccessType accessType,
+		__attribute__((unused)) bool weak,
+		__attribute__((unused)) DataAccessRegion region,
+		__attribute__((unused)) bool readSatisfied,
+		__attribute__((unused)) bool writeSatisfied,
+		__attribute__((unused)) bool globallySatisfied,
+		access_object_type_t objectType,
+		task_id_t originatorTaskId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+		if (objectType != regular_access_type) {
+			return data_access_id_t();
+		}
+
+		return data_access_id_t(originatorTaskId._contents);
+	}
+
+	inline void upgradedDataAccess(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) DataAccessType previousAccessType,
+		__attribute__((unused)) bool previousWeakness,
+		__attribute__((unused)) DataAccessType newAccessType,
+		__attribute__((unused)) bool newWeakness,
+		__attribute__((unused)) bool becomesUnsatisfied,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void dataAccessBecomesSatisfied(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) bool globallySatisfied,
+		__attribute__((unused)) task_id_t targetTaskId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void modifiedDataAccessRegion(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) DataAccessRegion newRegion,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline data_access_id_t fragmentedDataAccess(
+		data_access_id_t &dataAccessId,
+		__attribute__((unused)) DataAccessRegion newRegion,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+		return dataAccessId;
+	}
+
+	inline data_access_id_t createdDataSubaccessFragment(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+		return data_access_id_t();
+	}
+
+	inline void completedDataAccess(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void dataAccessBecomesRemovable(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void removedDataAccess(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void linkedDataAccesses(
+		data_access_id_t &sourceAccessId,
+		task_id_t sinkTaskId,
+		access_object_type_t sinkObjectType,
+		__attribute__((unused)) DataAccessRegion region,
+		__attribute__((unused)) bool direct,
+		__attribute__((unused)) bool bidirectional,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+		// Only the links between the accesses of sibling tasks are dependencies
+		if (sourceAccessId._originator != nullptr && sinkObjectType == regular_access_type) {
+			if (sinkTaskId != task_id_t() && sinkTaskId._contents != sourceAccessId._originator) {
+				Stats::linkTasks(sourceAccessId._originator, sinkTaskId._contents);
+			}
+		}
+	}
+
+	inline void unlinkedDataAccesses(
+		__attribute__((unused)) data_access_id_t &sourceAccessId,
+		__attribute__((unused)) task_id_t sinkTaskId,
+		__attribute__((unused)) access_object_type_t sinkObjectType,
+		__attribute__((unused)) bool direct,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void reparentedDataAccess(
+		__attribute__((unused)) data_access_id_t &oldSuperAccessId,
+		__attribute__((unused)) data_access_id_t &newSuperAccessId,
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void newDataAccessProperty(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) char const *shortPropertyName,
+		__attribute__((unused)) char const *longPropertyName,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void newDataAccessLocation(
+		__attribute__((unused)) data_access_id_t &dataAccessId,
+		__attribute__((unused)) MemoryPlace const *newLocation,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+
+	inline void automataMessage(
+		__attribute__((unused)) data_access_id_t &dataAccessIdFrom,
+		__attribute__((unused)) data_access_id_t &dataAccessIdTo,
+		__attribute__((unused)) unsigned int flags,
+		__attribute__((unused)) unsigned int oldFlags,
+		__attribute__((unused)) InstrumentationContext const &context
+	) {
+	}
+}
+
+
+#endif // INSTRUMENT_STATS_DEPENDENCIES_BY_ACCESS_LINK_HPP
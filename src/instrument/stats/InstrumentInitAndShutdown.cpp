@@ -191,6 +191,32 @@ if (0) {
 		}
 }
 
+		{
+			double work = accumulatedTaskInfo._times._executionTime;
+			double criticalPath = _criticalPathLength;
+			double readyOrRunning = (double) accumulatedTaskInfo._times._readyTime + work;
+
+			// Threads are blocked when there are no ready tasks to run, and
+			// the scheduler server only serves while other threads wait
+			double idleTime = (double) accumulatedPhaseInfo._blockedTime
+				+ (double) accumulatedThreadInfo._schedulerServingTime;
+
+			output << "STATS\t" << "Critical path length\t" << criticalPath << "\t" << Timer::getUnits() << std::endl;
+			output << "STATS\t" << "Total work\t" << work << "\t" << Timer::getUnits() << std::endl;
+			if (criticalPath > 0.0) {
+				output << "STATS\t" << "Maximum speedup\t" << work / criticalPath << std::endl;
+			}
+			output << "STATS\t" << "Mean available parallelism\t" << readyOrRunning / totalTime << std::endl;
+			output << "STATS\t" << "Mean effective parallelism\t" << work / totalTime << std::endl;
+			output << "STATS\t" << "Idle time without ready tasks\t" << idleTime << "\t" << Timer::getUnits()
+				<< "\t" << 100.0 * idleTime / totalThreadTime << "\t%" << std::endl;
+			output << "STATS\t" << "Scheduler lock time\t" << (double) accumulatedThreadInfo._schedulerLockTime
+				<< "\t" << Timer::getUnits() << std::endl;
+			output << "STATS\t" << "Task time blocked in taskwaits\t" << (double) accumulatedThreadInfo._taskwaitTime
+				<< "\t" << Timer::getUnits() << std::endl;
+			output << std::endl;
+		}
+
 #ifdef USE_CLUSTER
 		showClusterCounters(output);
 #endif
@@ -1 +0,0 @@
-../null/InstrumentScheduler.hpp
\ No newline at end of file
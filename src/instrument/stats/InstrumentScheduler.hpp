@@ -0,0 +1,61 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020-2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef INSTRUMENT_STATS_SCHEDULER_HPP
+#define INSTRUMENT_STATS_SCHEDULER_HPP
+
+#include "../api/InstrumentScheduler.hpp"
+#include "InstrumentTaskId.hpp"
+#include "InstrumentThreadLocalData.hpp"
+#include "instrument/support/InstrumentThreadLocalDataSupport.hpp"
+
+
+namespace Instrument {
+	inline void enterAddReadyTask() {}
+	inline void exitAddReadyTask() {}
+	inline void enterGetReadyTask() {}
+	inline void exitGetReadyTask() {}
+
+	inline void enterSchedulerLock()
+	{
+		ThreadLocalData &threadLocal = getThreadLocalData();
+		threadLocal._threadInfo._schedulerLockTime.start();
+	}
+
+	inline void schedulerLockBecomesServer()
+	{
+		ThreadLocalData &threadLocal = getThreadLocalData();
+		Stats::ThreadInfo &threadInfo = threadLocal._threadInfo;
+		threadInfo._schedulerLockTime.continueAt(threadInfo._schedulerServingTime);
+	}
+
+	inline void exitSchedulerLockAsClient(
+		__attribute__((unused)) task_id_t taskId
+	) {
+		ThreadLocalData &threadLocal = getThreadLocalData();
+		threadLocal._threadInfo._schedulerLockTime.stop();
+	}
+
+	inline void exitSchedulerLockAsClient()
+	{
+		ThreadLocalData &threadLocal = getThreadLocalData();
+		threadLocal._threadInfo._schedulerLockTime.stop();
+	}
+
+	inline void schedulerLockServesTask(
+		__attribute__((unused)) task_id_t taskId
+	) {
+	}
+
+	inline void exitSchedulerLockAsServer()
+	{
+		ThreadLocalData &threadLocal = getThreadLocalData();
+		threadLocal._threadInfo._schedulerServingTime.stop();
+	}
+}
+
+
+#endif // INSTRUMENT_STATS_SCHEDULER_HPP
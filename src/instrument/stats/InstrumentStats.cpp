@@ -6,6 +6,7 @@
 
 #include "InstrumentStats.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>      // std::setw
 #include <string>
@@ -21,9 +22,94 @@ namespace Instrument {
 
 		Timer _totalTime(true);
 
+		std::atomic<double> _criticalPathLength(0.0);
+
 		std::array<std::atomic<size_t>, NANOS_DEPENDENCY_STATE_TYPES>
 			nanos6_dependency_state_stats = {};
 
+		static inline void updateMaximum(std::atomic<double> &value, double candidate)
+		{
+			double current = value.load();
+			while (candidate > current && !value.compare_exchange_weak(current, candidate)) {
+			}
+		}
+
+		static void taskCompleted(TaskTypeAndTimes *task)
+		{
+			assert(task != nullptr);
+
+			// The task and all its children have finished, so the time at
+			// which it finishes along the critical path is known
+			double finish = std::max(
+				task->_earliestStart.load() + (double) task->_times._executionTime,
+				task->_childrenFinish.load()
+			);
+
+			std::vector<TaskTypeAndTimes *> successors;
+			task->_lock.lock();
+			task->_earliestFinish = finish;
+			task->_finished = true;
+			successors.swap(task->_successors);
+			task->_lock.unlock();
+
+			for (TaskTypeAndTimes *successor : successors) {
+				updateMaximum(successor->_earliestStart, finish);
+				releaseTaskTimes(successor);
+			}
+
+			updateMaximum(_criticalPathLength, finish);
+
+			TaskTypeAndTimes *parent = task->_parent;
+			if (parent != nullptr) {
+				updateMaximum(parent->_childrenFinish, finish);
+				if (--parent->_pendingCompletions == 0) {
+					taskCompleted(parent);
+				}
+				releaseTaskTimes(parent);
+			}
+		}
+
+		void taskBodyCompleted(TaskTypeAndTimes *task)
+		{
+			assert(task != nullptr);
+
+			if (!task->_bodyCompleted.exchange(true)) {
+				if (--task->_pendingCompletions == 0) {
+					taskCompleted(task);
+				}
+			}
+		}
+
+		void linkTasks(TaskTypeAndTimes *predecessor, TaskTypeAndTimes *successor)
+		{
+			assert(predecessor != nullptr);
+			assert(successor != nullptr);
+
+			predecessor->_lock.lock();
+			if (predecessor->_finished) {
+				double finish = predecessor->_earliestFinish;
+				predecessor->_lock.unlock();
+
+				updateMaximum(successor->_earliestStart, finish);
+			} else {
+				successor->_references++;
+				predecessor->_successors.push_back(successor);
+				predecessor->_lock.unlock();
+			}
+		}
+
+		void releaseTaskTimes(TaskTypeAndTimes *task)
+		{
+			assert(task != nullptr);
+
+			if (--task->_references == 0) {
+				for (TaskTypeAndTimes *successor : task->_successors) {
+					releaseTaskTimes(successor);
+				}
+				delete task;
+			}
+		}
+
 		void show_dependency_state_stats(std::ostream &output)
 		{
 			std::array<std::string, NANOS_DEPENDENCY_STATE_TYPES> dependency_state_names =
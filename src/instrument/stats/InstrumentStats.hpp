@@ -7,6 +7,8 @@
 #ifndef INSTRUMENT_STATS_HPP
 #define INSTRUMENT_STATS_HPP
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <map>
 #include <vector>
@@ -152,13 +154,60 @@ namespace Instrument {
 			bool _hasParent;
 			Timer *_currentTimer;
 
-			TaskTypeAndTimes(nanos6_task_info_t const *type, bool hasParent)
-				: _type(type), _times(false), _hasParent(hasParent), _currentTimer(&_times._instantiationTime)
+			//! Time blocked in taskwaits, which is also part of the blocked time
+			Timer _taskwaitTime;
+
+			// Critical path bookkeeping. The times are the length of the
+			// longest chain of task executions that leads to each point
+
+			//! The parent, if it takes part of the critical path
+			TaskTypeAndTimes *_parent;
+
+			//! The task itself, its parent if any and its predecessors hold
+			//! references so that the object outlives the task
+			std::atomic<int> _references;
+
+			//! The body of the task and each of its children
+			std::atomic<int> _pendingCompletions;
+			std::atomic<bool> _bodyCompleted;
+
+			std::atomic<double> _earliestStart;
+			std::atomic<double> _childrenFinish;
+
+			//! The successors are protected by the lock, and they are
+			//! updated once the task and all its children have finished
+			std::vector<TaskTypeAndTimes *> _successors;
+			bool _finished;
+			double _earliestFinish;
+
+			TaskTypeAndTimes(nanos6_task_info_t const *type, bool hasParent, TaskTypeAndTimes *parent = nullptr)
+				: _type(type), _times(false), _hasParent(hasParent), _currentTimer(&_times._instantiationTime),
+				_taskwaitTime(), _parent(parent), _references(1), _pendingCompletions(1), _bodyCompleted(false),
+				_earliestStart(0.0), _childrenFinish(0.0), _successors(), _finished(false), _earliestFinish(0.0)
 			{
+				if (parent != nullptr) {
+					parent->_references++;
+					parent->_pendingCompletions++;
+					_earliestStart = parent->_earliestStart.load();
+				}
 			}
 		};
 
 
+		//! \brief Length of the longest chain of task executions
+		extern std::atomic<double> _criticalPathLength;
+
+		//! \brief Mark the body of a task as completed. Called once the task
+		//! has finished running or, if it has no body, when it is destroyed
+		void taskBodyCompleted(TaskTypeAndTimes *task);
+
+		//! \brief Record that a task cannot start before another finishes
+		void linkTasks(TaskTypeAndTimes *predecessor, TaskTypeAndTimes *successor);
+
+		//! \brief Drop a reference to the times of a task
+		void releaseTaskTimes(TaskTypeAndTimes *task);
+
+
 		struct PhaseInfo {
 			std::map<nanos6_task_info_t const *, TaskInfo> _perTask;
 			Timer _runningTime;
@@ -215,14 +264,28 @@ namespace Instrument {
 		struct ThreadInfo {
 			std::list<PhaseInfo> _phaseInfo;
 
+			//! Time waiting to acquire or to be served by the scheduler lock
+			Timer _schedulerLockTime;
+
+			//! Time holding the scheduler lock while there is no ready task
+			//! for the current thread
+			Timer _schedulerServingTime;
+
+			//! Time that the tasks destroyed by this thread were blocked in taskwaits
+			Timer _taskwaitTime;
+
 			ThreadInfo(bool active=true)
-				: _phaseInfo()
+				: _phaseInfo(), _schedulerLockTime(), _schedulerServingTime(), _taskwaitTime()
 			{
 				_phaseInfo.emplace_back(active);
 			}
 
 			ThreadInfo &operator+=(ThreadInfo const &other)
 			{
+				_schedulerLockTime += other._schedulerLockTime;
+				_schedulerServingTime += other._schedulerServingTime;
+				_taskwaitTime += other._taskwaitTime;
+
 				unsigned int phases = other._phaseInfo.size();
 
 				while (_phaseInfo.size() < phases) {
@@ -17,8 +17,9 @@ namespace Instrument {
 	{
 	}
 
-	inline void endTask(task_id_t, InstrumentationContext const &)
+	inline void endTask(task_id_t taskId, InstrumentationContext const &)
 	{
+		Stats::taskBodyCompleted(taskId);
 	}
 
 	inline void destroyTask(task_id_t taskId, InstrumentationContext const &)
@@ -32,16 +33,22 @@ namespace Instrument {
 		Instrument::Stats::PhaseInfo &phaseInfo = threadLocal._threadInfo.getCurrentPhaseRef();
 		Instrument::Stats::TaskInfo &taskInfo = phaseInfo._perTask[taskId->_type];
 		taskInfo += taskId->_times;
+		threadLocal._threadInfo._taskwaitTime += taskId->_taskwaitTime;
 
-		delete taskId;
+		// Tasks without body do not end, so they complete when destroyed
+		Stats::taskBodyCompleted(taskId);
+		Stats::releaseTaskTimes(taskId);
 	}
 
 	inline void startTaskforCollaborator(task_id_t, task_id_t, bool, InstrumentationContext const &)
 	{
 	}
 
-	inline void endTaskforCollaborator(task_id_t, task_id_t, bool, InstrumentationContext const &)
+	inline void endTaskforCollaborator(task_id_t taskforId, task_id_t, bool last, InstrumentationContext const &)
 	{
+		if (last) {
+			Stats::taskBodyCompleted(taskforId);
+		}
 	}
 
 	inline void taskforChunk(__attribute__((unused)) int chunk)
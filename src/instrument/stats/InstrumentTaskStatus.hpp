@@ -32,18 +32,26 @@ namespace Instrument {
 
 	inline void taskIsExecuting(task_id_t taskId, bool, InstrumentationContext const &)
 	{
+		if (taskId->_taskwaitTime.isRunning()) {
+			taskId->_taskwaitTime.stop();
+		}
+
 		assert(taskId->_currentTimer != nullptr);
 
 		taskId->_currentTimer->continueAt(taskId->_times._executionTime);
 		taskId->_currentTimer = &taskId->_times._executionTime;
 	}
 
-	inline void taskIsBlocked(task_id_t taskId, task_blocking_reason_t, InstrumentationContext const &)
+	inline void taskIsBlocked(task_id_t taskId, task_blocking_reason_t reason, InstrumentationContext const &)
 	{
 		assert(taskId->_currentTimer != nullptr);
 
 		taskId->_currentTimer->continueAt(taskId->_times._blockedTime);
 		taskId->_currentTimer = &taskId->_times._blockedTime;
+
+		if (reason == in_taskwait_blocking_reason) {
+			taskId->_taskwaitTime.start();
+		}
 	}
 
 	inline void taskIsZombie(task_id_t taskId, InstrumentationContext const &)
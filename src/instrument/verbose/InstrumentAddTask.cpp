@@ -30,7 +30,18 @@ namespace Instrument {
 
 		task_id_t taskId = _nextTaskId++;
 
-		if (_verboseAddTask) {
+		if (_verboseAddTask && _binaryLog) {
+			char const *label = nullptr;
+			char const *source = nullptr;
+			if (taskInfo) {
+				label = taskInfo->implementations[0].task_label;
+			}
+			if (taskInvokationInfo) {
+				source = taskInvokationInfo->invocation_source;
+			}
+
+			addBinaryLogEntry(context, add_task_binary_event, taskId, (uint64_t) label, (uint64_t) source);
+		} else if (_verboseAddTask) {
 			LogEntry *logEntry = getLogEntry(context);
 			assert(logEntry != nullptr);
 
@@ -66,6 +77,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, created_args_block_binary_event, taskId, (uint64_t) argsBlockPointer, originalArgsBlockSize, argsBlockSize);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -89,6 +105,16 @@ namespace Instrument {
 
 		Task *task = (Task *) taskObject;
 
+		if (_binaryLog) {
+			task_id_t parentId;
+			if (task->getParent() != nullptr) {
+				parentId = task->getParent()->getInstrumentationTaskId();
+			}
+
+			addBinaryLogEntry(context, created_task_binary_event, taskId, (uint64_t) task, (task_id_t::inner_type_t) parentId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -115,6 +141,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, submit_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -145,6 +176,11 @@ namespace Instrument {
 		// Verbose instrumentation does not instrument task fors
 	}
 
+	void registeredTaskInfo(
+		__attribute__((unused)) nanos6_task_info_t *taskInfo
+	) {
+	}
+
 	void registeredNewSpawnedTaskType(
 		__attribute__((unused)) nanos6_task_info_t *taskInfo
 	) {
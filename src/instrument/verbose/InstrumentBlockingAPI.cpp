@@ -24,6 +24,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, enter_block_current_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -42,6 +47,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, exit_block_current_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -60,6 +70,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, unblock_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
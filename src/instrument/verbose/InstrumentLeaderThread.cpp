@@ -58,6 +58,18 @@ namespace Instrument {
 				entries.push_back(entry);
 			}
 		);
+
+		// Format the binary records now that the log is being dumped
+		_binaryEntries.consume_all(
+			[&](BinaryLogRecord &record, __attribute__((unused)) ConcurrentUnorderedListSlotManager::Slot slot)
+			{
+				LogEntry *logEntry = getLogEntry(record._context);
+				assert(logEntry != nullptr);
+
+				formatBinaryLogRecord(record, logEntry);
+				entries.push_back(logEntry);
+			}
+		);
 		
 		// If using timestamps, sort the vector
 		if (_useTimestamps) {
@@ -22,6 +22,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, start_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -37,6 +42,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, end_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -52,6 +62,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, destroy_task_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -21,6 +21,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, task_status_change_binary_event, taskId, (uint64_t) "pending");
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -36,6 +41,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, task_status_change_binary_event, taskId, (uint64_t) "ready");
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -55,6 +65,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, task_status_change_binary_event, taskId, (uint64_t) "executing");
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -70,6 +85,24 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			char const *reasonName;
+			switch (reason) {
+				case in_taskwait_blocking_reason:
+					reasonName = "taskwait";
+					break;
+				case in_mutex_blocking_reason:
+					reasonName = "mutex";
+					break;
+				default:
+					reasonName = "unknown";
+					break;
+			}
+
+			addBinaryLogEntry(context, task_status_change_binary_event, taskId, (uint64_t) "blocked", (uint64_t) reasonName);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -96,6 +129,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, task_status_change_binary_event, taskId, (uint64_t) "zombie");
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -114,6 +152,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, task_status_change_binary_event, taskId, (uint64_t) "destroyed");
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -132,6 +175,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, task_priority_change_binary_event, taskId, priority);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -27,6 +27,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, enter_task_wait_binary_event, taskId, (uint64_t) invocationSource);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -46,6 +51,11 @@ namespace Instrument {
 			return;
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, exit_task_wait_binary_event, taskId);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
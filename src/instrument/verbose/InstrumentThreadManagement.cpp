@@ -111,6 +111,11 @@ namespace Instrument {
 
 		InstrumentationContext const &context = ThreadInstrumentationContext::getCurrent();
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, thread_suspend_binary_event);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -131,6 +136,11 @@ namespace Instrument {
 
 		InstrumentationContext const &context = ThreadInstrumentationContext::getCurrent();
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, thread_resume_binary_event);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -153,6 +163,11 @@ namespace Instrument {
 			}
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, thread_suspend_binary_event);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -176,6 +191,11 @@ namespace Instrument {
 			}
 		}
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, thread_resume_binary_event);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -219,6 +239,18 @@ namespace Instrument {
 
 		InstrumentationContext const &context = ThreadInstrumentationContext::getCurrent();
 
+		if (_binaryLog) {
+			char const *reasonName = nullptr;
+			switch (reason) {
+				case scheduling_polling_slot_busy_wait_reason:
+					reasonName = "(scheduler polling) ";
+					break;
+			}
+
+			addBinaryLogEntry(context, enter_busy_wait_binary_event, (uint64_t) reasonName);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
@@ -241,6 +273,11 @@ namespace Instrument {
 
 		InstrumentationContext const &context = ThreadInstrumentationContext::getCurrent();
 
+		if (_binaryLog) {
+			addBinaryLogEntry(context, exit_busy_wait_binary_event);
+			return;
+		}
+
 		LogEntry *logEntry = getLogEntry(context);
 		assert(logEntry != nullptr);
 
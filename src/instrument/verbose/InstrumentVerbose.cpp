@@ -31,12 +31,110 @@ namespace Instrument {
 
 		ConfigVariable<bool> _useTimestamps("instrument.verbose.timestamps");
 		ConfigVariable<bool> _dumpOnlyOnExit("instrument.verbose.dump_only_on_exit");
+		ConfigVariable<bool> _binaryLog("instrument.verbose.binary");
 
 		std::ofstream *_output = nullptr;
 
 		ConcurrentUnorderedListSlotManager _concurrentUnorderedListSlotManager;
 		ConcurrentUnorderedList<LogEntry *> _entries(_concurrentUnorderedListSlotManager);
 		ConcurrentUnorderedList<LogEntry *> _freeEntries(_concurrentUnorderedListSlotManager);
+		ConcurrentUnorderedList<BinaryLogRecord> _binaryEntries(_concurrentUnorderedListSlotManager);
 		ConcurrentUnorderedListSlotManager::Slot _concurrentUnorderedListExternSlot;
+
+
+		void formatBinaryLogRecord(BinaryLogRecord const &record, LogEntry *logEntry)
+		{
+			assert(logEntry != nullptr);
+
+			uint64_t const *arguments = record._arguments;
+			task_id_t taskId = (task_id_t::inner_type_t) arguments[0];
+
+			logEntry->_timestamp = record._timestamp;
+			logEntry->appendLocation(record._context);
+
+			std::ostringstream &contents = logEntry->_contents;
+			switch (record._event) {
+				case add_task_binary_event:
+					contents << " --> AddTask " << taskId;
+					if (arguments[1] != 0) {
+						contents << " " << (char const *) arguments[1];
+					}
+					if (arguments[2] != 0) {
+						contents << " " << (char const *) arguments[2];
+					}
+					break;
+				case created_args_block_binary_event:
+					contents << " --- AddTask: created " << taskId << " argsblock:" << (void *) arguments[1];
+					contents << " " << arguments[2] << " bytes (before alignment fixup), ";
+					contents << " " << arguments[3] << " bytes (after alignment fixup)";
+					break;
+				case created_task_binary_event:
+					contents << " --- AddTask: created " << taskId << " object:" << (void *) arguments[1];
+					if (task_id_t((task_id_t::inner_type_t) arguments[2]) != task_id_t()) {
+						contents << " parent:" << (task_id_t::inner_type_t) arguments[2];
+					}
+					break;
+				case submit_task_binary_event:
+					contents << " <-- AddTask " << taskId;
+					break;
+				case start_task_binary_event:
+					contents << " --> Task " << taskId;
+					break;
+				case end_task_binary_event:
+					contents << " <-- Task " << taskId;
+					break;
+				case destroy_task_binary_event:
+					contents << " <-> DestroyTask " << taskId;
+					break;
+				case task_status_change_binary_event:
+					contents << " <-> TaskStatusChange " << taskId << " to:" << (char const *) arguments[1];
+					if (arguments[2] != 0) {
+						contents << " reason:" << (char const *) arguments[2];
+					}
+					break;
+				case task_priority_change_binary_event:
+					contents << " <-> TaskPriorityChanged: " << taskId << " priority:" << (long) arguments[1];
+					break;
+				case enter_task_wait_binary_event:
+					contents << " --> TaskWait " << (arguments[1] ? (char const *) arguments[1] : "") << " task:" << taskId;
+					break;
+				case exit_task_wait_binary_event:
+					contents << " <-- TaskWait task:" << taskId;
+					break;
+				case enter_block_current_task_binary_event:
+					contents << " --> nanos6_block_current_task task:" << taskId;
+					break;
+				case exit_block_current_task_binary_event:
+					contents << " <-- nanos6_block_current_task task:" << taskId;
+					break;
+				case unblock_task_binary_event:
+					contents << " <-> nanos6_unblock_task task:" << taskId;
+					break;
+				case acquired_user_mutex_binary_event:
+					contents << " --> UserMutex " << (void *) arguments[0];
+					break;
+				case blocked_on_user_mutex_binary_event:
+					contents << " --- BlockedOnUserMutex " << (void *) arguments[0];
+					break;
+				case released_user_mutex_binary_event:
+					contents << " <-- UserMutex " << (void *) arguments[0];
+					break;
+				case thread_suspend_binary_event:
+					contents << " --> SuspendThread ";
+					break;
+				case thread_resume_binary_event:
+					contents << " <-- SuspendThread ";
+					break;
+				case enter_busy_wait_binary_event:
+					contents << " --> BusyWait ";
+					if (arguments[0] != 0) {
+						contents << (char const *) arguments[0];
+					}
+					break;
+				case exit_busy_wait_binary_event:
+					contents << " <-- BusyWait ";
+					break;
+			}
+		}
 	}
 }
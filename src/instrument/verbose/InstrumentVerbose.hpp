@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -58,6 +59,7 @@ namespace Instrument {
 
 		extern ConfigVariable<bool> _useTimestamps;
 		extern ConfigVariable<bool> _dumpOnlyOnExit;
+		extern ConfigVariable<bool> _binaryLog;
 
 		extern std::ofstream *_output;
 
@@ -104,28 +106,77 @@ namespace Instrument {
 			}
 		};
 
+		//! \brief Events that are recorded as compact binary records when the
+		//! binary log is enabled. Their text is generated when the log is dumped
+		enum binary_log_event_t {
+			add_task_binary_event = 0,
+			created_args_block_binary_event,
+			created_task_binary_event,
+			submit_task_binary_event,
+			start_task_binary_event,
+			end_task_binary_event,
+			destroy_task_binary_event,
+			task_status_change_binary_event,
+			task_priority_change_binary_event,
+			enter_task_wait_binary_event,
+			exit_task_wait_binary_event,
+			enter_block_current_task_binary_event,
+			exit_block_current_task_binary_event,
+			unblock_task_binary_event,
+			acquired_user_mutex_binary_event,
+			blocked_on_user_mutex_binary_event,
+			released_user_mutex_binary_event,
+			thread_suspend_binary_event,
+			thread_resume_binary_event,
+			enter_busy_wait_binary_event,
+			exit_busy_wait_binary_event
+		};
+
+		//! \brief A binary log record. Strings are stored as pointers, so only
+		//! those that outlive the execution (e.g. labels and literals) can be
+		//! recorded
+		struct BinaryLogRecord {
+			timestamp_t _timestamp;
+			InstrumentationContext _context;
+			binary_log_event_t _event;
+			uint64_t _arguments[4];
+		};
+
 		extern ConcurrentUnorderedListSlotManager _concurrentUnorderedListSlotManager;
 		extern ConcurrentUnorderedList<LogEntry *> _entries;
 		extern ConcurrentUnorderedList<LogEntry *> _freeEntries;
+		extern ConcurrentUnorderedList<BinaryLogRecord> _binaryEntries;
 		extern ConcurrentUnorderedListSlotManager::Slot _concurrentUnorderedListExternSlot;
 
 
-		static inline void stampTime(LogEntry *logEntry)
+		static inline void stampTime(timestamp_t &timestamp)
 		{
-			assert(logEntry != nullptr);
 			if (_useTimestamps) {
-				int rc = clock_gettime(CLOCK_MONOTONIC, &logEntry->_timestamp);
+				int rc = clock_gettime(CLOCK_MONOTONIC, &timestamp);
 				FatalErrorHandler::handle(rc, "Retrieving the monotonic time");
 			}
 		}
 
 
-		inline LogEntry *getLogEntry(InstrumentationContext const &context)
+		static inline void stampTime(LogEntry *logEntry)
+		{
+			assert(logEntry != nullptr);
+			stampTime(logEntry->_timestamp);
+		}
+
+
+		static inline ConcurrentUnorderedListSlotManager::Slot getQueueSlot(InstrumentationContext const &context)
 		{
-			ConcurrentUnorderedListSlotManager::Slot queueSlot = _concurrentUnorderedListExternSlot;
 			if (context._externalThreadName == nullptr) {
-				queueSlot = context._computePlaceId.getConcurrentUnorderedListSlot();
+				return context._computePlaceId.getConcurrentUnorderedListSlot();
 			}
+			return _concurrentUnorderedListExternSlot;
+		}
+
+
+		inline LogEntry *getLogEntry(InstrumentationContext const &context)
+		{
+			ConcurrentUnorderedListSlotManager::Slot queueSlot = getQueueSlot(context);
 
 			LogEntry *currentEntry = nullptr;
 			if (_freeEntries.pop(currentEntry, queueSlot)) {
@@ -148,6 +199,34 @@ namespace Instrument {
 			_entries.push(logEntry, logEntry->_queueSlot);
 		}
 
+
+		//! \brief Record an event in the per-CPU binary log, leaving its
+		//! formatting to the dump
+		inline void addBinaryLogEntry(
+			InstrumentationContext const &context,
+			binary_log_event_t event,
+			uint64_t argument0 = 0,
+			uint64_t argument1 = 0,
+			uint64_t argument2 = 0,
+			uint64_t argument3 = 0
+		) {
+			BinaryLogRecord record;
+			stampTime(record._timestamp);
+			record._context = context;
+			record._event = event;
+			record._arguments[0] = argument0;
+			record._arguments[1] = argument1;
+			record._arguments[2] = argument2;
+			record._arguments[3] = argument3;
+
+			ConcurrentUnorderedListSlotManager::Slot queueSlot = getQueueSlot(context);
+			_binaryEntries.push(record, queueSlot);
+		}
+
+
+		//! \brief Fill a log entry with the text of a binary record
+		void formatBinaryLogRecord(BinaryLogRecord const &record, LogEntry *logEntry);
+
 	}
 }
 
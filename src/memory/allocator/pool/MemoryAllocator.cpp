@@ -4,6 +4,10 @@
 	Copyright (C) 2015-2017 Barcelona Supercomputing Center (BSC)
 */
 
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
 #include "executors/threads/CPU.hpp"
 #include "executors/threads/WorkerThread.hpp"
 #include "hardware/HardwareInfo.hpp"
@@ -17,6 +21,13 @@
 
 #include "Poison.hpp"
 
+#ifdef USE_EXEC_WORKFLOW
+#include <ExecutionWorkflowHost.hpp>
+#ifdef USE_CLUSTER
+#include <ExecutionWorkflowCluster.hpp>
+#endif
+#endif
+
 
 MemoryAllocator *MemoryAllocator::_singleton = nullptr;
 
@@ -127,12 +138,34 @@ void MemoryAllocator::initialize()
 	ObjectAllocator<DataAccess>::initialize();
 	ObjectAllocator<ReductionInfo>::initialize();
 	ObjectAllocator<BottomMapEntry>::initialize();
+#ifdef USE_EXEC_WORKFLOW
+	ObjectAllocator<ExecutionWorkflow::HostExecutionStep>::initialize();
+	ObjectAllocator<ExecutionWorkflow::TaskNotificationStep>::initialize();
+	ObjectAllocator<ExecutionWorkflow::CollaboratorNotificationStep>::initialize();
+	ObjectAllocator<ExecutionWorkflow::TaskwaitNotificationStep>::initialize();
+#ifdef USE_CLUSTER
+	ObjectAllocator<ExecutionWorkflow::ClusterExecutionStep>::initialize();
+	ObjectAllocator<ExecutionWorkflow::ClusterDataReleaseStep>::initialize();
+	ObjectAllocator<ExecutionWorkflow::ClusterDataCopyStep>::initialize();
+#endif
+#endif
 }
 
 void MemoryAllocator::shutdown()
 {
 	assert(init == true);
 	//! Initialize the Object caches
+#ifdef USE_EXEC_WORKFLOW
+#ifdef USE_CLUSTER
+	ObjectAllocator<ExecutionWorkflow::ClusterDataCopyStep>::shutdown();
+	ObjectAllocator<ExecutionWorkflow::ClusterDataReleaseStep>::shutdown();
+	ObjectAllocator<ExecutionWorkflow::ClusterExecutionStep>::shutdown();
+#endif
+	ObjectAllocator<ExecutionWorkflow::TaskwaitNotificationStep>::shutdown();
+	ObjectAllocator<ExecutionWorkflow::CollaboratorNotificationStep>::shutdown();
+	ObjectAllocator<ExecutionWorkflow::TaskNotificationStep>::shutdown();
+	ObjectAllocator<ExecutionWorkflow::HostExecutionStep>::shutdown();
+#endif
 	ObjectAllocator<BottomMapEntry>::shutdown();
 	ObjectAllocator<ReductionInfo>::shutdown();
 	ObjectAllocator<DataAccess>::shutdown();
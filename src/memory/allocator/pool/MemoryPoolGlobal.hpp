@@ -103,7 +103,8 @@ public:
 		FatalErrorHandler::failIf(rc != MEMKIND_SUCCESS, " When trying to create a new memory kind");
 #endif
 
-		fillPool();
+		// The pool is filled on the first request, so that NUMA nodes that
+		// are never used do not pay for it during the initialization
 	}
 
 	~MemoryPoolGlobal()
@@ -5,18 +5,19 @@
 */
 
 #include <config.h>
+#include <algorithm>
 #include <fstream>
 
 #include "CPUMonitor.hpp"
 #include "Monitoring.hpp"
 #include "MonitoringSupport.hpp"
+#include "MonitoringWisdom.hpp"
 #include "TaskMonitor.hpp"
 #include "TasktypeStatistics.hpp"
 #include "executors/threads/CPUManager.hpp"
 #include "hardware-counters/HardwareCounters.hpp"
 #include "hardware-counters/SupportedHardwareCounters.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
-#include "support/JsonFile.hpp"
 #include "tasks/Task.hpp"
 #include "tasks/TaskInfo.hpp"
 
@@ -25,7 +26,9 @@ ConfigVariable<bool> Monitoring::_enabled("monitoring.enabled");
 ConfigVariable<bool> Monitoring::_verbose("monitoring.verbose");
 ConfigVariable<bool> Monitoring::_wisdomEnabled("monitoring.wisdom");
 ConfigVariable<std::string> Monitoring::_outputFile("monitoring.verbose_file");
-JsonFile *Monitoring::_wisdom(nullptr);
+ConfigVariable<std::string> Monitoring::_wisdomFile("monitoring.wisdom_file");
+ConfigVariable<std::string> Monitoring::_wisdomHint("monitoring.wisdom_hint");
+MonitoringWisdom *Monitoring::_wisdom(nullptr);
 CPUMonitor *Monitoring::_cpuMonitor(nullptr);
 TaskMonitor *Monitoring::_taskMonitor(nullptr);
 size_t Monitoring::_predictedCPUUsage(0);
@@ -35,7 +38,12 @@ size_t Monitoring::_predictedCPUUsage(0);
 
 void Monitoring::preinitialize()
 {
-	if (_enabled) {
+	if (!CompiledFeatures::monitoring && _enabled) {
+		FatalErrorHandler::warn("Monitoring is not available in this runtime variant, disabling it");
+		_enabled.setValue(false);
+	}
+
+	if (isEnabled()) {
 #if CHRONO_ARCH
 		// Start measuring time to compute the tick conversion rate
 		TickConversionUpdater::initialize();
@@ -63,7 +71,7 @@ void Monitoring::initialize()
 	// Make sure the CPUManager is already preinitialized before this
 	assert(CPUManager::isPreinitialized());
 
-	if (_enabled) {
+	if (isEnabled()) {
 		// Create the CPU monitor
 		_cpuMonitor = new CPUMonitor();
 		assert(_cpuMonitor != nullptr);
@@ -72,7 +80,7 @@ void Monitoring::initialize()
 
 void Monitoring::shutdown()
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		if (_wisdomEnabled) {
 			// Store monitoring data for future executions
 			storeMonitoringWisdom();
@@ -102,9 +110,17 @@ void Monitoring::shutdown()
 
 //    TASKS    //
 
+void Monitoring::tasktypeRegistered(const std::string &label, TasktypeData &tasktypeData)
+{
+	// Tasktypes registered before loading the wisdom are handled when loaded
+	if (isEnabled() && _wisdom != nullptr) {
+		applyMonitoringWisdom(label, tasktypeData);
+	}
+}
+
 void Monitoring::taskCreated(Task *task)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(task != nullptr);
 		assert(_taskMonitor != nullptr);
 
@@ -123,7 +139,7 @@ void Monitoring::taskCreated(Task *task)
 
 void Monitoring::taskReinitialized(Task *task)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_taskMonitor != nullptr);
 
 		// Reset task statistics
@@ -133,7 +149,7 @@ void Monitoring::taskReinitialized(Task *task)
 
 void Monitoring::taskChangedStatus(Task *task, monitoring_task_status_t newStatus)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_taskMonitor != nullptr);
 
 		// Start timing for the appropriate stopwatch
@@ -143,7 +159,7 @@ void Monitoring::taskChangedStatus(Task *task, monitoring_task_status_t newStatu
 
 void Monitoring::taskCompletedUserCode(Task *task)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_taskMonitor != nullptr);
 
 		// Account the task's elapsed execution for predictions
@@ -153,7 +169,7 @@ void Monitoring::taskCompletedUserCode(Task *task)
 
 void Monitoring::taskFinished(Task *task)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_taskMonitor != nullptr);
 
 		// Mark task as completely executed
@@ -166,7 +182,7 @@ void Monitoring::taskFinished(Task *task)
 
 void Monitoring::cpuBecomesIdle(int cpuId)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_cpuMonitor != nullptr);
 
 		_cpuMonitor->cpuBecomesIdle(cpuId);
@@ -175,7 +191,7 @@ void Monitoring::cpuBecomesIdle(int cpuId)
 
 void Monitoring::cpuBecomesActive(int cpuId)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_cpuMonitor != nullptr);
 
 		_cpuMonitor->cpuBecomesActive(cpuId);
@@ -187,7 +203,7 @@ void Monitoring::cpuBecomesActive(int cpuId)
 
 size_t Monitoring::getPredictedCPUUsage(size_t time)
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		double currentWorkload = 0.0;
 		size_t currentActiveInstances = 0;
 		size_t currentPredictionlessInstances = 0;
@@ -224,7 +240,7 @@ size_t Monitoring::getPredictedCPUUsage(size_t time)
 
 double Monitoring::getPredictedElapsedTime()
 {
-	if (_enabled) {
+	if (isEnabled()) {
 		assert(_cpuMonitor != nullptr);
 
 		double currentWorkload = 0.0;
@@ -283,81 +299,66 @@ void Monitoring::displayStatistics()
 
 void Monitoring::loadMonitoringWisdom()
 {
-	// Create a representation of the system file as a JsonFile
-	_wisdom = new JsonFile("./.nanos6-monitoring-wisdom.json");
+	// Entries summarize at most as many samples as the rolling window
+	ConfigVariable<int> rollingWindow("monitoring.rolling_window");
+
+	_wisdom = new MonitoringWisdom(_wisdomFile, _wisdomHint, std::max(rollingWindow.getValue(), 1));
 	assert(_wisdom != nullptr);
 
-	// Try to populate the JsonFile with the system file's data
-	_wisdom->loadData();
-
-	// Navigate through the file and extract metrics of each tasktype
-	_wisdom->getRootNode()->traverseChildrenNodes(
-		[&](const std::string &label, const JsonNode<> &metricsNode) {
-			// For each tasktype in the file, process all current registered
-			// tasktypes to check if we must copy the wisdom data into them
-			TaskInfo::processAllTasktypes(
-				[&](const std::string &taskLabel, const std::string &, TasktypeData &tasktypeData) {
-					if (taskLabel == label) {
-						// Labels coincide, first copy Monitoring data
-						if (metricsNode.dataExists("NORMALIZED_COST")) {
-							double metricValue = 0.0;
-							bool converted = metricsNode.getData("NORMALIZED_COST", metricValue);
-							if (converted) {
-								TasktypeStatistics &tasktypeStatistics = tasktypeData.getTasktypeStatistics();
-								tasktypeStatistics.insertNormalizedTime(metricValue);
-							}
-						}
-
-						// Next, copy Hardware Counters data if existent
-						const std::vector<HWCounters::counters_t> &enabledCounters =
-							HardwareCounters::getEnabledCounters();
-						for (size_t i = 0; i < enabledCounters.size(); ++i) {
-							HWCounters::counters_t counterType = enabledCounters[i];
-							std::string metricLabel(HWCounters::counterDescriptions[counterType]);
-							if (metricsNode.dataExists(metricLabel)) {
-								double metricValue = 0.0;
-								bool converted = metricsNode.getData(metricLabel, metricValue);
-								if (converted) {
-									TasktypeStatistics &tasktypeStatistics = tasktypeData.getTasktypeStatistics();
-									tasktypeStatistics.insertNormalizedCounter(i, metricValue);
-								}
-							}
-						}
-					}
-				}
-			);
+	// Try to load the data of previous executions
+	_wisdom->load();
+
+	// Copy the wisdom data into the tasktypes registered so far. Tasktypes
+	// registered later get their data when registered
+	TaskInfo::processAllTasktypes(
+		[&](const std::string &taskLabel, const std::string &, TasktypeData &tasktypeData) {
+			applyMonitoringWisdom(taskLabel, tasktypeData);
 		}
 	);
 }
 
-void Monitoring::storeMonitoringWisdom()
+void Monitoring::applyMonitoringWisdom(const std::string &label, TasktypeData &tasktypeData)
 {
 	assert(_wisdom != nullptr);
 
-	JsonNode<> *rootNode = _wisdom->getRootNode();
-	assert(rootNode != nullptr);
+	const MonitoringWisdom::metrics_t *metrics = _wisdom->getMetrics(label);
+	if (metrics == nullptr)
+		return;
 
-	// A vector of nodes to save
-	std::vector<std::pair<std::string, JsonNode<double>>> nodesToSave;
+	// First copy Monitoring data
+	TasktypeStatistics &tasktypeStatistics = tasktypeData.getTasktypeStatistics();
+	MonitoringWisdom::metrics_t::const_iterator it = metrics->find("NORMALIZED_COST");
+	if (it != metrics->end()) {
+		tasktypeStatistics.insertNormalizedTime(it->second);
+	}
+
+	// Next, copy Hardware Counters data if existent
+	const std::vector<HWCounters::counters_t> &enabledCounters =
+		HardwareCounters::getEnabledCounters();
+	for (size_t i = 0; i < enabledCounters.size(); ++i) {
+		it = metrics->find(HWCounters::counterDescriptions[enabledCounters[i]]);
+		if (it != metrics->end()) {
+			tasktypeStatistics.insertNormalizedCounter(i, it->second);
+		}
+	}
+}
+
+void Monitoring::storeMonitoringWisdom()
+{
+	assert(_wisdom != nullptr);
 
 	// Process all the tasktypes and gather Monitoring and Hardware Counters metrics
 	TaskInfo::processAllTasktypes(
 		[&](const std::string &taskLabel, const std::string &, TasktypeData &tasktypeData) {
-			// If the file already contains this tasktype as a node, retreive
-			// its inner node instead of creating a new one
-			JsonNode<double> tasktypeNode;
-			if (rootNode->childNodeExists(taskLabel)) {
-				tasktypeNode = rootNode->getChildNode(taskLabel);
-			}
-
-			// Retreive monitoring statistics
 			TasktypeStatistics &tasktypeStatistics = tasktypeData.getTasktypeStatistics();
-			double value = tasktypeStatistics.getTimingRollingAverage();
-			if (tasktypeNode.dataExists("NORMALIZED_COST")) {
-				tasktypeNode.replaceData("NORMALIZED_COST", value);
-			} else {
-				tasktypeNode.addData("NORMALIZED_COST", value);
-			}
+
+			// Tasktypes without executed instances have nothing new to store
+			size_t numInstances = tasktypeStatistics.getTimingNumInstances();
+			if (numInstances == 0)
+				return;
+
+			MonitoringWisdom::metrics_t metrics;
+			metrics["NORMALIZED_COST"] = tasktypeStatistics.getTimingRollingAverage();
 
 			// Retreive hardware counter metrics
 			const std::vector<HWCounters::counters_t> &enabledCounters =
@@ -365,34 +366,18 @@ void Monitoring::storeMonitoringWisdom()
 			for (size_t i = 0; i < enabledCounters.size(); ++i) {
 				double counterValue = tasktypeStatistics.getCounterRollingAverage(i);
 				if (counterValue >= 0.0) {
-					std::string counterLabel(HWCounters::counterDescriptions[enabledCounters[i]]);
-					if (tasktypeNode.dataExists(counterLabel)) {
-						tasktypeNode.replaceData(counterLabel, counterValue);
-					} else {
-						tasktypeNode.addData(counterLabel, counterValue);
-					}
+					metrics[HWCounters::counterDescriptions[enabledCounters[i]]] = counterValue;
 				}
 			}
 
-			// Finally, add the new or updated tasktype node
-			nodesToSave.push_back(std::make_pair(taskLabel, tasktypeNode));
+			_wisdom->setMetrics(taskLabel, numInstances, metrics);
 		}
 	);
 
-	// Clear the wisdom file
-	_wisdom->clearFile();
-
-	// Save all the new/updated nodes in the file
-	for (size_t i = 0; i < nodesToSave.size(); ++i) {
-		rootNode->addChildNode(
-			nodesToSave[i].first,
-			nodesToSave[i].second
-		);
-	}
-
-	// Store the data from the JsonFile in the system file
-	_wisdom->storeData();
+	// Merge the data into the wisdom file, which may have been updated by
+	// other processes in the meantime
+	_wisdom->store();
 
-	// Delete the file as it is no longer needed
 	delete _wisdom;
+	_wisdom = nullptr;
 }
@@ -12,12 +12,14 @@
 #include "MonitoringSupport.hpp"
 #include "TaskStatistics.hpp"
 #include "support/config/ConfigVariable.hpp"
+#include "system/CompiledFeatures.hpp"
 
 
 class CPUMonitor;
-class JsonFile;
+class MonitoringWisdom;
 class Task;
 class TaskMonitor;
+class TasktypeData;
 
 class Monitoring {
 
@@ -35,8 +37,15 @@ private:
 	//! The file where output is saved in, if verbose mode is enabled
 	static ConfigVariable<std::string> _outputFile;
 
-	//! A Json file for monitoring data
-	static JsonFile *_wisdom;
+	//! The file where wisdom is saved in and loaded from
+	static ConfigVariable<std::string> _wisdomFile;
+
+	//! A hint describing the input of the execution, which keeps the wisdom
+	//! of executions with different inputs separate
+	static ConfigVariable<std::string> _wisdomHint;
+
+	//! The store of monitoring data from previous executions
+	static MonitoringWisdom *_wisdom;
 
 	//    MONITORS    //
 
@@ -59,6 +68,10 @@ private:
 	//! \brief Try to load previous monitoring data into accumulators
 	static void loadMonitoringWisdom();
 
+	//! \brief Copy the previous monitoring data of a tasktype, if any, into
+	//! its accumulators
+	static void applyMonitoringWisdom(const std::string &label, TasktypeData &tasktypeData);
+
 	//! \brief Store monitoring data for future executions as warmup data
 	static void storeMonitoringWisdom();
 
@@ -80,12 +93,19 @@ public:
 	//! \brief Check whether monitoring is enabled
 	static inline bool isEnabled()
 	{
-		return _enabled;
+		return CompiledFeatures::monitoring && _enabled;
 	}
 
 
 	//    TASKS    //
 
+	//! \brief Notify that a new tasktype has been registered, so that it can
+	//! use the monitoring data of previous executions
+	//!
+	//! \param[in] label The label of the tasktype
+	//! \param[in,out] tasktypeData The data of the tasktype
+	static void tasktypeRegistered(const std::string &label, TasktypeData &tasktypeData);
+
 	//! \brief Gather basic information about a task when it is created
 	//!
 	//! \param[in,out] task The task
@@ -120,7 +140,7 @@ public:
 	//! \return TaskStatistics size or 0 if Monitoring is disabled
 	static inline size_t getAllocationSize()
 	{
-		if (_enabled) {
+		if (isEnabled()) {
 			return sizeof(TaskStatistics) + TaskStatistics::getAllocationSize();
 		}
 
@@ -0,0 +1,340 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "MonitoringWisdom.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+
+
+//! Identifies a wisdom file
+static const char WisdomMagic[8] = {'N', 'A', 'N', 'O', 'S', '6', 'W', 'S'};
+
+//! The version of the format. Files of other versions are ignored
+static const uint32_t WisdomVersion = 1;
+
+
+//! \brief Compute the FNV-1a hash of a buffer
+static uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+	const unsigned char *bytes = (const unsigned char *) data;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//! \brief Compute a hash that identifies the current executable. The path,
+//! size and modification time are used instead of its contents, which are
+//! expensive to read. Rebuilding the executable thus changes its hash
+static uint64_t hashExecutable()
+{
+	char path[PATH_MAX];
+	ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+	if (length <= 0)
+		return 0;
+
+	struct stat status;
+	if (stat("/proc/self/exe", &status) != 0)
+		return 0;
+
+	uint64_t hash = hashBytes(path, length);
+	hash = hashBytes(&status.st_size, sizeof(status.st_size), hash);
+	hash = hashBytes(&status.st_mtime, sizeof(status.st_mtime), hash);
+	return hash;
+}
+
+//! \brief Sequential reader of a buffer that fails on truncated data
+class WisdomReader {
+	const std::vector<char> &_buffer;
+	size_t _offset;
+
+public:
+	inline WisdomReader(const std::vector<char> &buffer) :
+		_buffer(buffer),
+		_offset(0)
+	{
+	}
+
+	template <typename T>
+	inline bool read(T &value)
+	{
+		if (_buffer.size() - _offset < sizeof(T))
+			return false;
+
+		memcpy(&value, _buffer.data() + _offset, sizeof(T));
+		_offset += sizeof(T);
+		return true;
+	}
+
+	inline bool read(std::string &value)
+	{
+		uint32_t length;
+		if (!read(length) || _buffer.size() - _offset < length)
+			return false;
+
+		value.assign(_buffer.data() + _offset, length);
+		_offset += length;
+		return true;
+	}
+};
+
+//! \brief Sequential writer of a buffer
+class WisdomWriter {
+	std::vector<char> &_buffer;
+
+public:
+	inline WisdomWriter(std::vector<char> &buffer) :
+		_buffer(buffer)
+	{
+	}
+
+	template <typename T>
+	inline void write(const T &value)
+	{
+		const char *bytes = (const char *) &value;
+		_buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	inline void write(const std::string &value)
+	{
+		write((uint32_t) value.size());
+		_buffer.insert(_buffer.end(), value.begin(), value.end());
+	}
+};
+
+
+MonitoringWisdom::MonitoringWisdom(const std::string &path, const std::string &hint, size_t maxWeight) :
+	_path(path),
+	_executableHash(hashExecutable()),
+	_hintHash(hashBytes(hint.data(), hint.size())),
+	_maxWeight(std::max(maxWeight, (size_t) 1)),
+	_entries(),
+	_updates()
+{
+}
+
+bool MonitoringWisdom::readEntries(int fd, entries_t &entries) const
+{
+	std::vector<char> buffer;
+	char chunk[64 * 1024];
+	ssize_t bytes;
+	while ((bytes = read(fd, chunk, sizeof(chunk))) != 0) {
+		if (bytes < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		buffer.insert(buffer.end(), chunk, chunk + bytes);
+	}
+
+	WisdomReader reader(buffer);
+
+	char magic[sizeof(WisdomMagic)];
+	uint32_t version, reserved;
+	uint64_t numEntries;
+	if (!reader.read(magic) || memcmp(magic, WisdomMagic, sizeof(magic)) != 0)
+		return false;
+	if (!reader.read(version) || version != WisdomVersion)
+		return false;
+	if (!reader.read(reserved) || !reader.read(numEntries))
+		return false;
+
+	for (uint64_t i = 0; i < numEntries; ++i) {
+		WisdomKey key;
+		WisdomEntry entry;
+		uint32_t numMetrics;
+
+		if (!reader.read(key._executableHash) || !reader.read(key._hintHash))
+			return false;
+		if (!reader.read(entry._timestamp) || !reader.read(entry._weight))
+			return false;
+		if (!reader.read(key._label) || !reader.read(numMetrics))
+			return false;
+
+		for (uint32_t j = 0; j < numMetrics; ++j) {
+			std::string name;
+			double value;
+			if (!reader.read(name) || !reader.read(value))
+				return false;
+			entry._metrics[name] = value;
+		}
+
+		entries[key] = std::move(entry);
+	}
+
+	return true;
+}
+
+bool MonitoringWisdom::writeEntries(const entries_t &entries) const
+{
+	std::vector<char> buffer;
+	WisdomWriter writer(buffer);
+
+	writer.write(WisdomMagic);
+	writer.write(WisdomVersion);
+	writer.write((uint32_t) 0);
+	writer.write((uint64_t) entries.size());
+
+	for (const auto &element : entries) {
+		const WisdomKey &key = element.first;
+		const WisdomEntry &entry = element.second;
+
+		writer.write(key._executableHash);
+		writer.write(key._hintHash);
+		writer.write(entry._timestamp);
+		writer.write(entry._weight);
+		writer.write(key._label);
+		writer.write((uint32_t) entry._metrics.size());
+		for (const auto &metric : entry._metrics) {
+			writer.write(metric.first);
+			writer.write(metric.second);
+		}
+	}
+
+	// Write a temporary file in the same directory and rename it, so that
+	// readers never see a partially written file
+	std::string temporaryPath = _path + ".tmp." + std::to_string(getpid());
+	int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return false;
+
+	size_t written = 0;
+	while (written < buffer.size()) {
+		ssize_t bytes = write(fd, buffer.data() + written, buffer.size() - written);
+		if (bytes < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		written += bytes;
+	}
+
+	bool success = (written == buffer.size() && fsync(fd) == 0);
+	close(fd);
+
+	if (success && rename(temporaryPath.c_str(), _path.c_str()) == 0)
+		return true;
+
+	unlink(temporaryPath.c_str());
+	return false;
+}
+
+void MonitoringWisdom::load()
+{
+	// The file is always replaced atomically, so there is no need to lock it
+	int fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return;
+
+	entries_t entries;
+	if (readEntries(fd, entries)) {
+		_entries = std::move(entries);
+	} else {
+		FatalErrorHandler::warn("Ignoring the invalid or incompatible monitoring wisdom file ", _path);
+	}
+
+	close(fd);
+}
+
+const MonitoringWisdom::metrics_t *MonitoringWisdom::getMetrics(const std::string &label) const
+{
+	entries_t::const_iterator it = _entries.find({_executableHash, _hintHash, label});
+	if (it != _entries.end())
+		return &(it->second._metrics);
+
+	// Fall back to the most recent entry of another executable
+	const WisdomEntry *latest = nullptr;
+	for (const auto &element : _entries) {
+		if (element.first._hintHash == _hintHash && element.first._label == label) {
+			if (latest == nullptr || element.second._timestamp > latest->_timestamp) {
+				latest = &(element.second);
+			}
+		}
+	}
+
+	return (latest != nullptr) ? &(latest->_metrics) : nullptr;
+}
+
+void MonitoringWisdom::setMetrics(const std::string &label, size_t weight, const metrics_t &metrics)
+{
+	WisdomEntry &entry = _updates[{_executableHash, _hintHash, label}];
+	entry._timestamp = (uint64_t) time(nullptr);
+	entry._weight = std::min((uint64_t) weight, _maxWeight);
+	entry._metrics = metrics;
+}
+
+void MonitoringWisdom::store()
+{
+	if (_updates.empty())
+		return;
+
+	// Serialize the updates of all processes sharing the wisdom file. The lock
+	// is taken on a separate file, since the wisdom file is replaced
+	std::string lockPath = _path + ".lock";
+	int lockFd = open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (lockFd >= 0) {
+		while (flock(lockFd, LOCK_EX) != 0 && errno == EINTR);
+	}
+
+	// Reload the current entries, which may include the ones that other
+	// processes have stored since this execution started
+	entries_t entries;
+	int fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd >= 0) {
+		if (!readEntries(fd, entries)) {
+			entries.clear();
+		}
+		close(fd);
+	}
+
+	// Merge the new metrics with the stored ones, weighting them by the number
+	// of samples they summarize. The weights are bounded so that the metrics
+	// of recent executions prevail over old ones
+	for (const auto &update : _updates) {
+		const WisdomEntry &newEntry = update.second;
+
+		std::pair<entries_t::iterator, bool> emplaced = entries.emplace(update.first, newEntry);
+		if (emplaced.second)
+			continue;
+
+		WisdomEntry &entry = emplaced.first->second;
+		double oldWeight = (double) entry._weight;
+		double newWeight = (double) newEntry._weight;
+		double totalWeight = oldWeight + newWeight;
+
+		for (const auto &metric : newEntry._metrics) {
+			metrics_t::iterator it = entry._metrics.find(metric.first);
+			if (it == entry._metrics.end() || totalWeight == 0.0) {
+				entry._metrics[metric.first] = metric.second;
+			} else {
+				it->second = (it->second * oldWeight + metric.second * newWeight) / totalWeight;
+			}
+		}
+
+		entry._timestamp = newEntry._timestamp;
+		entry._weight = std::min(entry._weight + newEntry._weight, _maxWeight);
+	}
+
+	if (!writeEntries(entries)) {
+		FatalErrorHandler::warn("Could not store the monitoring wisdom file ", _path, ": ", strerror(errno));
+	}
+
+	if (lockFd >= 0) {
+		flock(lockFd, LOCK_UN);
+		close(lockFd);
+	}
+}
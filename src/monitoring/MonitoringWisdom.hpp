@@ -0,0 +1,124 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef MONITORING_WISDOM_HPP
+#define MONITORING_WISDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+
+//! \brief A persistent store of normalized tasktype metrics used as warmup
+//! data in later executions. The store is a binary, versioned file where each
+//! entry is keyed by the executable, an input hint and the tasktype label.
+//!
+//! Several processes (e.g., the ranks of a Cluster execution) may store their
+//! metrics in the same file: the file is locked while it is updated, the
+//! entries already present are merged with the new ones, and the result is
+//! written to a temporary file that atomically replaces the previous one
+class MonitoringWisdom {
+
+public:
+
+	//! Normalized metric values of a tasktype, indexed by metric name
+	typedef std::map<std::string, double> metrics_t;
+
+private:
+
+	struct WisdomKey {
+		uint64_t _executableHash;
+		uint64_t _hintHash;
+		std::string _label;
+
+		inline bool operator<(const WisdomKey &other) const
+		{
+			if (_executableHash != other._executableHash)
+				return _executableHash < other._executableHash;
+			if (_hintHash != other._hintHash)
+				return _hintHash < other._hintHash;
+			return _label < other._label;
+		}
+	};
+
+	struct WisdomEntry {
+		//! When the entry was last updated, in seconds since the epoch
+		uint64_t _timestamp;
+
+		//! The number of samples that the metrics summarize
+		uint64_t _weight;
+
+		metrics_t _metrics;
+	};
+
+	typedef std::map<WisdomKey, WisdomEntry> entries_t;
+
+	//! The path of the wisdom file
+	std::string _path;
+
+	//! A hash identifying the current executable
+	uint64_t _executableHash;
+
+	//! A hash of the input hint provided by the user
+	uint64_t _hintHash;
+
+	//! The maximum weight of an entry, so that older executions fade away
+	uint64_t _maxWeight;
+
+	//! The entries loaded from the file
+	entries_t _entries;
+
+	//! The entries of this execution, which will be merged into the file
+	entries_t _updates;
+
+	//! \brief Read all the entries of a wisdom file
+	//!
+	//! \param[in] fd The file descriptor of the wisdom file
+	//! \param[out] entries The map where entries are inserted
+	//!
+	//! \return Whether the file was valid
+	bool readEntries(int fd, entries_t &entries) const;
+
+	//! \brief Write entries to a new file and atomically replace the
+	//! wisdom file with it
+	bool writeEntries(const entries_t &entries) const;
+
+public:
+
+	//! \brief Create the wisdom store of the current executable
+	//!
+	//! \param[in] path The path of the wisdom file
+	//! \param[in] hint A user-provided hint describing the input (e.g., its
+	//! size), so that executions with different inputs keep separate metrics
+	//! \param[in] maxWeight The maximum number of samples summarized by an entry
+	MonitoringWisdom(const std::string &path, const std::string &hint, size_t maxWeight);
+
+	//! \brief Load the entries of the wisdom file, if it exists
+	void load();
+
+	//! \brief Get the metrics stored for a tasktype
+	//!
+	//! Entries of the current executable are preferred. Otherwise, the most
+	//! recent entry with the same label and hint is returned
+	//!
+	//! \param[in] label The label of the tasktype
+	//!
+	//! \return The metrics, or nullptr if there are none
+	const metrics_t *getMetrics(const std::string &label) const;
+
+	//! \brief Set the metrics of a tasktype obtained in this execution
+	//!
+	//! \param[in] label The label of the tasktype
+	//! \param[in] weight The number of samples that the metrics summarize
+	//! \param[in] metrics The normalized metrics
+	void setMetrics(const std::string &label, size_t weight, const metrics_t &metrics);
+
+	//! \brief Merge the metrics of this execution into the wisdom file
+	void store();
+};
+
+#endif // MONITORING_WISDOM_HPP
@@ -0,0 +1,183 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef TASKTYPE_ACCUMULATORS_HPP
+#define TASKTYPE_ACCUMULATORS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+//! \brief Accumulates the count, sum, mean and variance of a series of values
+//! using Welford's algorithm. Accumulators filled separately can be merged,
+//! obtaining the same results as if all values were inserted in a single one
+class WelfordAccumulator {
+
+private:
+
+	size_t _count;
+	double _sum;
+	double _mean;
+
+	//! Sum of squares of differences from the current mean
+	double _m2;
+
+public:
+
+	inline WelfordAccumulator() :
+		_count(0),
+		_sum(0.0),
+		_mean(0.0),
+		_m2(0.0)
+	{
+	}
+
+	inline void operator()(double value)
+	{
+		++_count;
+		_sum += value;
+
+		double delta = value - _mean;
+		_mean += delta / (double) _count;
+		_m2 += delta * (value - _mean);
+	}
+
+	//! \brief Merge the values of another accumulator into this one
+	inline void merge(const WelfordAccumulator &other)
+	{
+		if (other._count == 0) {
+			return;
+		} else if (_count == 0) {
+			*this = other;
+			return;
+		}
+
+		double count = (double) (_count + other._count);
+		double delta = other._mean - _mean;
+
+		_mean += delta * ((double) other._count / count);
+		_m2 += other._m2 + delta * delta * ((double) _count * (double) other._count / count);
+		_sum += other._sum;
+		_count += other._count;
+	}
+
+	inline size_t getCount() const
+	{
+		return _count;
+	}
+
+	inline double getSum() const
+	{
+		return _sum;
+	}
+
+	//! \brief Get the mean of the values, which is NaN if there are none
+	inline double getMean() const
+	{
+		if (_count == 0) {
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		return _mean;
+	}
+
+	//! \brief Get the (population) variance of the values
+	inline double getVariance() const
+	{
+		if (_count == 0) {
+			return 0.0;
+		}
+
+		return _m2 / (double) _count;
+	}
+};
+
+
+//! \brief Keeps the latest values inserted in an accumulator together with the
+//! time at which they were inserted. The windows of several accumulators can be
+//! merged to obtain the mean of the latest values inserted in any of them
+class RollingWindow {
+
+public:
+
+	struct sample_t {
+		uint64_t _time;
+		double _value;
+	};
+
+	typedef std::vector<sample_t> samples_t;
+
+private:
+
+	samples_t _samples;
+
+	//! The position of the oldest sample once the window is full
+	size_t _oldest;
+
+	size_t _windowSize;
+
+public:
+
+	inline RollingWindow(size_t windowSize) :
+		_samples(),
+		_oldest(0),
+		_windowSize(std::max(windowSize, (size_t) 1))
+	{
+		_samples.reserve(_windowSize);
+	}
+
+	inline void insert(uint64_t time, double value)
+	{
+		if (_samples.size() < _windowSize) {
+			_samples.push_back({time, value});
+		} else {
+			_samples[_oldest] = {time, value};
+			_oldest = (_oldest + 1) % _windowSize;
+		}
+	}
+
+	//! \brief Append the samples of this window to a vector of samples
+	inline void appendTo(samples_t &samples) const
+	{
+		samples.insert(samples.end(), _samples.begin(), _samples.end());
+	}
+
+	//! \brief Compute the mean of the latest samples of a vector
+	//!
+	//! \param[in,out] samples The samples, which may be reordered
+	//! \param[in] windowSize The maximum number of samples considered
+	//!
+	//! \return The mean, or NaN if there are no samples
+	static inline double getMean(samples_t &samples, size_t windowSize)
+	{
+		if (samples.empty()) {
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		windowSize = std::max(windowSize, (size_t) 1);
+		if (samples.size() > windowSize) {
+			std::nth_element(
+				samples.begin(), samples.begin() + windowSize, samples.end(),
+				[](const sample_t &a, const sample_t &b) {
+					return a._time > b._time;
+				}
+			);
+			samples.resize(windowSize);
+		}
+
+		double sum = 0.0;
+		for (const sample_t &sample : samples) {
+			sum += sample._value;
+		}
+
+		return sum / (double) samples.size();
+	}
+};
+
+#endif // TASKTYPE_ACCUMULATORS_HPP
@@ -1,26 +1,193 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2019-2021 Barcelona Supercomputing Center (BSC)
 */
 
+#include <chrono>
+#include <mutex>
+#include <sched.h>
+#include <unistd.h>
+
 #include "TaskStatistics.hpp"
 #include "TasktypeStatistics.hpp"
 #include "hardware-counters/HardwareCounters.hpp"
 
 ConfigVariable<int> TasktypeStatistics::_rollingWindow("monitoring.rolling_window");
+size_t TasktypeStatistics::_numShards = std::max(sysconf(_SC_NPROCESSORS_CONF), 1L);
+
+
+//! \brief Get the time used to order the samples of the rolling windows
+static inline uint64_t getSampleTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+TasktypeStatistics::Shard::Shard(size_t numCounters, size_t windowSize) :
+	_lock(),
+	_timingAccumulator(),
+	_timingWindow(windowSize),
+	_timingAccuracyAccumulator(),
+	_accumulatedTimeAccumulator(),
+	_counterAccumulators(numCounters),
+	_normalizedCounterWindows(numCounters, RollingWindow(windowSize)),
+	_counterAccuracyAccumulators(numCounters),
+	_modified(false)
+{
+}
+
+TasktypeStatistics::TasktypeStatistics() :
+	_accumulatedCost(0),
+	_numAccumulatedInstances(0),
+	_numPredictionlessInstances(0),
+	_completedTime(0),
+	_shards(new std::atomic<Shard *>[_numShards]),
+	_modified(false),
+	_mergeLock(),
+	_timingNumInstances(0),
+	_timingRollingAverage(std::numeric_limits<double>::quiet_NaN()),
+	_counterRollingAverages(new std::atomic<double>[HWCounters::HWC_TOTAL_NUM_EVENTS]),
+	_snapshots(new ShardSnapshot[_numShards]),
+	_mergeBuffer()
+{
+	for (size_t i = 0; i < _numShards; ++i) {
+		_shards[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	for (size_t id = 0; id < HWCounters::HWC_TOTAL_NUM_EVENTS; ++id) {
+		_counterRollingAverages[id].store(std::numeric_limits<double>::quiet_NaN(), std::memory_order_relaxed);
+	}
+}
+
+TasktypeStatistics::~TasktypeStatistics()
+{
+	assert(_accumulatedCost.load() == 0);
+	assert(_numAccumulatedInstances.load() == 0);
+	assert(_numPredictionlessInstances.load() == 0);
+	assert(_completedTime.load() == 0);
+
+	for (size_t i = 0; i < _numShards; ++i) {
+		delete _shards[i].load();
+	}
+}
+
+TasktypeStatistics::Shard &TasktypeStatistics::getCurrentShard()
+{
+	int cpu = sched_getcpu();
+	size_t index = (cpu >= 0) ? ((size_t) cpu % _numShards) : 0;
+
+	Shard *shard = _shards[index].load(std::memory_order_acquire);
+	if (shard == nullptr) {
+		size_t numCounters = HardwareCounters::getEnabledCounters().size();
+		Shard *newShard = new Shard(numCounters, _rollingWindow.getValue());
+
+		// Another thread may have allocated the shard in the meantime
+		if (_shards[index].compare_exchange_strong(shard, newShard, std::memory_order_acq_rel)) {
+			shard = newShard;
+		} else {
+			delete newShard;
+		}
+	}
+
+	assert(shard != nullptr);
+	return *shard;
+}
+
+void TasktypeStatistics::mergeRollingAverages()
+{
+	if (!_modified.load(std::memory_order_acquire))
+		return;
+
+	std::lock_guard<SpinLock> guard(_mergeLock);
+
+	// Another thread may have merged them while we were waiting. Otherwise,
+	// any modification from now on will be seen by the next merge
+	if (!_modified.exchange(false))
+		return;
+
+	const size_t windowSize = _rollingWindow.getValue();
+	const size_t numCounters = HardwareCounters::getEnabledCounters().size();
+
+	// Copy the contents of the shards that changed since the last merge
+	for (size_t i = 0; i < _numShards; ++i) {
+		Shard *shard = _shards[i].load(std::memory_order_acquire);
+		if (shard == nullptr || !shard->_modified.exchange(false))
+			continue;
+
+		ShardSnapshot &snapshot = _snapshots[i];
+		snapshot._counterSamples.resize(numCounters);
+
+		shard->_lock.lock();
+		snapshot._timingNumInstances = shard->_timingAccumulator.getCount();
+		snapshot._timingSamples.clear();
+		shard->_timingWindow.appendTo(snapshot._timingSamples);
+		for (size_t id = 0; id < numCounters; ++id) {
+			snapshot._counterSamples[id].clear();
+			shard->_normalizedCounterWindows[id].appendTo(snapshot._counterSamples[id]);
+		}
+		shard->_lock.unlock();
+	}
+
+	size_t numInstances = 0;
+	_mergeBuffer.clear();
+	for (size_t i = 0; i < _numShards; ++i) {
+		const ShardSnapshot &snapshot = _snapshots[i];
+		numInstances += snapshot._timingNumInstances;
+		_mergeBuffer.insert(_mergeBuffer.end(),
+			snapshot._timingSamples.begin(), snapshot._timingSamples.end());
+	}
+	_timingRollingAverage.store(RollingWindow::getMean(_mergeBuffer, windowSize), std::memory_order_relaxed);
+	_timingNumInstances.store(numInstances, std::memory_order_relaxed);
+
+	for (size_t id = 0; id < numCounters; ++id) {
+		_mergeBuffer.clear();
+		for (size_t i = 0; i < _numShards; ++i) {
+			const ShardSnapshot &snapshot = _snapshots[i];
+			if (id < snapshot._counterSamples.size()) {
+				_mergeBuffer.insert(_mergeBuffer.end(),
+					snapshot._counterSamples[id].begin(), snapshot._counterSamples[id].end());
+			}
+		}
+		_counterRollingAverages[id].store(RollingWindow::getMean(_mergeBuffer, windowSize), std::memory_order_relaxed);
+	}
+}
+
+void TasktypeStatistics::insertNormalizedTime(double normalizedTime)
+{
+	Shard &shard = getCurrentShard();
+	uint64_t time = getSampleTime();
+
+	shard._lock.lock();
+	shard._timingAccumulator(normalizedTime);
+	shard._timingWindow.insert(time, normalizedTime);
+	shard._lock.unlock();
+
+	markModified(shard);
+}
+
+void TasktypeStatistics::insertNormalizedCounter(size_t counterId, double value)
+{
+	Shard &shard = getCurrentShard();
+	uint64_t time = getSampleTime();
+
+	shard._lock.lock();
+	shard._normalizedCounterWindows[counterId].insert(time, value);
+	shard._lock.unlock();
 
+	markModified(shard);
+}
 
 double TasktypeStatistics::getTimingPrediction(size_t cost)
 {
 	double predictedTime = PREDICTION_UNAVAILABLE;
 
 	// Try to inferr a prediction
-	_timingAccumulatorLock.lock();
-	if (BoostAcc::count(_timingAccumulator)) {
-		predictedTime = ((double) cost * BoostAcc::rolling_mean(_timingAccumulator));
+	mergeRollingAverages();
+	if (_timingNumInstances.load(std::memory_order_relaxed)) {
+		predictedTime = ((double) cost * _timingRollingAverage.load(std::memory_order_relaxed));
 	}
-	_timingAccumulatorLock.unlock();
 
 	return predictedTime;
 }
@@ -30,11 +197,11 @@ double TasktypeStatistics::getCounterPrediction(size_t counterId, size_t cost)
 	double normalizedValue = PREDICTION_UNAVAILABLE;
 
 	// Check if a prediction can be inferred
-	_counterAccumulatorsLock.lock();
-	if (BoostAcc::count(_normalizedCounterAccumulators[counterId])) {
-		normalizedValue = ((double) cost) * BoostAcc::rolling_mean(_normalizedCounterAccumulators[counterId]);
+	mergeRollingAverages();
+	double average = _counterRollingAverages[counterId].load(std::memory_order_relaxed);
+	if (!std::isnan(average)) {
+		normalizedValue = ((double) cost) * average;
 	}
-	_counterAccumulatorsLock.unlock();
 
 	return normalizedValue;
 }
@@ -64,13 +231,17 @@ void TasktypeStatistics::accumulateStatisticsAndCounters(
 
 	// Accumulate the unitary time, the elapsed time to compute effective
 	// parallelism metrics, and the accuracy obtained of a previous prediction
-	_timingAccumulatorLock.lock();
-	_timingAccumulator(normalizedTime);
-	_accumulatedTimeAccumulator(elapsed);
+	Shard &shard = getCurrentShard();
+	uint64_t time = getSampleTime();
+
+	shard._lock.lock();
+	shard._timingAccumulator(normalizedTime);
+	shard._timingWindow.insert(time, normalizedTime);
+	shard._accumulatedTimeAccumulator(elapsed);
 	if (predictionAvailable) {
-		_timingAccuracyAccumulator(accuracy);
+		shard._timingAccuracyAccumulator(accuracy);
 	}
-	_timingAccumulatorLock.unlock();
+	shard._lock.unlock();
 
 	//    HARDWARE COUNTERS    //
 
@@ -97,15 +268,19 @@ void TasktypeStatistics::accumulateStatisticsAndCounters(
 		}
 	}
 
-	// Aggregate all the information into the accumulators
-	_counterAccumulatorsLock.lock();
-	for (size_t id = 0; id < numEnabledCounters; ++id) {
-		_counterAccumulators[id](counters[id]);
-		_normalizedCounterAccumulators[id](normalizedCounters[id]);
+	// Aggregate all the information into the accumulators of the shard
+	if (numEnabledCounters > 0) {
+		shard._lock.lock();
+		for (size_t id = 0; id < numEnabledCounters; ++id) {
+			shard._counterAccumulators[id](counters[id]);
+			shard._normalizedCounterWindows[id].insert(time, normalizedCounters[id]);
 
-		if (counterPredictionsAvailable[id]) {
-			_counterAccuracyAccumulators[id](counterAccuracies[id]);
+			if (counterPredictionsAvailable[id]) {
+				shard._counterAccuracyAccumulators[id](counterAccuracies[id]);
+			}
 		}
+		shard._lock.unlock();
 	}
-	_counterAccumulatorsLock.unlock();
+
+	markModified(shard);
 }
@@ -1,33 +1,25 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2020-2021 Barcelona Supercomputing Center (BSC)
 */
 
 #ifndef TASKTYPE_STATISTICS_HPP
 #define TASKTYPE_STATISTICS_HPP
 
-// NOTE: "array_wrapper" must be included before any other boost modules
-// Workaround for a missing include in boost 1.64
-#include <boost/version.hpp>
-#if BOOST_VERSION == 106400
-#include <boost/serialization/array_wrapper.hpp>
-#endif
-
 #include <atomic>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics.hpp>
-#include <boost/accumulators/statistics/rolling_mean.hpp>
+#include <cmath>
 #include <cstddef>
+#include <memory>
+#include <vector>
 
+#include "TasktypeAccumulators.hpp"
 #include "hardware-counters/SupportedHardwareCounters.hpp"
 #include "hardware-counters/TaskHardwareCounters.hpp"
+#include "lowlevel/Padding.hpp"
 #include "lowlevel/SpinLock.hpp"
 #include "support/config/ConfigVariable.hpp"
 
-namespace BoostAcc = boost::accumulators;
-namespace BoostAccTag = boost::accumulators::tag;
-
 
 class TaskStatistics;
 
@@ -35,30 +27,66 @@ class TasktypeStatistics {
 
 private:
 
-	typedef BoostAcc::accumulator_set<double, BoostAcc::stats<BoostAccTag::mean> > accumulator_t;
+	//! Accumulators of the tasks that finished on a subset of the CPUs. Each
+	//! shard is only contended by the threads running on its CPUs, and all of
+	//! them are merged when the metrics of the tasktype are needed
+	struct alignas(CACHELINE_SIZE) Shard {
+		//! Spinlock to ensure atomic access within the accumulators of the shard
+		SpinLock _lock;
+
+		//! Normalized timing measures of tasks
+		WelfordAccumulator _timingAccumulator;
+
+		//! The latest normalized timing measures of tasks
+		RollingWindow _timingWindow;
+
+		//! Accuracy data of timing predictions
+		WelfordAccumulator _timingAccuracyAccumulator;
+
+		//! The elapsed time of tasks
+		WelfordAccumulator _accumulatedTimeAccumulator;
+
+		//! Hardware counter accumulators, one per enabled counter
+		std::vector<WelfordAccumulator> _counterAccumulators;
 
-	typedef BoostAcc::accumulator_set<
-		double,
-		BoostAcc::stats<
-			BoostAccTag::count,
-			BoostAccTag::mean,
-			BoostAccTag::sum,
-			BoostAccTag::variance
-	> > metric_accumulator_t;
+		//! The latest normalized hardware counter metrics, one per enabled counter
+		std::vector<RollingWindow> _normalizedCounterWindows;
 
-	typedef BoostAcc::accumulator_set<
-		double,
-		BoostAcc::stats<
-			BoostAccTag::count,
-			BoostAccTag::mean,
-			BoostAccTag::rolling_mean,
-			BoostAccTag::variance
-	> > metric_rolling_accumulator_t;
+		//! Accuracy data of hardware counter predictions, one per enabled counter
+		std::vector<WelfordAccumulator> _counterAccuracyAccumulators;
 
+		//! Whether the shard has been modified since it was last merged
+		std::atomic<bool> _modified;
+
+		Shard(size_t numCounters, size_t windowSize);
+	};
+
+	//! The contents of a shard as of the last merge, which are kept so that
+	//! each merge only needs to copy the shards that changed
+	struct ShardSnapshot {
+		//! The number of timing measures of the shard
+		size_t _timingNumInstances;
+
+		//! The samples of the timing rolling window of the shard
+		RollingWindow::samples_t _timingSamples;
+
+		//! The samples of the counter rolling windows of the shard
+		std::vector<RollingWindow::samples_t> _counterSamples;
+
+		ShardSnapshot() :
+			_timingNumInstances(0),
+			_timingSamples(),
+			_counterSamples()
+		{
+		}
+	};
 
 	//! The rolling-window size for accumulators (elements taken into account)
 	static ConfigVariable<int> _rollingWindow;
 
+	//! The number of shards of each tasktype
+	static size_t _numShards;
+
 	//    TIMING METRICS    //
 
 	//! Contains the aggregated computational cost ready to be executed of a tasktype
@@ -74,68 +102,82 @@ private:
 	//! completed by children tasks of tasks that have not finished executing yet
 	std::atomic<size_t> _completedTime;
 
-	//! An accumulator which holds normalized timing measures of tasks
-	metric_rolling_accumulator_t _timingAccumulator;
+	//    SHARDED ACCUMULATORS    //
 
-	//! An accumulator which holds accuracy data of timing predictions
-	accumulator_t _timingAccuracyAccumulator;
+	//! The shards of the accumulators, which are allocated once a task
+	//! finishes on one of their CPUs
+	std::unique_ptr<std::atomic<Shard *>[]> _shards;
 
-	//! An accumulator which holds the accumulation of all the elapsed time of tasks (in milliseconds)
-	accumulator_t _accumulatedTimeAccumulator;
+	//! Whether any shard has been modified since the last merge
+	std::atomic<bool> _modified;
 
-	//! Spinlock to ensure atomic access within the previous accumulators
-	SpinLock _timingAccumulatorLock;
+	//! Spinlock to ensure that a single thread merges the shards
+	SpinLock _mergeLock;
 
-	//    HARDWARE COUNTER METRICS    //
+	//! The number of timing measures in all shards, as of the last merge
+	std::atomic<size_t> _timingNumInstances;
 
-	//! A vector of hardware counter accumulators
-	std::vector<metric_accumulator_t> _counterAccumulators;
+	//! The rolling average of normalized timing measures, as of the last merge
+	std::atomic<double> _timingRollingAverage;
 
-	//! A vector of hardware counter accumulators with normalized metrics
-	std::vector<metric_rolling_accumulator_t> _normalizedCounterAccumulators;
+	//! The rolling average of each normalized counter, as of the last merge
+	std::unique_ptr<std::atomic<double>[]> _counterRollingAverages;
 
-	//! A vector of hardware counter accumulators for the accuracy of predictions
-	std::vector<accumulator_t> _counterAccuracyAccumulators;
+	//! The snapshot of each shard, only accessed while merging
+	std::unique_ptr<ShardSnapshot[]> _snapshots;
 
-	//! Spinlock to ensure atomic access within the previous accumulators
-	SpinLock _counterAccumulatorsLock;
+	//! Buffer of samples used while merging rolling windows
+	RollingWindow::samples_t _mergeBuffer;
 
-public:
+	//! \brief Get the shard of the CPU where the current thread runs, and
+	//! allocate it if needed
+	Shard &getCurrentShard();
 
-	//! \brief Constructor
+	//! \brief Notify that a shard has been modified
 	//!
-	//! NOTE: We use 'HWC_TOTAL_NUM_EVENTS' as the number of events instead of
-	//! doing it dynamically because there shouldn't be too many objects of this
-	//! type, and they're created at runtime-initialization, so we cannot know
-	//! at that time how many counters we will really use. Nonetheless, we will
-	//! only use as many accumulators as enabled counters (numEnabledCounters)
-	inline TasktypeStatistics() :
-		_accumulatedCost(0),
-		_numAccumulatedInstances(0),
-		_numPredictionlessInstances(0),
-		_completedTime(0),
-		_timingAccumulator(BoostAccTag::rolling_window::window_size = _rollingWindow),
-		_timingAccuracyAccumulator(),
-		_accumulatedTimeAccumulator(),
-		_timingAccumulatorLock(),
-		_counterAccumulators(HWCounters::HWC_TOTAL_NUM_EVENTS),
-		_normalizedCounterAccumulators(
-			HWCounters::HWC_TOTAL_NUM_EVENTS,
-			metric_rolling_accumulator_t(BoostAccTag::rolling_window::window_size = _rollingWindow)
-		),
-		_counterAccuracyAccumulators(HWCounters::HWC_TOTAL_NUM_EVENTS),
-		_counterAccumulatorsLock()
+	//! The flag of the shard is set first, so that a merge that sees the
+	//! global flag also sees the shards that changed
+	inline void markModified(Shard &shard)
 	{
+		if (!shard._modified.load(std::memory_order_relaxed)) {
+			shard._modified.store(true, std::memory_order_release);
+		}
+
+		if (!_modified.load(std::memory_order_relaxed)) {
+			_modified.store(true, std::memory_order_release);
+		}
 	}
 
-	inline ~TasktypeStatistics()
+	//! \brief Recompute the rolling averages if any shard was modified,
+	//! copying only the contents of the shards that changed
+	void mergeRollingAverages();
+
+	//! \brief Apply a function to all the allocated shards
+	template <typename F>
+	inline void processAllShards(F functionToApply)
 	{
-		assert(_accumulatedCost.load() == 0);
-		assert(_numAccumulatedInstances.load() == 0);
-		assert(_numPredictionlessInstances.load() == 0);
-		assert(_completedTime.load() == 0);
+		for (size_t i = 0; i < _numShards; ++i) {
+			Shard *shard = _shards[i].load(std::memory_order_acquire);
+			if (shard != nullptr) {
+				shard->_lock.lock();
+				functionToApply(*shard);
+				shard->_lock.unlock();
+			}
+		}
 	}
 
+public:
+
+	//! \brief Constructor
+	//!
+	//! NOTE: The shards are allocated lazily, since there may be many CPUs and
+	//! only a few of them execute tasks of this type. We use 'HWC_TOTAL_NUM_EVENTS'
+	//! for the merged averages because we cannot know at this time how many
+	//! counters will be enabled
+	TasktypeStatistics();
+
+	~TasktypeStatistics();
+
 	inline void increaseAccumulatedCost(size_t cost)
 	{
 		_accumulatedCost += cost;
@@ -206,62 +248,56 @@ public:
 
 	inline double getAccumulatedTime()
 	{
-		_timingAccumulatorLock.lock();
-		double time = BoostAcc::sum(_accumulatedTimeAccumulator);
-		_timingAccumulatorLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._accumulatedTimeAccumulator);
+		});
 
-		return time;
+		return accumulator.getSum();
 	}
 
 	//    TIMING PREDICTIONS    //
 
 	//! \brief Insert a normalized cost value (time per unit of cost)
 	//! in the time accumulators
-	inline void insertNormalizedTime(double normalizedTime)
-	{
-		_timingAccumulatorLock.lock();
-		_timingAccumulator(normalizedTime);
-		_timingAccumulatorLock.unlock();
-	}
+	void insertNormalizedTime(double normalizedTime);
 
 	//! \brief Get the standard deviation of the normalized unitary cost of this tasktype
 	inline double getTimingStddev()
 	{
-		_timingAccumulatorLock.lock();
-		double variance = BoostAcc::variance(_timingAccumulator);
-		_timingAccumulatorLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._timingAccumulator);
+		});
 
-		return sqrt(variance);
+		return sqrt(accumulator.getVariance());
 	}
 
 	//! \brief Get the number of task instances that accumulated metrics
 	inline size_t getTimingNumInstances()
 	{
-		_timingAccumulatorLock.lock();
-		size_t numInstances = BoostAcc::count(_timingAccumulator);
-		_timingAccumulatorLock.unlock();
+		mergeRollingAverages();
 
-		return numInstances;
+		return _timingNumInstances.load(std::memory_order_relaxed);
 	}
 
 	//! \brief Get the average accuracy of timing predictions of this tasktype
 	inline double getTimingAccuracy()
 	{
-		_timingAccumulatorLock.lock();
-		double accuracy = BoostAcc::mean(_timingAccuracyAccumulator);
-		_timingAccumulatorLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._timingAccuracyAccumulator);
+		});
 
-		return accuracy;
+		return accumulator.getMean();
 	}
 
 	//! \brief Get the average normalized unitary cost of this tasktype
 	inline double getTimingRollingAverage()
 	{
-		_timingAccumulatorLock.lock();
-		double average = BoostAcc::rolling_mean(_timingAccumulator);
-		_timingAccumulatorLock.unlock();
+		mergeRollingAverages();
 
-		return average;
+		return _timingRollingAverage.load(std::memory_order_relaxed);
 	}
 
 	//! \brief Get a timing prediction for a task
@@ -275,12 +311,7 @@ public:
 	//!
 	//! \param[in] counterId An identifier relative to the number of enabled events
 	//! \param[in] value The value of the metric
-	inline void insertNormalizedCounter(size_t counterId, double value)
-	{
-		_counterAccumulatorsLock.lock();
-		_normalizedCounterAccumulators[counterId](value);
-		_counterAccumulatorsLock.unlock();
-	}
+	void insertNormalizedCounter(size_t counterId, double value);
 
 	//! \brief Retreive, for a certain type of counter, the sum of accumulated
 	//! values of all tasks from this type
@@ -289,11 +320,12 @@ public:
 	//! \return A double with the sum of accumulated values
 	inline double getCounterSum(size_t counterId)
 	{
-		_counterAccumulatorsLock.lock();
-		double sum = BoostAcc::sum(_counterAccumulators[counterId]);
-		_counterAccumulatorsLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._counterAccumulators[counterId]);
+		});
 
-		return sum;
+		return accumulator.getSum();
 	}
 
 	//! \brief Retreive, for a certain type of counter, the average of all
@@ -303,11 +335,12 @@ public:
 	//! \return A double with the average accumulated value
 	inline double getCounterAverage(size_t counterId)
 	{
-		_counterAccumulatorsLock.lock();
-		double avg = BoostAcc::mean(_counterAccumulators[counterId]);
-		_counterAccumulatorsLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._counterAccumulators[counterId]);
+		});
 
-		return avg;
+		return accumulator.getMean();
 	}
 
 	//! \brief Retreive, for a certain type of counter, the standard deviation
@@ -317,11 +350,12 @@ public:
 	//! \return A double with the standard deviation of the counter
 	inline double getCounterStddev(size_t counterId)
 	{
-		_counterAccumulatorsLock.lock();
-		double variance = BoostAcc::variance(_counterAccumulators[counterId]);
-		_counterAccumulatorsLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._counterAccumulators[counterId]);
+		});
 
-		return sqrt(variance);
+		return sqrt(accumulator.getVariance());
 	}
 
 	//! \brief Retreive, for a certain type of counter, the amount of values
@@ -331,9 +365,10 @@ public:
 	//! \return A size_t with the number of accumulated values
 	inline size_t getCounterNumInstances(size_t counterId)
 	{
-		_counterAccumulatorsLock.lock();
-		size_t count = BoostAcc::count(_counterAccumulators[counterId]);
-		_counterAccumulatorsLock.unlock();
+		size_t count = 0;
+		processAllShards([&](Shard &shard) {
+			count += shard._counterAccumulators[counterId].getCount();
+		});
 
 		return count;
 	}
@@ -345,11 +380,9 @@ public:
 	//! \return A double with the average accumulated value
 	inline double getCounterRollingAverage(size_t counterId)
 	{
-		_counterAccumulatorsLock.lock();
-		double avg = BoostAcc::rolling_mean(_normalizedCounterAccumulators[counterId]);
-		_counterAccumulatorsLock.unlock();
+		mergeRollingAverages();
 
-		return avg;
+		return _counterRollingAverages[counterId].load(std::memory_order_relaxed);
 	}
 
 	//! \brief Retreive, for a certain type of counter, the average accuracy
@@ -359,11 +392,12 @@ public:
 	//! \return A double with the average accuracy
 	inline double getCounterAccuracy(size_t counterId)
 	{
-		_counterAccumulatorsLock.lock();
-		double avg = BoostAcc::mean(_counterAccuracyAccumulators[counterId]);
-		_counterAccumulatorsLock.unlock();
+		WelfordAccumulator accumulator;
+		processAllShards([&](Shard &shard) {
+			accumulator.merge(shard._counterAccuracyAccumulators[counterId]);
+		});
 
-		return avg;
+		return accumulator.getMean();
 	}
 
 	//! \brief Get a hardware counter prediction for a task
@@ -59,6 +59,15 @@ SchedulerInterface::SchedulerInterface()
 		SchedulerGenerator::createDeviceScheduler(
 			computePlaceCount, policy, _enablePriority,
 			_enableImmediateSuccessor, nanos6_openacc_device);
+#else
+	// Emulated devices take the slot of the OpenACC devices
+	if (HardwareInfo::canDeviceRunTasks(nanos6_openacc_device)) {
+		computePlaceCount = HardwareInfo::getComputePlaceCount(nanos6_openacc_device);
+		_deviceSchedulers[nanos6_openacc_device] =
+			SchedulerGenerator::createDeviceScheduler(
+				computePlaceCount, policy, _enablePriority,
+				_enableImmediateSuccessor, nanos6_openacc_device);
+	}
 #endif
 #if NANOS6_OPENCL
 	FatalErrorHandler::failIf(true, "OpenCL is not supported yet.");
@@ -74,9 +83,8 @@ SchedulerInterface::~SchedulerInterface()
 #if USE_CUDA
 	delete _deviceSchedulers[nanos6_cuda_device];
 #endif
-#if USE_OPENACC
+	// Either the OpenACC or the emulated devices, if any
 	delete _deviceSchedulers[nanos6_openacc_device];
-#endif
 #if NANOS6_OPENCL
 	FatalErrorHandler::failIf(true, "OpenCL is not supported yet.");
 #endif
@@ -11,6 +11,7 @@
 #include "hardware/places/ComputePlace.hpp"
 #include "scheduling/schedulers/HostScheduler.hpp"
 #include "scheduling/schedulers/device/DeviceScheduler.hpp"
+#include "system/MetricsExporter.hpp"
 #include "tasks/Task.hpp"
 #include "tasks/TaskImplementation.hpp"
 
@@ -50,6 +51,7 @@ public:
 		assert(taskType != nanos6_cluster_device);
 
 		if (taskType == nanos6_host_device) {
+			MetricsExporter::readyTaskAdded(task);
 			_hostScheduler->addReadyTask(task, computePlace, hint);
 		} else {
 			assert(taskType == _deviceSchedulers[taskType]->getDeviceType());
@@ -67,6 +69,7 @@ public:
 		assert(taskType != nanos6_cluster_device);
 
 		if (taskType == nanos6_host_device) {
+			MetricsExporter::readyTasksAdded(tasks, numTasks);
 			_hostScheduler->addReadyTasks(tasks, numTasks, computePlace, hint);
 		} else {
 			assert(taskType == _deviceSchedulers[taskType]->getDeviceType());
@@ -94,7 +97,11 @@ public:
 				}
 			}
 #endif
-			return _hostScheduler->getReadyTask(computePlace);
+			Task *task = _hostScheduler->getReadyTask(computePlace);
+			if (task != nullptr) {
+				MetricsExporter::readyTaskTaken(task);
+			}
+			return task;
 		} else {
 			assert(computePlaceType != nanos6_cluster_device);
 			return _deviceSchedulers[computePlaceType]->getReadyTask(computePlace);
@@ -1,53 +1,186 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2020-2021 Barcelona Supercomputing Center (BSC)
 */
 
 #ifndef DEADLINE_QUEUE_HPP
 #define DEADLINE_QUEUE_HPP
 
+#include <cstdint>
+
 #include "scheduling/ReadyQueue.hpp"
 #include "support/Containers.hpp"
-#include "support/chronometers/std/Chrono.hpp"
+#include "support/chronometers/CoarseClock.hpp"
 #include "tasks/Task.hpp"
 
 //! This kind of ready queue supports deadlines
+//!
+//! Deadline tasks are kept in a hierarchical timing wheel, so inserting and
+//! expiring tasks takes constant time. The wheel is advanced in batches by
+//! processDeadlines, which moves the tasks whose deadline has passed to a
+//! FIFO of expired tasks. Getting a ready task only pops from that FIFO and
+//! neither reads the clock nor traverses any ordered structure
 class DeadlineQueue : public ReadyQueue {
-	//! Deadline compare function
-	struct DeadlineCompare {
-		bool operator() (const Task *left, const Task *right) const
-		{
-			if (left->getDeadline() != right->getDeadline()) {
-				return (left->getDeadline() < right->getDeadline());
+	typedef uint64_t tick_t;
+	typedef Container::vector<Task *> slot_t;
+
+	//! Each tick of the wheel lasts 2^TICK_SHIFT microseconds
+	static const int TICK_SHIFT = 4;
+
+	//! Each level of the wheel has 2^LEVEL_BITS slots
+	static const int LEVEL_BITS = 6;
+	static const tick_t LEVEL_SLOTS = (1 << LEVEL_BITS);
+
+	//! Number of levels. Deadlines further than the range of the last level
+	//! (2^(LEVEL_BITS * NUM_LEVELS) ticks, about 268 seconds) overflow
+	static const int NUM_LEVELS = 4;
+
+	//! The slots of each level. A slot of level L holds the tasks expiring
+	//! in a range of 2^(LEVEL_BITS * L) ticks
+	slot_t _slots[NUM_LEVELS][LEVEL_SLOTS];
+
+	//! Bitmask of the non-empty slots of each level
+	uint64_t _occupied[NUM_LEVELS];
+
+	//! Tasks whose deadline is beyond the range of the wheel
+	slot_t _overflow;
+
+	//! Number of tasks in the wheel, including the overflowed ones
+	size_t _numPending;
+
+	//! The last tick processed by the wheel
+	tick_t _currentTick;
+
+	//! Tasks whose deadline has passed, in expiration order
+	Container::deque<Task *> _expiredTasks;
+
+	//! \brief Get the first tick at which a deadline is satisfied
+	static inline tick_t getDeadlineTick(Task::deadline_t deadline)
+	{
+		return (deadline + (1 << TICK_SHIFT) - 1) >> TICK_SHIFT;
+	}
+
+	//! \brief Insert a task in the wheel or in the expired tasks
+	inline void insert(Task *task)
+	{
+		const tick_t tick = getDeadlineTick(task->getDeadline());
+		if (tick <= _currentTick) {
+			_expiredTasks.push_back(task);
+			return;
+		}
+
+		// Use the lowest level whose current range contains the tick
+		++_numPending;
+		for (int level = 0; level < NUM_LEVELS; ++level) {
+			const int rangeShift = LEVEL_BITS * (level + 1);
+			if ((tick >> rangeShift) == (_currentTick >> rangeShift)) {
+				const tick_t slot = (tick >> (LEVEL_BITS * level)) & (LEVEL_SLOTS - 1);
+				_slots[level][slot].push_back(task);
+				_occupied[level] |= (1ULL << slot);
+				return;
 			}
-			return (left < right);
 		}
-	};
 
-	//! Set of deadline tasks ordered by their task deadline
-	//! in ascending order. Tasks with the lowest deadline
-	//! are stored at the first positions. It also allows
-	//! different tasks to share the same deadline
-	typedef Container::set<Task *, DeadlineCompare> deadline_set_t;
+		_overflow.push_back(task);
+	}
 
-	//! The ordered set of deadline tasks
-	deadline_set_t _deadlineTasks;
+	//! \brief Reinsert the tasks of a slot into the lower levels
+	inline void cascade(slot_t &slot)
+	{
+		// The tasks cannot be reinserted into the same slot
+		_numPending -= slot.size();
+		for (Task *task : slot) {
+			insert(task);
+		}
+		slot.clear();
+	}
 
-	//! The cached current time point (may be stale)
-	mutable Task::deadline_t _now;
+	//! \brief Start a new range of the first level, cascading the slots of
+	//! the upper levels that correspond to the new current tick
+	inline void cascadeUpperLevels()
+	{
+		assert((_currentTick & (LEVEL_SLOTS - 1)) == 0);
+
+		// Cascade from the upper to the lower levels, since a task cascaded
+		// from an upper level may fall in a slot of a lower one that is
+		// cascaded now
+		if ((_currentTick & ((1ULL << (LEVEL_BITS * NUM_LEVELS)) - 1)) == 0) {
+			slot_t overflow;
+			overflow.swap(_overflow);
+			cascade(overflow);
+		}
+
+		for (int level = NUM_LEVELS - 1; level > 0; --level) {
+			const int shift = LEVEL_BITS * level;
+			if ((_currentTick & ((1ULL << shift) - 1)) == 0) {
+				const tick_t slot = (_currentTick >> shift) & (LEVEL_SLOTS - 1);
+				if (_occupied[level] & (1ULL << slot)) {
+					_occupied[level] &= ~(1ULL << slot);
+					cascade(_slots[level][slot]);
+				}
+			}
+		}
+	}
+
+	//! \brief Advance the wheel until a tick, expiring the tasks
+	inline void advance(tick_t tick)
+	{
+		while (_currentTick < tick) {
+			if (_numPending == 0) {
+				_currentTick = tick;
+				return;
+			}
+
+			// Find the next non-empty slot of the current range
+			const tick_t position = _currentTick & (LEVEL_SLOTS - 1);
+			const tick_t rangeStart = _currentTick - position;
+			uint64_t next = 0;
+			if (position < LEVEL_SLOTS - 1) {
+				next = _occupied[0] & (~0ULL << (position + 1));
+			}
+
+			if (next != 0) {
+				const tick_t slot = __builtin_ctzll(next);
+				if (rangeStart + slot > tick) {
+					_currentTick = tick;
+					return;
+				}
+
+				_currentTick = rangeStart + slot;
+				_occupied[0] &= ~(1ULL << slot);
+
+				slot_t &expired = _slots[0][slot];
+				_numPending -= expired.size();
+				_expiredTasks.insert(_expiredTasks.end(), expired.begin(), expired.end());
+				expired.clear();
+			} else {
+				if (rangeStart + LEVEL_SLOTS > tick) {
+					_currentTick = tick;
+					return;
+				}
+
+				_currentTick = rangeStart + LEVEL_SLOTS;
+				cascadeUpperLevels();
+			}
+		}
+	}
 
 public:
 	inline DeadlineQueue(SchedulingPolicy policy) :
 		ReadyQueue(policy),
-		_deadlineTasks(),
-		_now(Chrono::now<Task::deadline_t>())
+		_occupied(),
+		_overflow(),
+		_numPending(0),
+		_currentTick(CoarseClock::now() >> TICK_SHIFT),
+		_expiredTasks()
 	{
 	}
 
 	inline ~DeadlineQueue()
 	{
-		assert(_deadlineTasks.empty());
+		assert(_numPending == 0);
+		assert(_expiredTasks.empty());
 	}
 
 	//! \brief Add ready task with deadline
@@ -62,12 +195,28 @@ public:
 	{
 		assert(task->hasDeadline());
 
-#ifndef NDEBUG
-		auto res = _deadlineTasks.insert(task);
-		assert(res.second);
-#else
-		_deadlineTasks.insert(task);
-#endif
+		// The wheel does not advance while it is empty, so catch up with
+		// the clock instead of walking the idle period on the next advance
+		if (_numPending == 0) {
+			const tick_t tick = CoarseClock::update() >> TICK_SHIFT;
+			if (tick > _currentTick) {
+				_currentTick = tick;
+			}
+		}
+
+		insert(task);
+	}
+
+	//! \brief Move the tasks whose deadline has passed to the expired tasks
+	//!
+	//! The clock is only read when there are deadline tasks pending, and it
+	//! refreshes the time cached in the CoarseClock
+	inline void processDeadlines()
+	{
+		if (_numPending == 0)
+			return;
+
+		advance(CoarseClock::update() >> TICK_SHIFT);
 	}
 
 	//! \brief Get a ready task with the deadline satisfied
@@ -75,46 +224,21 @@ public:
 	//! \param computePlace The current compute place
 	inline Task *getReadyTask(ComputePlace *)
 	{
-		if (_deadlineTasks.empty())
+		if (_expiredTasks.empty())
 			return nullptr;
 
-		auto it = _deadlineTasks.begin();
-		assert(it != _deadlineTasks.end());
-
-		Task *task = *it;
+		Task *task = _expiredTasks.front();
 		assert(task != nullptr);
 
-		// First check using the cached current time
-		// and then using the updated current time
-		if (task->getDeadline() <= _now) {
-			_deadlineTasks.erase(it);
-			return task;
-		} else {
-			_now = Chrono::now<Task::deadline_t>();
-			if (task->getDeadline() < _now) {
-				_deadlineTasks.erase(it);
-				return task;
-			}
-		}
-		return nullptr;
+		_expiredTasks.pop_front();
+		return task;
 	}
 
-	//! \brief Get the number of available deadline tasks
+	//! \brief Get the number of deadline tasks whose deadline has been
+	//! found satisfied
 	inline size_t getNumReadyTasks() const
 	{
-		if (_deadlineTasks.empty())
-			return 0;
-
-		_now = Chrono::now<Task::deadline_t>();
-
-		size_t numReady = 0;
-		for (Task *task : _deadlineTasks) {
-			if (task->getDeadline() > _now)
-				break;
-
-			++numReady;
-		}
-		return numReady;
+		return _expiredTasks.size();
 	}
 
 	inline long getNextTaskPriority()
@@ -24,7 +24,8 @@ Task *HostUnsyncScheduler::getReadyTask(ComputePlace *computePlace)
 	const long groupId = cpu->getGroupId();
 	const long immediateSuccessorGroupId = groupId * 2;
 
-	// 1. Try to get a task with a satisfied deadline
+	// 1. Try to get a task with a satisfied deadline. These tasks have
+	// already been expired when processing the ready tasks
 	result = _deadlineTasks->getReadyTask(computePlace);
 	if (result != nullptr) {
 		return result;
@@ -141,7 +142,7 @@ retry:
 
 	if (result == nullptr
 		|| !result->isTaskforSource()
-		|| (result->isTaskforSource() && result->getWorkflow() == nullptr)) {
+		|| (result->isTaskforSource() && !result->hasWorkflow())) {
 		return result;
 	}
 
@@ -165,8 +165,9 @@ private:
 	//!
 	//! This function moves all ready tasks that have been added to
 	//! the lock-free queues (one per NUMA) to the definitive ready
-	//! task queue. Note this function must be called with the lock
-	//! of the scheduler acquired
+	//! task queue, and expires the deadline tasks whose deadline has
+	//! passed. Note this function must be called with the lock of the
+	//! scheduler acquired
 	inline void processReadyTasks()
 	{
 		for (size_t i = 0; i < _totalAddQueues; i++) {
@@ -183,6 +184,8 @@ private:
 				);
 			}
 		}
+
+		_scheduler->processDeadlineTasks();
 	}
 
 	//! \brief Set serving tasks condition
@@ -82,6 +82,15 @@ public:
 		_readyTasks->addReadyTask(task, hint == UNBLOCKED_TASK_HINT);
 	}
 
+	//! \brief Expire the deadline tasks whose deadline has passed, so that
+	//! they can be obtained as ready tasks
+	inline void processDeadlineTasks()
+	{
+		if (_deadlineTasks != nullptr) {
+			_deadlineTasks->processDeadlines();
+		}
+	}
+
 	//! \brief Get a ready task for execution
 	//!
 	//! \param[in] computePlace the hardware place asking for scheduling orders
@@ -11,6 +11,7 @@
 #include "cluster/hybrid/ClusterHybridMetrics.hpp"
 
 #include <ClusterManager.hpp>
+#include <TaskOffloading.hpp>
 
 ClusterSchedulerInterface::ClusterSchedulerInterface(nanos6_cluster_scheduler_t id)
 	: _thisNode(ClusterManager::getCurrentClusterNode()),
@@ -48,3 +49,19 @@ void ClusterSchedulerInterface::addReadyLocalOrExecuteRemote(
 
 	ExecutionWorkflow::executeTask(task, targetNode, memoryNode);
 }
+
+void ClusterSchedulerInterface::addReadyTasks(
+	__attribute__((unused)) nanos6_device_t taskType,
+	Task *tasks[],
+	const size_t numTasks,
+	ComputePlace *computePlace,
+	ReadyTaskHint hint
+) {
+	// The tasks offloaded to the same node are sent in a single message
+	TaskOffloading::OffloadBatchScope offloadBatch;
+
+	for (size_t i = 0; i < numTasks; ++i) {
+		assert(tasks[i] != nullptr);
+		addReadyTask(tasks[i], computePlace, hint);
+	}
+}
@@ -121,7 +121,7 @@ public:
 			|| (task->isTaskloop() && !task->isTaskloopSource() && !task->isTaskloopOffloader())
 										  // Taskloop executors cannot be offloaded (sources and offloaders can)
 			|| (task->getConstraints()->node == nanos6_cluster_no_offload)
-			|| task->getWorkflow() != nullptr) {
+			|| task->hasWorkflow()) {
 
 			return nanos6_cluster_no_offload;
 		}
@@ -207,6 +207,15 @@ public:
 		}
 	};
 
+	//! Offload together the tasks that are placed on the same node
+	void addReadyTasks(
+		nanos6_device_t taskType,
+		Task *tasks[],
+		const size_t numTasks,
+		ComputePlace *computePlace,
+		ReadyTaskHint hint
+	) override;
+
 	Task *stealTask()
 	{
 		return nullptr;
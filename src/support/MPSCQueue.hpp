@@ -0,0 +1,112 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cassert>
+
+
+//! \brief The link of the elements of an MPSCQueue, which must inherit from it
+class MPSCQueueNode {
+	template <typename T>
+	friend class MPSCQueue;
+
+	std::atomic<MPSCQueueNode *> _mpscNext;
+
+public:
+	MPSCQueueNode() :
+		_mpscNext(nullptr)
+	{
+	}
+};
+
+
+//! \brief An intrusive lock-free FIFO queue with multiple producers and a
+//! single consumer
+//!
+//! Pushing an element is wait-free. Popping may fail while a producer is in
+//! the middle of a push, so the consumer must not rely on pop to decide that
+//! no element will ever arrive. A producer that needs to wake up the consumer
+//! should do it after its push has returned
+template <typename T>
+class MPSCQueue {
+	//! The last pushed node, where producers link new nodes
+	std::atomic<MPSCQueueNode *> _head;
+
+	//! The next node to pop. Only accessed by the consumer
+	MPSCQueueNode *_tail;
+
+	//! A placeholder that keeps the queue non-empty
+	MPSCQueueNode _stub;
+
+	inline void pushNode(MPSCQueueNode *node)
+	{
+		node->_mpscNext.store(nullptr, std::memory_order_relaxed);
+		MPSCQueueNode *previous = _head.exchange(node);
+		previous->_mpscNext.store(node);
+	}
+
+public:
+	MPSCQueue() :
+		_head(&_stub),
+		_tail(&_stub),
+		_stub()
+	{
+	}
+
+	MPSCQueue(const MPSCQueue &) = delete;
+	MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+	//! \brief Push an element. Can be called by any thread
+	inline void push(T *element)
+	{
+		assert(element != nullptr);
+		pushNode(static_cast<MPSCQueueNode *>(element));
+	}
+
+	//! \brief Pop the oldest element. Must only be called by the consumer
+	//!
+	//! \returns the element or nullptr if there was none available
+	inline T *pop()
+	{
+		MPSCQueueNode *tail = _tail;
+		MPSCQueueNode *next = tail->_mpscNext.load();
+
+		// Skip the stub node
+		if (tail == &_stub) {
+			if (next == nullptr)
+				return nullptr;
+
+			_tail = next;
+			tail = next;
+			next = next->_mpscNext.load();
+		}
+
+		if (next != nullptr) {
+			_tail = next;
+			return static_cast<T *>(tail);
+		}
+
+		// The tail is the last node or a producer has not linked its node yet
+		if (tail != _head.load())
+			return nullptr;
+
+		// Push the stub so that the tail can be removed
+		pushNode(&_stub);
+
+		next = tail->_mpscNext.load();
+		if (next != nullptr) {
+			_tail = next;
+			return static_cast<T *>(tail);
+		}
+
+		return nullptr;
+	}
+};
+
+#endif // MPSC_QUEUE_HPP
@@ -0,0 +1,46 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef COARSE_CLOCK_HPP
+#define COARSE_CLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "support/chronometers/std/Chrono.hpp"
+
+
+//! \brief A monotonic clock in microseconds whose value is cached and shared
+//! by all CPUs. Reading it does not access the system clock; the cached value
+//! is only refreshed when some CPU calls update, e.g., the CPU that serves
+//! the scheduler. Thus, the value may be stale
+class CoarseClock {
+private:
+	static inline std::atomic<uint64_t> &getCachedTime()
+	{
+		static std::atomic<uint64_t> cachedTime(0);
+		return cachedTime;
+	}
+
+public:
+	//! \brief Get the cached time in microseconds
+	static inline uint64_t now()
+	{
+		return getCachedTime().load(std::memory_order_relaxed);
+	}
+
+	//! \brief Read the system clock and refresh the cached time
+	//!
+	//! \returns the current time in microseconds
+	static inline uint64_t update()
+	{
+		const uint64_t time = Chrono::now<uint64_t>();
+		getCachedTime().store(time, std::memory_order_relaxed);
+		return time;
+	}
+};
+
+#endif // COARSE_CLOCK_HPP
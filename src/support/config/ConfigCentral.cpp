@@ -33,6 +33,12 @@ void ConfigCentral::initialize()
 	registerOption<bool_t>("cluster.eager_weak_fetch", true);
 	registerOption<bool_t>("cluster.eager_send", false);
 	registerOption<bool_t>("cluster.merge_release_and_finish", true);
+	registerOption<size_t>("cluster.task_new_batch_size", 64);
+	registerOption<size_t>("cluster.fetch_aggregation_window", 20);
+	registerOption<bool_t>("cluster.prefetch", false);
+	registerOption<memory_t>("cluster.prefetch_budget", 64 * 1024 * 1024);
+	registerOption<bool_t>("cluster.shared_fetch", false);
+	registerOption<size_t>("cluster.shared_fetch_threshold", 4);
 
 	// Cluster hybrid
 	registerOption<string_t>("cluster.hybrid.split", "");
@@ -42,15 +48,27 @@ void ConfigCentral::initialize()
 
 	// CPU manager
 	registerOption<string_t>("cpumanager.policy", "default");
+	registerOption<integer_t>("cpumanager.bringup_threads", 0);
 
 	// CUDA devices
 	registerOption<integer_t>("devices.cuda.page_size", 0x8000);
 	registerOption<integer_t>("devices.cuda.streams", 16);
 
+	// Emulated devices
+	registerOption<bool_t>("devices.emulated.enabled", false);
+	registerOption<integer_t>("devices.emulated.count", 1);
+	registerOption<integer_t>("devices.emulated.queues", 4);
+	registerOption<integer_t>("devices.emulated.latency", 0);
+	registerOption<integer_t>("devices.emulated.bandwidth", 0);
+
 	// OpenACC devices
 	registerOption<integer_t>("devices.openacc.default_queues", 64);
 	registerOption<integer_t>("devices.openacc.max_queues", 128);
 
+	// Device task pipeline
+	registerOption<integer_t>("devices.pipeline.depth", 2);
+	registerOption<integer_t>("devices.pipeline.max_inflight_bytes", 0);
+
 	// DLB
 	registerOption<bool_t>("dlb.enabled", false);
 	registerOption<bool_t>("dlb.enable_drom", true);
@@ -72,6 +90,8 @@ void ConfigCentral::initialize()
 	registerOption<string_t>("hardware_counters.pqos.counters", {});
 
 	// CTF instrumentation
+	registerOption<bool_t>("instrument.ctf.async_flush", false);
+	registerOption<string_t>("instrument.ctf.clock", "monotonic");
 	registerOption<bool_t>("instrument.ctf.converter.enabled", true);
 	registerOption<string_t>("instrument.ctf.converter.location", "");
 	registerOption<string_t>("instrument.ctf.events.kernel.exclude", {});
@@ -107,6 +127,7 @@ void ConfigCentral::initialize()
 		"!DependenciesByAccessLinks", "!DependenciesByGroup", "!DependencySystem",
 		"!LeaderThread", "!TaskStatus", "!ThreadManagement"
 	});
+	registerOption<bool_t>("instrument.verbose.binary", false);
 	registerOption<bool_t>("instrument.verbose.dump_only_on_exit", false);
 	registerOption<string_t>("instrument.verbose.output_file", "/dev/stderr");
 	registerOption<bool_t>("instrument.verbose.timestamps", true);
@@ -121,10 +142,16 @@ void ConfigCentral::initialize()
 	registerOption<memory_t>("memory.pool.global_alloc_size", 8 * 1024 * 1024);
 	registerOption<memory_t>("memory.pool.chunk_size", 128 * 1024);
 
+	// Metrics exporter
+	registerOption<bool_t>("metrics.enabled", false);
+	registerOption<string_t>("metrics.socket", "");
+
 	// Miscellaneous
 	registerOption<integer_t>("misc.polling_frequency", 1000);
 	registerOption<bool_t>("misc.polling", true);
 	registerOption<memory_t>("misc.stack_size", 8 * 1024 * 1024);
+	registerOption<bool_t>("misc.startup_report", false);
+	registerOption<string_t>("misc.topology_cache", "");
 
 	// Monitoring
 	registerOption<integer_t>("monitoring.cpuusage_prediction_rate", 100);
@@ -133,6 +160,8 @@ void ConfigCentral::initialize()
 	registerOption<bool_t>("monitoring.verbose", true);
 	registerOption<string_t>("monitoring.verbose_file", "output-monitoring.txt");
 	registerOption<bool_t>("monitoring.wisdom", false);
+	registerOption<string_t>("monitoring.wisdom_file", "./.nanos6-monitoring-wisdom");
+	registerOption<string_t>("monitoring.wisdom_hint", "");
 
 	// Scheduler
 	registerOption<bool_t>("scheduler.immediate_successor", true);
@@ -154,6 +183,7 @@ void ConfigCentral::initialize()
 
 	// Version details
 	registerOption<bool_t>("version.debug", false);
+	registerOption<bool_t>("version.lean", false);
 	registerOption<string_t>("version.instrument", "none");
 
 #ifdef USE_CLUSTER
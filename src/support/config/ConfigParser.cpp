@@ -4,6 +4,8 @@
 	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
@@ -38,6 +40,74 @@ void ConfigParser::checkFileOptions(
 	}
 }
 
+//! \brief Build a toml value from a cached scalar
+//!
+//! \param kind The kind of the value in the cache
+//! \param value The textual representation of the value
+//!
+//! \returns The toml value
+static toml::value getCachedValue(char kind, const char *value)
+{
+	switch (kind) {
+		case 'b':
+			return toml::value(std::strcmp(value, "true") == 0);
+		case 'i':
+			return toml::value((toml::integer) std::strtoll(value, nullptr, 10));
+		case 'f':
+			return toml::value((toml::floating) std::strtod(value, nullptr));
+		default:
+			assert(kind == 's');
+			return toml::value(std::string(value));
+	}
+}
+
+void ConfigParser::loadCachedOptions(const char *entries, size_t numEntries)
+{
+	// The loader has already checked that the entries are well-formed. See
+	// loader/config-cache.h for the format of the entries
+	_data = toml::table();
+
+	const char *current = entries;
+	for (size_t e = 0; e < numEntries; ++e) {
+		const char kind = *current;
+		const std::string name(current + 1);
+		current += name.length() + 2;
+
+		toml::value element;
+		if (kind == 'a') {
+			const size_t numElements = std::strtoul(current, nullptr, 10);
+			current += std::strlen(current) + 1;
+
+			toml::array elements;
+			elements.reserve(numElements);
+			for (size_t i = 0; i < numElements; ++i) {
+				elements.push_back(getCachedValue(*current, current + 1));
+				current += std::strlen(current) + 1;
+			}
+			element = std::move(elements);
+		} else {
+			element = getCachedValue(kind, current);
+			current += std::strlen(current) + 1;
+		}
+
+		// Insert the element in its table, creating the intermediate
+		// tables if needed
+		std::string subkey;
+		std::istringstream ss(name);
+		toml::value *table = &_data;
+		while (std::getline(ss, subkey, '.')) {
+			if (ss.eof()) {
+				table->as_table()[subkey] = std::move(element);
+			} else {
+				toml::value &next = table->as_table()[subkey];
+				if (!next.is_table())
+					next = toml::table();
+				table = &next;
+			}
+		}
+	}
+}
+
 void ConfigParser::checkFileAndOverrideOptions()
 {
 	std::unordered_set<std::string> invalidOptions;
@@ -101,6 +101,17 @@ private:
 	//! is not registered in the config central
 	void checkFileAndOverrideOptions();
 
+	//! \brief Load the config file options from the config cache
+	//!
+	//! The loader maps and validates the config cache, if enabled, and
+	//! exposes its entries to the runtime. The options are inserted in the
+	//! same toml structure that the parser would build, so they are accessed
+	//! and checked as if the file had been parsed
+	//!
+	//! \param entries The entries of the config cache
+	//! \param numEntries The number of entries
+	void loadCachedOptions(const char *entries, size_t numEntries);
+
 	//! \brief Private constructor of config parser
 	//!
 	//! This function parses both the config file and the
@@ -112,14 +123,25 @@ private:
 		const char *_nanos6_config_path = (const char *) dlsym(nullptr, "_nanos6_config_path");
 		assert(_nanos6_config_path != nullptr);
 
-		try {
-			// Parse the config file
-			_data = toml::parse(_nanos6_config_path);
-		} catch (std::runtime_error &error) {
-			FatalErrorHandler::fail("Error while opening the configuration file found in ",
-				std::string(_nanos6_config_path), ". Inner error: ", error.what());
-		} catch (toml::syntax_error &error) {
-			FatalErrorHandler::fail("Configuration syntax error: ", error.what());
+		// Get the config cache validated by the loader, if any
+		const char **_nanos6_config_cache_entries = (const char **) dlsym(nullptr, "_nanos6_config_cache_entries");
+		const size_t *_nanos6_config_cache_num_entries = (const size_t *) dlsym(nullptr, "_nanos6_config_cache_num_entries");
+
+		if (_nanos6_config_cache_entries != nullptr && *_nanos6_config_cache_entries != nullptr) {
+			assert(_nanos6_config_cache_num_entries != nullptr);
+
+			// Skip parsing the config file
+			loadCachedOptions(*_nanos6_config_cache_entries, *_nanos6_config_cache_num_entries);
+		} else {
+			try {
+				// Parse the config file
+				_data = toml::parse(_nanos6_config_path);
+			} catch (std::runtime_error &error) {
+				FatalErrorHandler::fail("Error while opening the configuration file found in ",
+					std::string(_nanos6_config_path), ". Inner error: ", error.what());
+			} catch (toml::syntax_error &error) {
+				FatalErrorHandler::fail("Configuration syntax error: ", error.what());
+			}
 		}
 
 		// Parse the config envar
@@ -112,7 +112,8 @@ extern "C" uint64_t nanos6_wait_for(uint64_t time_us)
 		timeout = 0;
 	}
 
-	// Update the task deadline
+	// Update the task deadline. The coarse clock is not used since its
+	// staleness would make the task wake up early
 	Task::deadline_t start = Chrono::now<Task::deadline_t>();
 	currentTask->setDeadline(start + timeout);
 
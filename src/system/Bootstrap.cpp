@@ -12,6 +12,8 @@
 #include <config.h>
 #include <dlfcn.h>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include <nanos6.h>
 #include <nanos6/bootstrap.h>
@@ -27,9 +29,13 @@
 #include "lowlevel/threads/ExternalThreadGroup.hpp"
 #include "monitoring/Monitoring.hpp"
 #include "scheduling/Scheduler.hpp"
+#include "support/chronometers/std/Chrono.hpp"
 #include "support/config/ConfigCentral.hpp"
 #include "support/config/ConfigChecker.hpp"
+#include "support/config/ConfigVariable.hpp"
 #include "system/APICheck.hpp"
+#include "system/EventCompletionQueue.hpp"
+#include "system/MetricsExporter.hpp"
 #include "system/RuntimeInfoEssentials.hpp"
 #include "system/Throttle.hpp"
 #include "system/ompss/SpawnFunction.hpp"
@@ -46,6 +52,43 @@ bool MemoryAllocator::init = false;
 
 static ExternalThread *mainThread = nullptr;
 
+//! Whether the time spent in each initialization step must be reported
+static bool startupReport = false;
+
+//! The start time of the current initialization step in microseconds
+static uint64_t startupStepStart = 0;
+
+//! The initialization steps and their duration in microseconds
+static std::vector<std::pair<const char *, uint64_t>> startupSteps;
+
+//! \brief Record the time spent since the previous initialization step
+static inline void startupStepFinished(const char *step)
+{
+	if (startupReport) {
+		uint64_t now = Chrono::now<uint64_t>();
+		startupSteps.emplace_back(step, now - startupStepStart);
+		startupStepStart = now;
+	}
+}
+
+//! \brief Print the time spent in each initialization step
+static void printStartupReport()
+{
+	if (!startupReport)
+		return;
+
+	uint64_t total = 0;
+	for (auto const &step : startupSteps) {
+		total += step.second;
+	}
+
+	std::cerr << "Nanos6 startup: " << total << " us" << std::endl;
+	for (auto const &step : startupSteps) {
+		std::cerr << "\t" << step.first << ": " << step.second << " us" << std::endl;
+	}
+	startupSteps.clear();
+}
+
 void nanos6_shutdown(void);
 
 int nanos6_can_run_main(void)
@@ -74,34 +117,53 @@ void nanos6_preinit(int argc, char **argv)
 		);
 	}
 
+	uint64_t preinitStart = Chrono::now<uint64_t>();
+
 	// Initialize all runtime options if needed
 	ConfigCentral::initializeOptionsIfNeeded();
 
+	ConfigVariable<bool> startupReportConfig("misc.startup_report");
+	startupReport = startupReportConfig;
+	startupStepStart = preinitStart;
+	startupStepFinished("ConfigCentral");
+
 	// Enable special flags for turbo mode
 	TurboSettings::initialize();
+	startupStepFinished("TurboSettings");
 
 	RuntimeInfoEssentials::initialize();
+	startupStepFinished("RuntimeInfoEssentials");
 
 	// Pre-initialize Hardware Counters and Monitoring before hardware
 	HardwareCounters::preinitialize();
 	Monitoring::preinitialize();
+	startupStepFinished("HardwareCounters and Monitoring preinitialization");
 	HardwareInfo::initialize();
+	startupStepFinished("HardwareInfo");
 
 	ClusterManager::initialize(argc, argv);
+	startupStepFinished("ClusterManager");
 
 	 // CPUManager::preinitialize() must be after ClusterManager::initialize() for ClusterHybridManager::getInitialCPUMask
 	CPUManager::preinitialize();
+	startupStepFinished("CPUManager preinitialization");
 
 	// Finish Hardware counters and Monitoring initialization after CPUManager
 	HardwareCounters::initialize();
 	Monitoring::initialize();
+	startupStepFinished("HardwareCounters and Monitoring");
 	MemoryAllocator::initialize();
+	startupStepFinished("MemoryAllocator");
 	Throttle::initialize();
+	EventCompletionQueue::initialize();
 	Scheduler::initialize();
+	startupStepFinished("Scheduler");
 	ExternalThreadGroup::initialize();
 
 	Instrument::initialize();
+	startupStepFinished("Instrumentation");
 	ClusterManager::initialize2();  // must be after Instrument::initialize()
+	startupStepFinished("ClusterManager second phase");
 	mainThread = new ExternalThread("main-thread");
 	mainThread->preinitializeExternalThread();
 
@@ -116,6 +178,7 @@ void nanos6_preinit(int argc, char **argv)
 
 	ThreadManager::initialize();
 	DependencySystem::initialize();
+	startupStepFinished("ThreadManager and DependencySystem");
 
 	// Retrieve the virtual CPU for the leader thread
 	CPU *leaderThreadCPU = CPUManager::getLeaderThreadCPU();
@@ -124,20 +187,31 @@ void nanos6_preinit(int argc, char **argv)
 	LeaderThread::initialize(leaderThreadCPU);
 
 	CPUManager::initialize();
+	startupStepFinished("CPUManager and worker threads");
+
+	// Start publishing the runtime metrics once everything is in place
+	MetricsExporter::initialize();
 
 	Instrument::nanos6_preinit_finished();
 
 	// Assert config conditions if any
 	ConfigChecker::assertConditions();
+	startupStepFinished("Remaining preinitialization");
 }
 
 // After main started
 void nanos6_init(void)
 {
+	// Do not account the time between the preinitialization and main
+	startupStepStart = Chrono::now<uint64_t>();
+
 	ClusterManager::postinitialize();
 	Instrument::threadWillSuspend(mainThread->getInstrumentationId());
 	ClusterStats::threadWillSuspend(mainThread);
 	StreamManager::initialize();
+	startupStepFinished("Initialization after main");
+
+	printStartupReport();
 }
 
 
@@ -152,6 +226,7 @@ void nanos6_shutdown(void)
 	}
 
 	StreamManager::shutdown();
+	MetricsExporter::shutdown();
 	LeaderThread::shutdown();
 
 	// Signal the shutdown to all CPUs and finalize threads
@@ -175,6 +250,7 @@ void nanos6_shutdown(void)
 	Monitoring::shutdown();
 	HardwareCounters::shutdown();
 	Throttle::shutdown();
+	EventCompletionQueue::shutdown();
 
 	Scheduler::shutdown();
 
@@ -0,0 +1,35 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef COMPILED_FEATURES_HPP
+#define COMPILED_FEATURES_HPP
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+//! \brief Optional runtime features that can be stripped at compile time
+//!
+//! The checks of these features in the hot paths of the runtime combine the
+//! compile-time value with the runtime configuration. The lean variant
+//! (--enable-lean-variant) sets them to false, so that the compiler removes
+//! the disabled paths entirely instead of branching on the configuration
+namespace CompiledFeatures {
+#ifdef LEAN_VARIANT
+	static constexpr bool cluster = false;
+	static constexpr bool hardwareCounters = false;
+	static constexpr bool monitoring = false;
+	static constexpr bool throttle = false;
+#else
+	static constexpr bool cluster = true;
+	static constexpr bool hardwareCounters = true;
+	static constexpr bool monitoring = true;
+	static constexpr bool throttle = true;
+#endif
+}
+
+#endif // COMPILED_FEATURES_HPP
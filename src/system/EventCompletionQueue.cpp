@@ -0,0 +1,134 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+
+#include <nanos6/polling.h>
+
+#include "CPUDependencyData.hpp"
+#include "DataAccessRegistration.hpp"
+#include "EventCompletionQueue.hpp"
+#include "LeaderThread.hpp"
+#include "executors/threads/TaskFinalization.hpp"
+#include "executors/threads/WorkerThread.hpp"
+#include "support/config/ConfigVariable.hpp"
+#include "tasks/Task.hpp"
+#include "tasks/TaskImplementation.hpp"
+
+
+MPSCQueue<EventCompletionQueue::PendingRelease> EventCompletionQueue::_pendingReleases;
+bool EventCompletionQueue::_enabled(false);
+
+
+//! \brief Get the CPU of the current runtime thread, if any
+static inline CPU *getCurrentCPU()
+{
+	WorkerThread *currentThread = WorkerThread::getCurrentWorkerThread();
+	if (currentThread != nullptr) {
+		CPU *cpu = currentThread->getComputePlace();
+		assert(cpu != nullptr);
+		return cpu;
+	} else if (LeaderThread::isLeaderThread()) {
+		CPU *cpu = LeaderThread::getComputePlace();
+		assert(cpu != nullptr);
+		return cpu;
+	}
+	return nullptr;
+}
+
+void EventCompletionQueue::initialize()
+{
+	// The queue is drained by a polling service
+	ConfigVariable<bool> pollingEnabled("misc.polling");
+	_enabled = pollingEnabled;
+
+	if (_enabled) {
+		nanos6_register_polling_service(
+			"Event completion queue",
+			processPendingReleases,
+			nullptr
+		);
+	}
+}
+
+void EventCompletionQueue::shutdown()
+{
+	if (_enabled) {
+		nanos6_unregister_polling_service(
+			"Event completion queue",
+			processPendingReleases,
+			nullptr
+		);
+	}
+
+	// All tasks have been released at this point
+	assert(_pendingReleases.pop() == nullptr);
+}
+
+void EventCompletionQueue::taskEventsCompleted(Task *task)
+{
+	assert(task != nullptr);
+
+	CPU *cpu = getCurrentCPU();
+	if (cpu != nullptr || !_enabled) {
+		releaseTask(task, cpu);
+	} else {
+		// Defer the release to a runtime thread
+		PendingRelease *pendingRelease = new PendingRelease(task);
+		_pendingReleases.push(pendingRelease);
+	}
+}
+
+int EventCompletionQueue::processPendingReleases(void *)
+{
+	// The polling services are never run concurrently, so this is the only
+	// consumer of the queue
+	PendingRelease *pendingRelease = _pendingReleases.pop();
+	if (pendingRelease == nullptr)
+		return 0;
+
+	CPU *cpu = getCurrentCPU();
+	do {
+		Task *task = pendingRelease->_task;
+		delete pendingRelease;
+
+		releaseTask(task, cpu);
+
+		pendingRelease = _pendingReleases.pop();
+	} while (pendingRelease != nullptr);
+
+	return 0;
+}
+
+void EventCompletionQueue::releaseTask(Task *task, CPU *cpu)
+{
+	assert(task != nullptr);
+
+	// Release the data accesses of the task. Do not merge these
+	// two conditions; the creation of a local CPU dependency data
+	// structure may introduce unnecessary overhead
+	if (cpu != nullptr) {
+		DataAccessRegistration::unregisterTaskDataAccesses(
+			task, cpu, cpu->getDependencyData(),
+			/* memory place */ nullptr,
+			/* from a busy thread */ true
+		);
+	} else {
+		CPUDependencyData localDependencyData;
+		DataAccessRegistration::unregisterTaskDataAccesses(
+			task, nullptr, localDependencyData,
+			/* memory place */ nullptr,
+			/* from a busy thread */ true
+		);
+	}
+
+	TaskFinalization::taskFinished(task, cpu, true);
+
+	// Try to dispose the task
+	if (task->markAsReleased()) {
+		TaskFinalization::disposeTask(task);
+	}
+}
@@ -0,0 +1,67 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef EVENT_COMPLETION_QUEUE_HPP
+#define EVENT_COMPLETION_QUEUE_HPP
+
+#include "support/MPSCQueue.hpp"
+
+class CPU;
+class Task;
+
+
+//! \brief Defers the release of the tasks whose external event counter
+//! reaches zero outside the runtime threads
+//!
+//! External threads, e.g., the progress threads of MPI or the completion
+//! threads of I/O libraries, only push the task into a lock-free queue. A
+//! polling service drains the queue in batches from a runtime thread, so
+//! external threads never execute dependency system code. All the releases
+//! of a batch reuse the dependency data of the CPU that drains the queue
+class EventCompletionQueue {
+	struct PendingRelease : public MPSCQueueNode {
+		Task *_task;
+
+		PendingRelease(Task *task) :
+			MPSCQueueNode(),
+			_task(task)
+		{
+		}
+	};
+
+	//! The tasks pending to be released
+	static MPSCQueue<PendingRelease> _pendingReleases;
+
+	//! Whether the releases from external threads are deferred
+	static bool _enabled;
+
+	//! \brief Polling service that releases the pending tasks
+	static int processPendingReleases(void *);
+
+	//! \brief Release the dependencies of a task and dispose it if possible
+	//!
+	//! \param[in] task The task to release
+	//! \param[in] cpu The CPU of the current runtime thread, if any
+	static void releaseTask(Task *task, CPU *cpu);
+
+public:
+	//! \brief Register the polling service that releases the pending tasks
+	static void initialize();
+
+	//! \brief Unregister the polling service
+	static void shutdown();
+
+	//! \brief Release the dependencies of a task whose event counter has
+	//! reached zero
+	//!
+	//! Runtime threads release the task immediately, whereas external
+	//! threads defer its release
+	//!
+	//! \param[in] task The task whose event counter has reached zero
+	static void taskEventsCompleted(Task *task);
+};
+
+#endif // EVENT_COMPLETION_QUEUE_HPP
@@ -6,15 +6,9 @@
 
 #include <cassert>
 
-#include "CPUDependencyData.hpp"
-#include "DataAccessRegistration.hpp"
-#include "LeaderThread.hpp"
-#include "TrackingPoints.hpp"
-#include "executors/threads/TaskFinalization.hpp"
-#include "executors/threads/ThreadManager.hpp"
+#include "EventCompletionQueue.hpp"
 #include "executors/threads/WorkerThread.hpp"
 #include "tasks/Task.hpp"
-#include "tasks/TaskImplementation.hpp"
 
 
 extern "C" void *nanos6_get_current_event_counter(void)
@@ -51,39 +45,6 @@ extern "C" void nanos6_decrease_task_event_counter(void *event_counter, unsigned
 
 	// Release dependencies if the event counter becomes zero
 	if (task->decreaseReleaseCount(decrement)) {
-		CPU *cpu = nullptr;
-		WorkerThread *currentThread = WorkerThread::getCurrentWorkerThread();
-		if (currentThread != nullptr) {
-			cpu = currentThread->getComputePlace();
-			assert(cpu != nullptr);
-		} else if (LeaderThread::isLeaderThread()) {
-			cpu = LeaderThread::getComputePlace();
-			assert(cpu != nullptr);
-		}
-
-		// Release the data accesses of the task. Do not merge these
-		// two conditions; the creation of a local CPU dependency data
-		// structure may introduce unnecessary overhead
-		if (cpu != nullptr) {
-			DataAccessRegistration::unregisterTaskDataAccesses(
-				task, cpu, cpu->getDependencyData(),
-				/* memory place */ nullptr,
-				/* from a busy thread */ true
-			);
-		} else {
-			CPUDependencyData localDependencyData;
-			DataAccessRegistration::unregisterTaskDataAccesses(
-				task, nullptr, localDependencyData,
-				/* memory place */ nullptr,
-				/* from a busy thread */ true
-			);
-		}
-
-		TaskFinalization::taskFinished(task, cpu, true);
-
-		// Try to dispose the task
-		if (task->markAsReleased()) {
-			TaskFinalization::disposeTask(task);
-		}
+		EventCompletionQueue::taskEventsCompleted(task);
 	}
 }
@@ -0,0 +1,280 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <MemoryAllocator.hpp>
+
+#include "MetricsExporter.hpp"
+#include "executors/threads/CPUManager.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+#include "system/Throttle.hpp"
+#include "tasks/TaskInfo.hpp"
+
+#include <ClusterManager.hpp>
+
+#ifdef USE_CLUSTER
+#include "cluster/polling-services/MessageDelivery.hpp"
+#endif
+
+
+ConfigVariable<bool> MetricsExporter::_enabled("metrics.enabled");
+ConfigVariable<std::string> MetricsExporter::_socketPath("metrics.socket");
+MetricsExporter *MetricsExporter::_singleton = nullptr;
+std::atomic<long> MetricsExporter::_numReadyTasks(0);
+std::atomic<long> MetricsExporter::_numIdleCPUs(0);
+
+
+//! \brief Escape a label value following the Prometheus text format
+static std::string escapeLabel(const std::string &value)
+{
+	std::string escaped;
+	escaped.reserve(value.size());
+
+	for (char c : value) {
+		if (c == '\\' || c == '"') {
+			escaped += '\\';
+			escaped += c;
+		} else if (c == '\n') {
+			escaped += "\\n";
+		} else {
+			escaped += c;
+		}
+	}
+
+	return escaped;
+}
+
+//! \brief Write the header and the value of a metric without labels
+template <typename T>
+static void writeMetric(
+	std::ostringstream &output,
+	const char *name,
+	const char *type,
+	const char *help,
+	T value
+) {
+	output << "# HELP " << name << " " << help << "\n";
+	output << "# TYPE " << name << " " << type << "\n";
+	output << name << " " << value << "\n";
+}
+
+void MetricsExporter::writeMetrics(std::ostringstream &output) const
+{
+	// Scheduler and CPUs
+	writeMetric(output, "nanos6_ready_tasks", "gauge",
+		"Number of ready host tasks in the scheduler, excluding taskfors",
+		std::max(_numReadyTasks.load(std::memory_order_relaxed), 0L));
+	writeMetric(output, "nanos6_cpus", "gauge",
+		"Number of CPUs that the runtime can use",
+		CPUManager::getTotalCPUs());
+	writeMetric(output, "nanos6_idle_cpus", "gauge",
+		"Number of CPUs that are currently idle",
+		std::max(_numIdleCPUs.load(std::memory_order_relaxed), 0L));
+
+	// Tasks per tasktype
+	std::ostringstream created, finished;
+	TaskInfo::processAllTasktypes(
+		[&](const std::string &label, const std::string &source, TasktypeData &tasktypeData) {
+			std::string labels = "{label=\"" + escapeLabel(label) + "\",source=\"" + escapeLabel(source) + "\"}";
+			created << "nanos6_tasks_created_total" << labels << " " << tasktypeData.getNumCreatedTasks() << "\n";
+			finished << "nanos6_tasks_finished_total" << labels << " " << tasktypeData.getNumFinishedTasks() << "\n";
+		}
+	);
+
+	output << "# HELP nanos6_tasks_created_total Number of created tasks per tasktype\n";
+	output << "# TYPE nanos6_tasks_created_total counter\n";
+	output << created.str();
+	output << "# HELP nanos6_tasks_finished_total Number of completely finished tasks per tasktype\n";
+	output << "# TYPE nanos6_tasks_finished_total counter\n";
+	output << finished.str();
+
+	// Memory allocator
+	if (MemoryAllocator::hasUsageStatistics()) {
+		writeMetric(output, "nanos6_memory_usage_bytes", "gauge",
+			"Memory allocated through the runtime allocator",
+			MemoryAllocator::getMemoryUsage());
+	}
+
+	// Throttle
+	writeMetric(output, "nanos6_throttle_enabled", "gauge",
+		"Whether the task creation throttle is enabled",
+		(int) Throttle::isActive());
+	if (Throttle::isActive()) {
+		writeMetric(output, "nanos6_throttle_pressure_percent", "gauge",
+			"Memory pressure seen by the throttle",
+			Throttle::getPressure());
+	}
+
+#ifdef USE_CLUSTER
+	// Cluster messages and data transfers not completed yet
+	if (ClusterManager::inClusterMode()) {
+		writeMetric(output, "nanos6_cluster_pending_messages", "gauge",
+			"Number of cluster messages not completed yet",
+			ClusterPollingServices::PendingQueue<Message>::getNumPendings());
+		writeMetric(output, "nanos6_cluster_pending_transfers", "gauge",
+			"Number of cluster data transfers not completed yet",
+			ClusterPollingServices::PendingQueue<DataTransfer>::getNumPendings());
+	}
+#endif
+}
+
+void MetricsExporter::serveClient(int client) const
+{
+	// Give the client a short time to send a request, so that HTTP clients
+	// can be answered with a proper response. Plain clients that do not send
+	// anything receive the metrics directly
+	char request[512];
+	ssize_t requestSize = 0;
+
+	struct pollfd pollClient = {client, POLLIN, 0};
+	if (poll(&pollClient, 1, 100) > 0 && (pollClient.revents & POLLIN)) {
+		requestSize = recv(client, request, sizeof(request) - 1, MSG_DONTWAIT);
+	}
+
+	const bool isHTTP = (requestSize >= 4 && strncmp(request, "GET ", 4) == 0);
+
+	std::ostringstream body;
+	writeMetrics(body);
+	const std::string content = body.str();
+
+	std::string response;
+	if (isHTTP) {
+		response = "HTTP/1.0 200 OK\r\n"
+			"Content-Type: text/plain; version=0.0.4\r\n"
+			"Content-Length: " + std::to_string(content.size()) + "\r\n"
+			"Connection: close\r\n\r\n";
+	}
+	response += content;
+
+	size_t written = 0;
+	while (written < response.size()) {
+		ssize_t ret = send(client, response.data() + written, response.size() - written, MSG_NOSIGNAL);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+
+			// The client went away; nothing else to do
+			break;
+		}
+		written += ret;
+	}
+}
+
+void MetricsExporter::body()
+{
+	struct pollfd pollSocket = {_socket, POLLIN, 0};
+
+	while (!_mustExit.load(std::memory_order_relaxed)) {
+		// Wake up periodically to check whether we must exit
+		int ret = poll(&pollSocket, 1, 100);
+		if (ret <= 0 || !(pollSocket.revents & POLLIN))
+			continue;
+
+		int client = ::accept(_socket, nullptr, nullptr);
+		if (client < 0)
+			continue;
+
+		serveClient(client);
+		close(client);
+	}
+}
+
+void MetricsExporter::initialize()
+{
+	if (!_enabled)
+		return;
+
+	std::string path = _socketPath.getValue();
+	if (path.empty()) {
+		const char *tmpdir = getenv("TMPDIR");
+		path = std::string((tmpdir != nullptr) ? tmpdir : "/tmp")
+			+ "/nanos6-metrics-" + std::to_string(getpid()) + ".sock";
+	}
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	if (path.size() >= sizeof(address.sun_path)) {
+		FatalErrorHandler::warn("metrics: the socket path is too long, disabling the metrics exporter: ", path);
+		_enabled.setValue(false);
+		return;
+	}
+	strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	FatalErrorHandler::failIf(fd < 0, "metrics: could not create the socket: ", strerror(errno));
+
+	// Remove a stale socket left by a previous execution
+	unlink(path.c_str());
+
+	if (::bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0 || ::listen(fd, 16) != 0) {
+		FatalErrorHandler::warn("metrics: could not listen on ", path, ": ", strerror(errno),
+			". Disabling the metrics exporter");
+		close(fd);
+		_enabled.setValue(false);
+		return;
+	}
+
+	_singleton = new MetricsExporter(fd, path);
+	_singleton->start(nullptr);
+}
+
+void MetricsExporter::shutdown()
+{
+	if (_singleton == nullptr)
+		return;
+
+	_singleton->_mustExit.store(true);
+	_singleton->join();
+
+	close(_singleton->_socket);
+	unlink(_singleton->_path.c_str());
+
+	delete _singleton;
+	_singleton = nullptr;
+}
+
+void MetricsExporter::taskCreated(const Task *task)
+{
+	assert(task != nullptr);
+
+	if (!_enabled)
+		return;
+
+	TasktypeData *tasktypeData = task->getTasktypeData();
+	if (tasktypeData != nullptr) {
+		tasktypeData->increaseCreatedTasks();
+	}
+}
+
+void MetricsExporter::taskFinished(const Task *task)
+{
+	assert(task != nullptr);
+
+	// Taskfor collaborators are not accounted, since they are not created
+	// through the task submission path
+	if (!_enabled || task->isTaskforCollaborator())
+		return;
+
+	TasktypeData *tasktypeData = task->getTasktypeData();
+	if (tasktypeData != nullptr) {
+		tasktypeData->increaseFinishedTasks();
+	}
+}
@@ -0,0 +1,146 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef METRICS_EXPORTER_HPP
+#define METRICS_EXPORTER_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include "lowlevel/threads/KernelLevelThread.hpp"
+#include "support/config/ConfigVariable.hpp"
+#include "tasks/Task.hpp"
+
+
+//! \brief Helper thread that publishes the current value of several runtime
+//! counters through a Unix-domain socket while the program runs. Each client
+//! that connects receives a snapshot in the Prometheus text format. Clients
+//! sending an HTTP request (e.g., curl --unix-socket) get an HTTP response
+class MetricsExporter : public KernelLevelThread {
+private:
+	//! Whether the metrics exporter is enabled
+	static ConfigVariable<bool> _enabled;
+
+	//! The path of the Unix-domain socket
+	static ConfigVariable<std::string> _socketPath;
+
+	//! The singleton instance
+	static MetricsExporter *_singleton;
+
+	//! Number of host tasks inside the scheduler. Taskfors are not accounted
+	//! since they are returned by the scheduler once per collaborator
+	static std::atomic<long> _numReadyTasks;
+
+	//! Number of CPUs that are currently idle
+	static std::atomic<long> _numIdleCPUs;
+
+	//! Whether the exporter thread must stop executing
+	std::atomic<bool> _mustExit;
+
+	//! The listening socket
+	int _socket;
+
+	//! The actual path of the socket
+	std::string _path;
+
+	inline MetricsExporter(int socket, const std::string &path) :
+		KernelLevelThread(),
+		_mustExit(false),
+		_socket(socket),
+		_path(path)
+	{
+	}
+
+	//! \brief Write a snapshot of all metrics in the Prometheus text format
+	void writeMetrics(std::ostringstream &output) const;
+
+	//! \brief Send a snapshot of the metrics to a connected client
+	void serveClient(int client) const;
+
+public:
+	//! \brief A loop that serves the clients connecting to the socket
+	void body() override;
+
+	//! \brief Check whether the metrics exporter is enabled
+	static inline bool isEnabled()
+	{
+		return _enabled;
+	}
+
+	//! \brief Create the socket and start the exporter thread if enabled
+	static void initialize();
+
+	//! \brief Stop the exporter thread and remove the socket
+	static void shutdown();
+
+	//! \brief Notify that a host task has been added to the scheduler
+	//!
+	//! \param[in] task The added task
+	static inline void readyTaskAdded(const Task *task)
+	{
+		assert(task != nullptr);
+
+		if (_enabled && !task->isTaskfor()) {
+			_numReadyTasks.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	//! \brief Notify that several host tasks have been added to the scheduler
+	//!
+	//! \param[in] tasks The added tasks
+	//! \param[in] numTasks The number of tasks in the previous array
+	static inline void readyTasksAdded(Task *tasks[], size_t numTasks)
+	{
+		if (_enabled) {
+			for (size_t i = 0; i < numTasks; ++i) {
+				readyTaskAdded(tasks[i]);
+			}
+		}
+	}
+
+	//! \brief Notify that a host task has been taken from the scheduler
+	//!
+	//! \param[in] task The task returned by the scheduler
+	static inline void readyTaskTaken(const Task *task)
+	{
+		assert(task != nullptr);
+
+		if (_enabled && !task->isTaskfor()) {
+			_numReadyTasks.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	//! \brief Notify that a CPU becomes idle
+	static inline void cpuBecomesIdle()
+	{
+		if (_enabled) {
+			_numIdleCPUs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	//! \brief Notify that a CPU becomes active
+	static inline void cpuBecomesActive()
+	{
+		if (_enabled) {
+			_numIdleCPUs.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	//! \brief Account a newly submitted task in its tasktype
+	//!
+	//! \param[in] task The submitted task
+	static void taskCreated(const Task *task);
+
+	//! \brief Account a completely finished task in its tasktype
+	//!
+	//! \param[in] task The finished task
+	static void taskFinished(const Task *task);
+};
+
+#endif // METRICS_EXPORTER_HPP
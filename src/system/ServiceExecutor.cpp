@@ -0,0 +1,119 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <nanos6.h>
+
+#include "ServiceExecutor.hpp"
+#include "support/Containers.hpp"
+#include "support/chronometers/std/Chrono.hpp"
+#include "system/ompss/SpawnFunction.hpp"
+#include "tasks/Task.hpp"
+
+
+MPSCQueue<ServiceExecutor::Service> ServiceExecutor::_newServices;
+std::atomic<bool> ServiceExecutor::_spawned(false);
+std::atomic<bool> ServiceExecutor::_running(false);
+std::atomic<bool> ServiceExecutor::_mustExit(false);
+
+
+void ServiceExecutor::registerService(service_function_t function, void *data, uint64_t period)
+{
+	assert(function != nullptr);
+	assert(!_mustExit.load());
+
+	Service *service = new Service(function, data, period);
+	assert(service != nullptr);
+
+	_newServices.push(service);
+
+	// Spawn the executor with the first service
+	if (!_spawned.exchange(true)) {
+		_running = true;
+
+		SpawnFunction::spawnFunction(
+			body,
+			nullptr,
+			nullptr,
+			nullptr,
+			"ServiceExecutor",
+			false,
+			(size_t) Task::nanos6_task_runtime_flag_t::nanos6_polling_flag
+		);
+	}
+}
+
+void ServiceExecutor::body(void *)
+{
+	Container::vector<Service *> services;
+
+	while (true) {
+		// Take the newly registered services
+		Service *service;
+		while ((service = _newServices.pop()) != nullptr) {
+			services.push_back(service);
+		}
+
+		if (services.empty() && _mustExit.load()) {
+			// Take the services registered before the exit was requested
+			service = _newServices.pop();
+			if (service == nullptr)
+				break;
+
+			services.push_back(service);
+		}
+
+		// Call the services that are due, and compute when the next one is
+		uint64_t now = Chrono::now<uint64_t>();
+		uint64_t nextCall = now + IDLE_PERIOD;
+
+		size_t i = 0;
+		while (i < services.size()) {
+			service = services[i];
+			assert(service != nullptr);
+
+			if (service->_nextCall <= now) {
+				if (!service->_function(service->_data)) {
+					// The service has stopped
+					services[i] = services.back();
+					services.pop_back();
+					delete service;
+					continue;
+				}
+
+				now = Chrono::now<uint64_t>();
+				service->_nextCall = now + service->_period;
+			}
+
+			if (service->_nextCall < nextCall) {
+				nextCall = service->_nextCall;
+			}
+			++i;
+		}
+
+		// Pause once for all services until the next one is due
+		now = Chrono::now<uint64_t>();
+		if (nextCall > now) {
+			nanos6_wait_for(nextCall - now);
+		}
+	}
+
+	_running = false;
+}
+
+void ServiceExecutor::shutdown()
+{
+	if (!_spawned.load())
+		return;
+
+	_mustExit = true;
+
+	// Wait for the executor task before returning
+	while (_running.load()) {
+	}
+
+	_spawned = false;
+	_mustExit = false;
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef SERVICE_EXECUTOR_HPP
+#define SERVICE_EXECUTOR_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "support/MPSCQueue.hpp"
+
+
+//! \brief Runs many lightweight periodic services inside a single polling
+//! task, which calls them in a cooperative loop
+//!
+//! Each service has its own period. The executor task only pauses when none
+//! of its services is due, so there is a single pause per round instead of
+//! one per service. New services are delivered to the executor through a
+//! lock-free queue. The executor task is spawned with the first service and
+//! runs until shutdown is called
+class ServiceExecutor {
+public:
+	//! Prototype of services. They return false when they must stop
+	typedef bool (*service_function_t)(void *data);
+
+private:
+	struct Service : public MPSCQueueNode {
+		service_function_t _function;
+		void *_data;
+
+		//! The period of the service in microseconds
+		uint64_t _period;
+
+		//! The time of the next call in microseconds
+		uint64_t _nextCall;
+
+		Service(service_function_t function, void *data, uint64_t period) :
+			MPSCQueueNode(),
+			_function(function),
+			_data(data),
+			_period(period),
+			_nextCall(0)
+		{
+		}
+	};
+
+	//! The pause of the executor when it has no services, in microseconds
+	static const uint64_t IDLE_PERIOD = 1000;
+
+	//! The services registered but not taken by the executor yet
+	static MPSCQueue<Service> _newServices;
+
+	//! Whether the executor task has been spawned
+	static std::atomic<bool> _spawned;
+
+	//! Whether the executor task is running
+	static std::atomic<bool> _running;
+
+	//! Whether the executor must finish once it has no services
+	static std::atomic<bool> _mustExit;
+
+	//! \brief The body of the executor task
+	static void body(void *args);
+
+public:
+	//! \brief Register a periodic service
+	//!
+	//! The service is called for the first time as soon as possible, and
+	//! then every period until it returns false. The period is a lower bound,
+	//! since services are called cooperatively
+	//!
+	//! \param[in] function The function of the service
+	//! \param[in] data The parameter that is passed to the function
+	//! \param[in] period The period of the service in microseconds
+	static void registerService(service_function_t function, void *data, uint64_t period);
+
+	//! \brief Wait until all services have stopped and the executor task
+	//! has finished
+	//!
+	//! Services must have been told to stop before calling this function
+	static void shutdown();
+};
+
+#endif // SERVICE_EXECUTOR_HPP
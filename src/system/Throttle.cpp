@@ -27,6 +27,11 @@ void Throttle::initialize()
 	if (!MemoryAllocator::hasUsageStatistics())
 		_enabled.setValue(false);
 
+	if (!CompiledFeatures::throttle && _enabled) {
+		FatalErrorHandler::warn("The throttle is not available in this runtime variant, disabling it");
+		_enabled.setValue(false);
+	}
+
 	if (!_enabled)
 		return;
 
@@ -8,6 +8,7 @@
 #define THROTTLE_HPP
 
 #include "support/config/ConfigVariable.hpp"
+#include "system/CompiledFeatures.hpp"
 
 class Task;
 class WorkerThread;
@@ -28,7 +29,15 @@ public:
 	//! \returns true if the throttle should be engaged, false otherwise
 	static inline bool isActive()
 	{
-		return _enabled;
+		return CompiledFeatures::throttle && _enabled;
+	}
+
+	//! \brief Get the memory pressure computed in the last evaluation
+	//!
+	//! \returns the memory pressure as a percentage of the maximum memory
+	static inline int getPressure()
+	{
+		return _pressure;
 	}
 
 	//! \brief Evaluates current system status and sets throttle activation
@@ -4,6 +4,7 @@
 	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include "MetricsExporter.hpp"
 #include "TrackingPoints.hpp"
 #include "executors/threads/CPU.hpp"
 #include "executors/threads/WorkerThread.hpp"
@@ -106,6 +107,7 @@ void TrackingPoints::taskFinished(Task *task)
 
 	// Propagate monitoring actions for this task since it has finished
 	Monitoring::taskFinished(task);
+	MetricsExporter::taskFinished(task);
 }
 
 void TrackingPoints::threadInitialized(const WorkerThread *thread, const CPU *cpu)
@@ -143,6 +145,7 @@ void TrackingPoints::cpuBecomesActive(const CPU *cpu)
 
 	Instrument::resumedComputePlace(cpu->getInstrumentationId());
 	Monitoring::cpuBecomesActive(cpu->getIndex());
+	MetricsExporter::cpuBecomesActive();
 }
 
 void TrackingPoints::cpuBecomesIdle(const CPU *cpu, const WorkerThread *thread)
@@ -154,6 +157,7 @@ void TrackingPoints::cpuBecomesIdle(const CPU *cpu, const WorkerThread *thread)
 
 	HardwareCounters::updateRuntimeCounters();
 	Monitoring::cpuBecomesIdle(cpu->getIndex());
+	MetricsExporter::cpuBecomesIdle();
 	Instrument::threadWillSuspend(thread->getInstrumentationId(), instrumId);
 	Instrument::suspendingComputePlace(instrumId);
 }
@@ -452,6 +456,7 @@ void TrackingPoints::enterSubmitTask(const Task *creator, Task *task, bool fromU
 
 	HardwareCounters::taskCreated(task);
 	Monitoring::taskCreated(task);
+	MetricsExporter::taskCreated(task);
 	Instrument::createdTask(task, task->getInstrumentationTaskId());
 }
 
@@ -18,8 +18,8 @@ class CPU;
 class Task;
 class WorkerThread;
 
-//! \brief This namespace aggregates common Instrumentation, Monitoring, and
-//! HardwareCounter actions in order to simplify the runtime core
+//! \brief This namespace aggregates common Instrumentation, Monitoring,
+//! HardwareCounter and MetricsExporter actions in order to simplify the runtime core
 namespace TrackingPoints {
 
 	//    COMMON FLOW OF TASKS/THREADS/CPUS    //
@@ -68,6 +68,7 @@ namespace TrackingPoints {
 	//! - HWCounters: If the task is a taskfor collaborator, combine its counters
 	//!   to the taskfor source
 	//! - Monitoring: Notify that the current task has completely finished
+	//! - MetricsExporter: Account the finished task in its tasktype
 	//!
 	//! \param[in] task The finished task
 	void taskFinished(Task *task);
@@ -106,6 +107,7 @@ namespace TrackingPoints {
 	//! Actions:
 	//! - Instrument: Notify that a CPU is gonna resume
 	//! - Monitoring: Notify that a CPU is gonna resume
+	//! - MetricsExporter: Notify that a CPU is no longer idle
 	//!
 	//! \param[in] cpu The CPU that becomes active
 	void cpuBecomesActive(const CPU *cpu);
@@ -116,6 +118,7 @@ namespace TrackingPoints {
 	//! - Instrument: Notify that a CPU is gonna idle
 	//! - HWCounters: Update the runtime counters since the CPU is idling
 	//! - Monitoring: Notify that a CPU is gonna idle
+	//! - MetricsExporter: Notify that a CPU is idle
 	//!
 	//! \param[in] cpu The CPU that becomes idle
 	//! \param[in] thread The thread currently running in the CPU
@@ -408,6 +411,7 @@ namespace TrackingPoints {
 	//! Actions:
 	//! - HWCounters: Initialize hardware counter structures for the task
 	//! - Monitoring: Initialize monitoring structures for the task
+	//! - MetricsExporter: Account the created task in its tasktype
 	//! - Instrument: Initialize instrument structures for the task and notify
 	//!   that the current thread is on the submit phase of the creation of a task
 	//!
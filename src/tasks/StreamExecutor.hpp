@@ -7,19 +7,20 @@
 #ifndef STREAM_EXECUTOR_HPP
 #define STREAM_EXECUTOR_HPP
 
-#include <deque>
+#include <atomic>
 #include <pthread.h>
 
 #include <nanos6.h>
 
 #include "lowlevel/ConditionVariable.hpp"
+#include "support/MPSCQueue.hpp"
 #include "system/BlockingAPI.hpp"
 #include "system/ompss/SpawnFunction.hpp"
 #include "system/ompss/TaskWait.hpp"
 #include "tasks/Task.hpp"
 
 
-struct StreamFunction {
+struct StreamFunction : public MPSCQueueNode {
 	void (*_function)(void *);
 	void *_args;
 	void (*_callback)(void *);
@@ -27,6 +28,7 @@ struct StreamFunction {
 	char const *_label;
 
 	StreamFunction() :
+		MPSCQueueNode(),
 		_function(nullptr),
 		_args(nullptr),
 		_callback(nullptr),
@@ -42,6 +44,7 @@ struct StreamFunction {
 		void *callbackArgs,
 		char const *label
 	) :
+		MPSCQueueNode(),
 		_function(function),
 		_args(args),
 		_callback(callback),
@@ -85,17 +88,16 @@ private:
 	//! The identifier of the stream this executor is in charge of
 	size_t _streamId;
 
-	//! The blocking context of the executor task
-	void *_blockingContext;
+	//! Whether the executor task is blocked or about to block. The thread
+	//! that clears it is in charge of unblocking the executor
+	std::atomic<bool> _blocked;
 
 	//! Whether the runtime is shutting down
 	std::atomic<bool> _mustShutdown;
 
-	//! The executor's function queue
-	std::deque<StreamFunction *> _queue;
-
-	//! A spinlock to access the queue and block/unblock the executor
-	SpinLock _spinlock;
+	//! The executor's function queue, where any thread can add functions
+	//! without locking
+	MPSCQueue<StreamFunction> _queue;
 
 	//! Holds the callback of the function currently being executed
 	StreamFunctionCallback *_currentCallback;
@@ -120,10 +122,9 @@ public:
 			flags, taskAccessInfo,
 			taskCountersAddress,
 			taskStatistics),
-		_blockingContext(nullptr),
+		_blocked(false),
 		_mustShutdown(false),
 		_queue(),
-		_spinlock(),
 		_currentCallback(nullptr)
 	{
 	}
@@ -149,39 +150,27 @@ public:
 		return _streamId;
 	}
 
+	//! \brief Unblock the executor if it is blocked or about to block
+	inline void wakeUp()
+	{
+		if (_blocked.exchange(false)) {
+			BlockingAPI::unblockTask(this);
+		}
+	}
+
 	//! \brief Notify to the executor that it must be shutdown
 	inline void notifyShutdown()
 	{
-		_spinlock.lock();
-
 		_mustShutdown = true;
-		Task *task = static_cast<Task *>(_blockingContext);
-		_blockingContext = nullptr;
-
-		_spinlock.unlock();
-
-		// Unblock the executor if it was blocked
-		if (task != nullptr) {
-			BlockingAPI::unblockTask(task);
-		}
+		wakeUp();
 	}
 
 	//! \brief Add a function to this executor's stream queue
 	//! \param[in] function The kernel to execute
 	inline void addFunction(StreamFunction *function)
 	{
-		_spinlock.lock();
-
-		_queue.push_back(function);
-		Task *task = static_cast<Task *>(_blockingContext);
-		_blockingContext = nullptr;
-
-		_spinlock.unlock();
-
-		// Unblock the executor if it was blocked
-		if (task != nullptr) {
-			BlockingAPI::unblockTask(task);
-		}
+		_queue.push(function);
+		wakeUp();
 	}
 
 	//! \brief Increase the number of participants in a callback. This is so
@@ -218,55 +207,59 @@ public:
 	inline void body(nanos6_address_translation_entry_t * = nullptr) override
 	{
 		while (!_mustShutdown.load()) {
-			_spinlock.lock();
-
-			if (!_queue.empty()) {
-				// Get the first function in the stream's queue
-				StreamFunction *function = _queue.front();
-				assert(function != nullptr);
-				_queue.pop_front();
-
-				_spinlock.unlock();
-
-				// If a callback exists for the function about to be executed,
-				// register it in the map for a future trigger
-				if (function->_callback != nullptr) {
-					// The StreamExecutor in charge of the function participates
-					// in the duty of calling the callback, hence by default
-					// there's always one participant when creating callbacks
-					StreamFunctionCallback *callbackObject = new StreamFunctionCallback(
-						function->_callback,
-						function->_callbackArgs,
-						/* callbackParticipants = */ 1
-					);
-
-					_currentCallback = callbackObject;
+			// Get the first function in the stream's queue
+			StreamFunction *function = _queue.pop();
+			if (function == nullptr) {
+				// Announce that the executor blocks, and check again the
+				// queue in case a function was added before the announcement
+				_blocked = true;
+
+				function = _queue.pop();
+				if (function == nullptr && !_mustShutdown.load()) {
+					BlockingAPI::blockCurrentTask();
+					continue;
 				}
 
-				// Execute the function
-				function->_function(function->_args);
-
-				// Decrease the participants of the callback of the executed
-				// function, as this executor may need to execute the callback
-				// if all child tasks have finished or none were created
-				if (_currentCallback != nullptr) {
-					decreaseCallbackParticipants(_currentCallback);
+				// Withdraw the announcement. If someone else withdrew it,
+				// it is going to unblock this task, so block to consume it
+				if (!_blocked.exchange(false)) {
+					BlockingAPI::blockCurrentTask();
 				}
 
-				// Reset the pointer to the current callback
-				_currentCallback = nullptr;
+				if (function == nullptr)
+					continue;
+			}
 
-				// Delete the executed function
-				delete function;
-			} else {
-				// Release the lock and block the task
-				assert(_blockingContext == nullptr);
-				_blockingContext = nanos6_get_current_blocking_context();
+			// If a callback exists for the function about to be executed,
+			// register it in the map for a future trigger
+			if (function->_callback != nullptr) {
+				// The StreamExecutor in charge of the function participates
+				// in the duty of calling the callback, hence by default
+				// there's always one participant when creating callbacks
+				StreamFunctionCallback *callbackObject = new StreamFunctionCallback(
+					function->_callback,
+					function->_callbackArgs,
+					/* callbackParticipants = */ 1
+				);
+
+				_currentCallback = callbackObject;
+			}
 
-				_spinlock.unlock();
+			// Execute the function
+			function->_function(function->_args);
 
-				BlockingAPI::blockCurrentTask();
+			// Decrease the participants of the callback of the executed
+			// function, as this executor may need to execute the callback
+			// if all child tasks have finished or none were created
+			if (_currentCallback != nullptr) {
+				decreaseCallbackParticipants(_currentCallback);
 			}
+
+			// Reset the pointer to the current callback
+			_currentCallback = nullptr;
+
+			// Delete the executed function
+			delete function;
 		}
 	}
 
@@ -44,7 +44,6 @@ class TasktypeData;
 
 namespace ExecutionWorkflow {
 	class Step;
-	class Workflow;
 	class DataReleaseStep;
 	class DataLinkStep;
 };
@@ -170,8 +169,8 @@ private:
 	//! Number of internal and external events that prevent the release of dependencies
 	std::atomic<int> _countdownToRelease;
 
-	//! Execution workflow to execute this Task
-	ExecutionWorkflow::Workflow *_workflow;
+	//! Whether the execution workflow of this Task has been created
+	bool _workflowCreated;
 
 	//! At the moment we will store the Execution step of the task
 	//! here in order to invoke it after previous asynchronous
@@ -823,24 +822,18 @@ public:
 		return _deviceEnvironment;
 	}
 
-	//! \brief Set the Execution Workflow for this Task
-	inline void setWorkflow(ExecutionWorkflow::Workflow *workflow)
+	//! \brief Set whether the Execution Workflow of this Task has been created
+	inline void setWorkflowCreated(bool created)
 	{
-#ifndef NDEBUG
 		// This is not enforced, but usefull when we try to execute the notification step more than
 		// once.
-		if (_workflow == nullptr) {
-			assert(workflow != nullptr);
-		} else {
-			assert(workflow == nullptr);
-		}
-#endif // NDEBUG
-		_workflow = workflow;
+		assert(_workflowCreated != created);
+		_workflowCreated = created;
 	}
-	//! \brief Get the Execution Workflow of the Task
-	inline ExecutionWorkflow::Workflow *getWorkflow() const
+	//! \brief Check whether the Execution Workflow of the Task has been created
+	inline bool hasWorkflow() const
 	{
-		return _workflow;
+		return _workflowCreated;
 	}
 
 	inline void setExecutionStep(ExecutionWorkflow::Step *step)
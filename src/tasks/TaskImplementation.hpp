@@ -56,7 +56,7 @@ inline Task::Task(
 	_computePlace(nullptr),
 	_memoryPlace(nullptr),
 	_countdownToRelease(1),
-	_workflow(nullptr),
+	_workflowCreated(false),
 	_executionStep(nullptr),
 	_taskStatistics((TaskStatistics *) taskStatistics),
 	_hwCounters(taskCountersAddress),
@@ -82,11 +82,6 @@ inline Task::~Task()
 		delete _clusterContext;
 	}
 
-	if (_workflow != nullptr) {
-		assert(_executionStep == nullptr);
-		delete _workflow;
-	}
-
 	// Destroy hardware counters
 	_hwCounters.shutdown();
 }
@@ -119,7 +114,7 @@ inline void Task::reinitialize(
 	_computePlace = nullptr;
 	_memoryPlace = nullptr;
 	_countdownToRelease = 1;
-	_workflow = nullptr;
+	_workflowCreated = false;
 	_executionStep = nullptr;
 	_clusterContext = nullptr;
 	_parentSpawnCallback = nullptr;
@@ -7,6 +7,9 @@
 #include <string>
 
 #include "TaskInfo.hpp"
+#include "monitoring/Monitoring.hpp"
+
+#include <InstrumentAddTask.hpp>
 
 
 TaskInfo::task_type_map_t TaskInfo::_tasktypes;
@@ -52,6 +55,13 @@ bool TaskInfo::registerTaskInfo(nanos6_task_info_t *taskInfo)
 	task_type_map_t::iterator it = emplacedElement.first;
 	taskInfo->task_type_data = &(it->second);
 
+	Instrument::registeredTaskInfo(taskInfo);
+
+	// New task types may use the monitoring data of previous executions
+	if (emplacedElement.second) {
+		Monitoring::tasktypeRegistered(label, it->second);
+	}
+
 	// true if new element, false if already existed
 	return emplacedElement.second;
 }
@@ -7,6 +7,8 @@
 #ifndef TASKTYPE_DATA_HPP
 #define TASKTYPE_DATA_HPP
 
+#include <atomic>
+
 #include "InstrumentTasktypeData.hpp"
 #include "monitoring/TasktypeStatistics.hpp"
 
@@ -23,11 +25,18 @@ private:
 	//! Monitoring-related statistics per tasktype
 	TasktypeStatistics _tasktypeStatistics;
 
+	//! Number of created and finished tasks of this type, only accounted
+	//! when the metrics exporter is enabled
+	std::atomic<size_t> _numCreatedTasks;
+	std::atomic<size_t> _numFinishedTasks;
+
 public:
 
 	inline TasktypeData() :
 		_instrumentId(),
-		_tasktypeStatistics()
+		_tasktypeStatistics(),
+		_numCreatedTasks(0),
+		_numFinishedTasks(0)
 	{
 	}
 
@@ -41,6 +50,26 @@ public:
 		return _tasktypeStatistics;
 	}
 
+	inline void increaseCreatedTasks()
+	{
+		_numCreatedTasks.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	inline void increaseFinishedTasks()
+	{
+		_numFinishedTasks.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	inline size_t getNumCreatedTasks() const
+	{
+		return _numCreatedTasks.load(std::memory_order_relaxed);
+	}
+
+	inline size_t getNumFinishedTasks() const
+	{
+		return _numFinishedTasks.load(std::memory_order_relaxed);
+	}
+
 };
 
 #endif // TASKTYPE_DATA_HPP
@@ -0,0 +1,96 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2021 Barcelona Supercomputing Center (BSC)
+*/
+
+/*
+ * Test that runs chains of dependent device tasks and device reductions on the
+ * emulated devices. The emulated devices take the slot of the OpenACC devices,
+ * so the tasks are annotated with device(openacc) but must not be compiled with
+ * OpenACC support. The test enables the emulated devices through the config
+ * override set by select-version.sh
+ *
+ */
+
+#include "TestAnyProtocolProducer.hpp"
+
+
+#define NUM_BLOCKS 32
+#define BLOCK_SIZE 64
+#define NUM_ITERATIONS 20
+#define NUM_REDUCTIONS 10
+
+
+TestAnyProtocolProducer tap;
+
+int main() {
+	static long array[NUM_BLOCKS * BLOCK_SIZE];
+	long sums[NUM_REDUCTIONS] = { 0 };
+
+	tap.registerNewTests(2);
+	tap.begin();
+
+	for (size_t i = 0; i < NUM_BLOCKS * BLOCK_SIZE; ++i) {
+		array[i] = i;
+	}
+
+	// Each iteration depends on the previous one through the block accesses
+	for (int it = 0; it < NUM_ITERATIONS; ++it) {
+		for (int block = 0; block < NUM_BLOCKS; ++block) {
+			long *data = &array[block * BLOCK_SIZE];
+
+			#pragma oss task device(openacc) inout(data[0;BLOCK_SIZE])
+			{
+				for (int i = 0; i < BLOCK_SIZE; ++i) {
+					data[i] += 1;
+				}
+			}
+		}
+	}
+
+	// Reduce the final values of each block on the emulated devices
+	for (int r = 0; r < NUM_REDUCTIONS; ++r) {
+		long &sum = sums[r];
+
+		for (int block = 0; block < NUM_BLOCKS; ++block) {
+			long *data = &array[block * BLOCK_SIZE];
+
+			#pragma oss task device(openacc) in(data[0;BLOCK_SIZE]) reduction(+: sum)
+			{
+				for (int i = 0; i < BLOCK_SIZE; ++i) {
+					sum += data[i];
+				}
+			}
+		}
+	}
+
+	#pragma oss taskwait
+
+	bool correct = true;
+	for (size_t i = 0; i < NUM_BLOCKS * BLOCK_SIZE; ++i) {
+		if (array[i] != (long) (i + NUM_ITERATIONS)) {
+			correct = false;
+			tap.emitDiagnostic("Incorrect value at position ", i, ": ", array[i]);
+			break;
+		}
+	}
+
+	tap.evaluate(correct, "All dependent device tasks were executed in order");
+
+	const long numElements = NUM_BLOCKS * BLOCK_SIZE;
+	const long expected = (numElements * (numElements - 1)) / 2 + numElements * NUM_ITERATIONS;
+
+	correct = true;
+	for (int r = 0; r < NUM_REDUCTIONS; ++r) {
+		if (sums[r] != expected) {
+			correct = false;
+			tap.emitDiagnostic("Incorrect reduction result: ", sums[r], " expected ", expected);
+			break;
+		}
+	}
+
+	tap.evaluate(correct, "All device reductions have the expected result");
+
+	tap.end();
+}
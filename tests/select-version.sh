@@ -21,6 +21,11 @@ if [[ "${*}" == *"fibonacci"* ]] || [[ "${*}" == *"task-for-nqueens"* ]] || [[ "
 	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},scheduler.policy=lifo"
 fi
 
+# Enable the emulated devices for emulated-specific tests
+if [[ "${*}" == *"emulated"* ]]; then
+	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},devices.emulated.enabled=true"
+fi
+
 # Enable DLB for dlb-specific tests
 if [[ "${*}" == *"dlb-"* ]]; then
 	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},dlb.enabled=true"